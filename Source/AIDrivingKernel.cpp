@@ -0,0 +1,97 @@
+// AIDrivingKernel.cpp
+// AI driver decisions over the shared racing line
+// Copyright 2025. All Rights Reserved.
+
+#include "AIDrivingKernel.h"
+#include "AIRacingController.h"
+#include "RacingLine.h"
+
+namespace AIDriving
+{
+    float ComputeSteering(const FRacingLine& Line, int32 WaypointIndex, const FVector& Location, const FVector& Forward,
+        float ForwardSpeed, const FVector& TargetOffset, float Sharpness)
+    {
+        const int32 NumWaypoints = Line.Num();
+        if (NumWaypoints == 0)
+        {
+            return 0.0f;
+        }
+
+        // Look further ahead the faster the car goes
+        const int32 LookAheadWaypoints = FMath::Clamp(FMath::CeilToInt(ForwardSpeed / 100.0f), 1, 10);
+        const FVector Target = Line.GetPositions()[(WaypointIndex + LookAheadWaypoints) % NumWaypoints] + TargetOffset;
+
+        FVector ToTarget = Target - Location;
+        ToTarget.Z = 0.0f;
+        ToTarget.Normalize();
+
+        // Signed angle to the target, normalized to -1..1
+        const float CrossProduct = FVector::CrossProduct(Forward, ToTarget).Z;
+        const float SteeringAngle = FMath::Asin(FMath::Clamp(CrossProduct, -1.0f, 1.0f));
+        const float Steering = SteeringAngle / (PI * 0.5f) * Sharpness;
+
+        return FMath::Clamp(Steering, -1.0f, 1.0f);
+    }
+
+    bool ComputeThrottleBrake(const FRacingLine& Line, EAIDifficulty Difficulty, float RacelineDistance, float ForwardSpeed,
+        float SpeedScale, float ResponseTime, float ObstacleDistance, float& OutThrottle, float& OutBrake, float& OutTargetSpeed)
+    {
+        // The profile already carries every braking ramp, so look up the target where the car
+        // will be once it has reacted; cautious drivers react earlier
+        const FRacingSpeedProfile& Profile = Line.GetSpeedProfile(Difficulty);
+        const float LookupDistance = Line.WrapDistance(RacelineDistance + FMath::Max(ForwardSpeed, 0.0f) * ResponseTime);
+        const int32 Segment = Line.FindSegment(LookupDistance);
+
+        const float TargetSpeed = FMath::Max(Profile.SampleSpeed(Line.GetArcLengths(), Segment, LookupDistance) * SpeedScale, 1.0f);
+        OutTargetSpeed = TargetSpeed;
+
+        const float SpeedError = (TargetSpeed - ForwardSpeed) / TargetSpeed;
+        constexpr float SpeedTolerance = 0.02f;
+
+        bool bBraking;
+        if (SpeedError < -SpeedTolerance)
+        {
+            // Over the profile: brake in proportion
+            OutThrottle = 0.0f;
+            OutBrake = FMath::Clamp(-SpeedError * 4.0f, 0.1f, 1.0f);
+            bBraking = true;
+        }
+        else if (SpeedError > SpeedTolerance)
+        {
+            // Under the profile: accelerate
+            OutThrottle = FMath::Clamp(SpeedError * 4.0f, 0.3f, 1.0f);
+            OutBrake = 0.0f;
+            bBraking = false;
+        }
+        else
+        {
+            // On the profile: hold speed, lifting through braking zones
+            bBraking = Profile.Braking[Segment] != 0;
+            OutThrottle = bBraking ? 0.0f : 0.5f;
+            OutBrake = 0.0f;
+        }
+
+        // Check for obstacles
+        if (ObstacleDistance < ObstacleBrakeDistance)
+        {
+            OutBrake = 1.0f;
+            OutThrottle = 0.0f;
+        }
+        else if (ObstacleDistance < ObstacleLiftDistance)
+        {
+            OutThrottle *= 0.5f;
+        }
+
+        return bBraking;
+    }
+
+    float ComputeRubberBanding(float MaxSpeedMultiplier, float GapToPlayer, float Strength, float DeltaTime)
+    {
+        // If AI is ahead, slow down
+        // If AI is behind, speed up
+        const float TargetMultiplier = 1.0f - FMath::Clamp(GapToPlayer / RubberBandingFullGap, -1.0f, 1.0f) * Strength;
+
+        // Settles in about a second, however often the driver decides
+        return FMath::Clamp(FMath::FInterpTo(MaxSpeedMultiplier, TargetMultiplier, DeltaTime, 1.0f), 0.5f, 1.2f);
+    }
+}
@@ -0,0 +1,60 @@
+// AIDrivingKernel.h
+// Steering, throttle/brake and rubber-banding decisions for AI drivers
+// Copyright 2025. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FRacingLine;
+enum class EAIDifficulty : uint8;
+
+/**
+ * Stateless driver decisions shared by AAIRacingController (one car, game thread)
+ * and UAIRacingSubsystem (every car, ParallelFor). Reads only the immutable racing line
+ * and its arguments, so any number of cars can be evaluated concurrently.
+ */
+namespace AIDriving
+{
+    /** Obstacle closer than this ahead (m): full brake */
+    constexpr float ObstacleBrakeDistance = 10.0f;
+
+    /** Obstacle closer than this ahead (m): half throttle */
+    constexpr float ObstacleLiftDistance = 30.0f;
+
+    /** Length of the obstacle probe in front of the car (cm) */
+    constexpr float ObstacleProbeLength = 3000.0f;
+
+    /** A car within this lateral distance of the driver's line is in its way (cm) */
+    constexpr float ObstacleLateralHalfWidth = 200.0f;
+
+    /** Subtracted from centre-to-centre gaps so they read like a bumper probe (cm) */
+    constexpr float VehicleLength = 450.0f;
+
+    /** How long an overtake attempt lasts (s) */
+    constexpr float OvertakeDuration = 3.0f;
+
+    /** Lateral offset of an overtake at aggression 1 (cm) */
+    constexpr float OvertakeOffset = 400.0f;
+
+    /** Gap to the player (s) at which rubber-banding applies its full strength */
+    constexpr float RubberBandingFullGap = 3.0f;
+
+    /** Steering in [-1, 1] towards the line a speed-dependent number of waypoints past WaypointIndex, shifted by TargetOffset */
+    CARGAME_API float ComputeSteering(const FRacingLine& Line, int32 WaypointIndex, const FVector& Location, const FVector& Forward,
+        float ForwardSpeed, const FVector& TargetOffset, float Sharpness);
+
+    /**
+     * Throttle and brake that hold the car on the difficulty's speed profile.
+     * SpeedScale multiplies the profile, ResponseTime (s) sets how far ahead it is read.
+     * ObstacleDistance (m) is MAX_FLT when nothing is ahead. Returns true when the driver is braking.
+     */
+    CARGAME_API bool ComputeThrottleBrake(const FRacingLine& Line, EAIDifficulty Difficulty, float RacelineDistance, float ForwardSpeed,
+        float SpeedScale, float ResponseTime, float ObstacleDistance, float& OutThrottle, float& OutBrake, float& OutTargetSpeed);
+
+    /**
+     * MaxSpeedMultiplier eased over DeltaTime seconds towards the pace that closes GapToPlayer
+     * (s along the track, positive when the driver is ahead of the player)
+     */
+    CARGAME_API float ComputeRubberBanding(float MaxSpeedMultiplier, float GapToPlayer, float Strength, float DeltaTime);
+}
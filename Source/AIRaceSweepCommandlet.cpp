@@ -0,0 +1,512 @@
+// AIRaceSweepCommandlet.cpp
+// Headless AI-only races over a grid of driver settings, for difficulty calibration
+// Copyright 2025. All Rights Reserved.
+
+#include "AIRaceSweepCommandlet.h"
+#include "AIRacingController.h"
+#include "AIRacingSubsystem.h"
+#include "RacingVehicle.h"
+#include "RacingLineOptimizer.h"
+#include "ProceduralTrackGenerator.h"
+#include "HeadlessCircuit.h"
+#include "VehicleSimulationSubsystem.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Components/StaticMeshComponent.h"
+#include "GameFramework/WorldSettings.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+    struct FSweepParameters
+    {
+        float BrakingAggressiveness = 1.0f;
+        float SteeringSharpness = 1.0f;
+        float MistakeChance = 0.0f;
+    };
+
+    struct FSweepSettings
+    {
+        TArray<FSweepParameters> Sets;
+        EAIDifficulty Difficulty = EAIDifficulty::Medium;
+        int32 NumCars = 8;
+        int32 NumLaps = 3;
+        int32 NumRaces = 4;
+        int32 Seed = 1;
+        float StepSeconds = 1.0f / 60.0f;
+        float MaxSeconds = 900.0f;
+        UClass* VehicleClass = nullptr;
+    };
+
+    /** One completed lap, or a car that did not finish (LapTime < 0) */
+    struct FLapSample
+    {
+        int32 Set = 0;
+        int32 Race = 0;
+        int32 Car = 0;
+        float LapTime = 0.0f;
+    };
+
+    TArray<float> ParseList(const FString& Params, const TCHAR* Name, float Default)
+    {
+        TArray<float> Values;
+        FString Text;
+        if (FParse::Value(*Params, Name, Text, false))
+        {
+            TArray<FString> Items;
+            Text.ParseIntoArray(Items, TEXT(","));
+            for (const FString& Item : Items)
+            {
+                Values.Add(FCString::Atof(*Item));
+            }
+        }
+        if (Values.Num() == 0)
+        {
+            Values.Add(Default);
+        }
+        return Values;
+    }
+
+    void SpawnGround(UWorld* World, float Z)
+    {
+        UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+        AStaticMeshActor* Ground = World->SpawnActor<AStaticMeshActor>(FVector(0.0f, 0.0f, Z), FRotator::ZeroRotator);
+        if (!Ground || !Cube)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("AIRaceSweep: could not create the ground plane"));
+            return;
+        }
+
+        // 2 km square, 1 m thick
+        UStaticMeshComponent* Mesh = Ground->GetStaticMeshComponent();
+        Mesh->SetMobility(EComponentMobility::Movable);
+        Mesh->SetStaticMesh(Cube);
+        Mesh->SetWorldScale3D(FVector(2000.0f, 2000.0f, 1.0f));
+        Mesh->SetCollisionProfileName(TEXT("BlockAll"));
+    }
+
+    /** Two cars per row, rows stacked behind the origin */
+    FTransform GetGridTransform(int32 Index, const FVector& Origin, const FRotator& Rotation)
+    {
+        const int32 Row = Index / 2;
+        const int32 Column = Index % 2;
+        const FVector Offset(-Row * 800.0f - 500.0f, (Column - 0.5f) * 400.0f, 100.0f);
+        return FTransform(Rotation, Origin + Rotation.RotateVector(Offset));
+    }
+
+    /** Race one parameter set in a fresh world; appends one sample per lap and per car that did not finish */
+    bool RunRace(const FSweepSettings& Settings, int32 SetIndex, int32 Race, TArray<FLapSample>& OutSamples)
+    {
+        const FSweepParameters& Parameters = Settings.Sets[SetIndex];
+
+        UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("AIRaceSweep"));
+        FWorldContext& Context = GEngine->CreateNewWorldContext(EWorldType::Game);
+        Context.SetCurrentWorld(World);
+
+        World->InitializeActorsForPlay(FURL());
+        World->BeginPlay();
+        if (!World->HasBegunPlay())
+        {
+            // No game mode in this world; start actors directly
+            World->GetWorldSettings()->NotifyBeginPlay();
+        }
+
+        auto DestroyWorld = [World]()
+        {
+            GEngine->DestroyWorldContext(World);
+            World->DestroyWorld(false);
+        };
+
+        // Same circuit for every race so lap times are comparable
+        FTrackLayout Layout = FHeadlessCircuit::MakeLayout(Settings.Seed);
+        FHeadlessCircuit::SpawnSurface(World, Layout);
+
+        if (!FRacingLineOptimizer::HasCachedRacingLine(Layout))
+        {
+            FRacingLineOptimizer::StoreInLayout(Layout, FRacingLineOptimizer::Optimize(Layout));
+        }
+        if (Layout.OptimizedRacingLine.Num() < 3)
+        {
+            UE_LOG(LogTemp, Error, TEXT("AIRaceSweep: the circuit has no racing line"));
+            DestroyWorld();
+            return false;
+        }
+
+        // Catch cars that leave the circuit
+        SpawnGround(World, Layout.StartLineLocation.Z - 60.0f);
+
+        TArray<AAIRacingController*> Drivers;
+        for (int32 Car = 0; Car < Settings.NumCars; Car++)
+        {
+            FActorSpawnParameters SpawnParams;
+            SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+            const FTransform Transform = GetGridTransform(Car, Layout.StartLineLocation, Layout.StartLineRotation);
+            ARacingVehicle* Vehicle = World->SpawnActor<ARacingVehicle>(Settings.VehicleClass, Transform, SpawnParams);
+            AAIRacingController* Driver = Vehicle ? World->SpawnActor<AAIRacingController>(SpawnParams) : nullptr;
+            if (!Driver)
+            {
+                continue;
+            }
+
+            // Nobody is watching, so the physics LOD would move every car kinematically and ignore the swept settings
+            Vehicle->bAllowPhysicsLOD = false;
+
+            // After BeginPlay, which applies the difficulty's own mistake chance
+            Driver->Difficulty = Settings.Difficulty;
+            Driver->BrakingAggressiveness = Parameters.BrakingAggressiveness;
+            Driver->SteeringSharpness = Parameters.SteeringSharpness;
+            Driver->MistakeChance = Parameters.MistakeChance;
+            Driver->bEnableRubberBanding = false;
+            Driver->InitializeRacingAI(Layout.OptimizedRacingLine);
+            Driver->Possess(Vehicle);
+            Drivers.Add(Driver);
+        }
+
+        if (Drivers.Num() == 0)
+        {
+            UE_LOG(LogTemp, Error, TEXT("AIRaceSweep: no AI cars could be spawned"));
+            DestroyWorld();
+            return false;
+        }
+
+        // Race N uses the same seed for every set, so sets are compared on the same random draws
+        if (UAIRacingSubsystem* AIRacing = World->GetSubsystem<UAIRacingSubsystem>())
+        {
+            AIRacing->SetRaceSeed(static_cast<int32>(HashCombine(GetTypeHash(Settings.Seed), GetTypeHash(Race)) | 1));
+        }
+
+        // Laps from racing-line progress: the first pass over the line starts the clock
+        TArray<float> LastDistance;
+        TArray<float> LapStart;
+        TArray<int32> LapsDone;
+        LastDistance.Init(-1.0f, Drivers.Num());
+        LapStart.Init(-1.0f, Drivers.Num());
+        LapsDone.Init(0, Drivers.Num());
+
+        const float LapLength = Drivers[0]->GetRacelineLength();
+        const int32 MaxSteps = FMath::Max(1, FMath::RoundToInt(Settings.MaxSeconds / Settings.StepSeconds));
+
+        VehicleSim::FScopedFixedStep FixedStep(Settings.StepSeconds);
+
+        int32 NumFinished = 0;
+        for (int32 Step = 0; Step < MaxSteps && NumFinished < Drivers.Num(); Step++)
+        {
+            FixedStep.Advance();
+            World->Tick(LEVELTICK_All, Settings.StepSeconds);
+            GFrameCounter++;
+
+            const float Time = (Step + 1) * Settings.StepSeconds;
+            for (int32 Car = 0; Car < Drivers.Num(); Car++)
+            {
+                const ARacingVehicle* Vehicle = Drivers[Car]->ControlledVehicle;
+                if (!Vehicle || LapsDone[Car] >= Settings.NumLaps)
+                {
+                    continue;
+                }
+
+                const float Distance = Drivers[Car]->GetRacelineDistance(Vehicle->GetFrameState().Transform.GetLocation());
+                const bool bCrossedLine = LastDistance[Car] > 0.75f * LapLength && Distance < 0.25f * LapLength;
+                LastDistance[Car] = Distance;
+
+                if (!bCrossedLine)
+                {
+                    continue;
+                }
+                if (LapStart[Car] >= 0.0f)
+                {
+                    OutSamples.Add({ SetIndex, Race, Car, Time - LapStart[Car] });
+                    if (++LapsDone[Car] == Settings.NumLaps)
+                    {
+                        NumFinished++;
+                    }
+                }
+                LapStart[Car] = Time;
+            }
+        }
+
+        for (int32 Car = 0; Car < Drivers.Num(); Car++)
+        {
+            if (LapsDone[Car] < Settings.NumLaps)
+            {
+                OutSamples.Add({ SetIndex, Race, Car, -1.0f });
+            }
+        }
+
+        DestroyWorld();
+        return true;
+    }
+
+    FString FormatSample(const FLapSample& Sample)
+    {
+        return FString::Printf(TEXT("%d,%d,%d,%.4f"), Sample.Set, Sample.Race, Sample.Car, Sample.LapTime);
+    }
+
+    bool LoadSamples(const FString& Path, TArray<FLapSample>& OutSamples)
+    {
+        TArray<FString> Lines;
+        if (!FFileHelper::LoadFileToStringArray(Lines, *Path))
+        {
+            return false;
+        }
+
+        for (const FString& Line : Lines)
+        {
+            TArray<FString> Fields;
+            if (Line.ParseIntoArray(Fields, TEXT(",")) == 4)
+            {
+                OutSamples.Add({ FCString::Atoi(*Fields[0]), FCString::Atoi(*Fields[1]), FCString::Atoi(*Fields[2]), FCString::Atof(*Fields[3]) });
+            }
+        }
+        return true;
+    }
+
+    /** Run the given worker share in this process */
+    bool RunShard(const FSweepSettings& Settings, int32 Shard, int32 NumShards, TArray<FLapSample>& OutSamples)
+    {
+        for (int32 Set = Shard; Set < Settings.Sets.Num(); Set += NumShards)
+        {
+            for (int32 Race = 0; Race < Settings.NumRaces; Race++)
+            {
+                const double StartSeconds = FPlatformTime::Seconds();
+                if (!RunRace(Settings, Set, Race, OutSamples))
+                {
+                    return false;
+                }
+                UE_LOG(LogTemp, Display, TEXT("AIRaceSweep: set %d race %d done in %.1f s"), Set, Race, FPlatformTime::Seconds() - StartSeconds);
+            }
+        }
+        return true;
+    }
+
+    /** Run each share in a child process of this commandlet and merge their samples */
+    bool RunWorkers(const FSweepSettings& Settings, int32 NumWorkers, TArray<FLapSample>& OutSamples)
+    {
+        const FString Executable = FPlatformProcess::ExecutablePath();
+        const FString BaseArguments = FCommandLine::Get();
+
+        TArray<FProcHandle> Processes;
+        TArray<FString> SamplePaths;
+        for (int32 Worker = 0; Worker < NumWorkers; Worker++)
+        {
+            const FString SamplePath = FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / FString::Printf(TEXT("AIRaceSweep_%d.csv"), Worker));
+            IFileManager::Get().Delete(*SamplePath, false, true, true);
+
+            const FString Arguments = FString::Printf(TEXT("%s -Shard=%d -Shards=%d -Samples=\"%s\""), *BaseArguments, Worker, NumWorkers, *SamplePath);
+            FProcHandle Process = FPlatformProcess::CreateProc(*Executable, *Arguments, false, true, true, nullptr, 0, nullptr, nullptr);
+            if (!Process.IsValid())
+            {
+                UE_LOG(LogTemp, Error, TEXT("AIRaceSweep: could not start worker %d"), Worker);
+                return false;
+            }
+            Processes.Add(Process);
+            SamplePaths.Add(SamplePath);
+        }
+
+        bool bSuccess = true;
+        for (int32 Worker = 0; Worker < NumWorkers; Worker++)
+        {
+            FPlatformProcess::WaitForProc(Processes[Worker]);
+
+            int32 ReturnCode = 1;
+            FPlatformProcess::GetProcReturnCode(Processes[Worker], &ReturnCode);
+            FPlatformProcess::CloseProc(Processes[Worker]);
+
+            if (ReturnCode != 0 || !LoadSamples(SamplePaths[Worker], OutSamples))
+            {
+                UE_LOG(LogTemp, Error, TEXT("AIRaceSweep: worker %d failed (exit code %d)"), Worker, ReturnCode);
+                bSuccess = false;
+            }
+        }
+        return bSuccess;
+    }
+
+    void ReportDistribution(const FSweepSettings& Settings, const TArray<FLapSample>& Samples, const FString& ReportPath)
+    {
+        FString Text;
+        if (!ReportPath.IsEmpty() && !FPaths::FileExists(ReportPath))
+        {
+            Text = TEXT("Date,Difficulty,Braking,Steering,Mistakes,Laps,DNF,MeanS,StdDevS,MinS,P10S,P50S,P90S,MaxS") LINE_TERMINATOR;
+        }
+
+        const FString Difficulty = StaticEnum<EAIDifficulty>()->GetNameStringByValue(static_cast<int64>(Settings.Difficulty));
+        const FString Date = FDateTime::UtcNow().ToIso8601();
+
+        UE_LOG(LogTemp, Display, TEXT("AI race sweep: %s, %d cars, %d laps, %d races per set"),
+            *Difficulty, Settings.NumCars, Settings.NumLaps, Settings.NumRaces);
+        UE_LOG(LogTemp, Display, TEXT("  Braking Steering Mistakes   Laps  DNF    Mean  StdDev     P10     P50     P90"));
+
+        for (int32 Set = 0; Set < Settings.Sets.Num(); Set++)
+        {
+            TArray<float> LapTimes;
+            int32 NumDNF = 0;
+            for (const FLapSample& Sample : Samples)
+            {
+                if (Sample.Set == Set)
+                {
+                    if (Sample.LapTime >= 0.0f)
+                    {
+                        LapTimes.Add(Sample.LapTime);
+                    }
+                    else
+                    {
+                        NumDNF++;
+                    }
+                }
+            }
+            LapTimes.Sort();
+
+            double Sum = 0.0;
+            for (const float LapTime : LapTimes)
+            {
+                Sum += LapTime;
+            }
+            const double Mean = LapTimes.Num() > 0 ? Sum / LapTimes.Num() : 0.0;
+            double SquaredError = 0.0;
+            for (const float LapTime : LapTimes)
+            {
+                SquaredError += FMath::Square(LapTime - Mean);
+            }
+            const double StdDev = LapTimes.Num() > 1 ? FMath::Sqrt(SquaredError / (LapTimes.Num() - 1)) : 0.0;
+
+            auto Percentile = [&LapTimes](float Fraction)
+            {
+                return LapTimes.Num() > 0 ? LapTimes[FMath::Clamp(FMath::RoundToInt(Fraction * (LapTimes.Num() - 1)), 0, LapTimes.Num() - 1)] : 0.0f;
+            };
+
+            const FSweepParameters& Parameters = Settings.Sets[Set];
+            UE_LOG(LogTemp, Display, TEXT("  %7.2f %8.2f %8.3f %6d %4d %7.2f %7.2f %7.2f %7.2f %7.2f"),
+                Parameters.BrakingAggressiveness, Parameters.SteeringSharpness, Parameters.MistakeChance,
+                LapTimes.Num(), NumDNF, Mean, StdDev, Percentile(0.1f), Percentile(0.5f), Percentile(0.9f));
+
+            Text += FString::Printf(TEXT("%s,%s,%f,%f,%f,%d,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f") LINE_TERMINATOR,
+                *Date, *Difficulty, Parameters.BrakingAggressiveness, Parameters.SteeringSharpness, Parameters.MistakeChance,
+                LapTimes.Num(), NumDNF, Mean, StdDev, Percentile(0.0f), Percentile(0.1f), Percentile(0.5f), Percentile(0.9f), Percentile(1.0f));
+        }
+
+        if (!ReportPath.IsEmpty())
+        {
+            FFileHelper::SaveStringToFile(Text, *ReportPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &IFileManager::Get(), FILEWRITE_Append);
+        }
+    }
+}
+
+UAIRaceSweepCommandlet::UAIRaceSweepCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 UAIRaceSweepCommandlet::Main(const FString& Params)
+{
+    FSweepSettings Settings;
+    int32 Hz = 60;
+    int32 NumWorkers = 1;
+    int32 Shard = INDEX_NONE;
+    int32 NumShards = 1;
+    FString DifficultyName;
+    FString VehicleClassPath;
+    FString ReportPath;
+    FString SamplesPath;
+
+    FParse::Value(*Params, TEXT("Cars="), Settings.NumCars);
+    FParse::Value(*Params, TEXT("Laps="), Settings.NumLaps);
+    FParse::Value(*Params, TEXT("Races="), Settings.NumRaces);
+    FParse::Value(*Params, TEXT("Seed="), Settings.Seed);
+    FParse::Value(*Params, TEXT("Hz="), Hz);
+    FParse::Value(*Params, TEXT("MaxSeconds="), Settings.MaxSeconds);
+    FParse::Value(*Params, TEXT("Workers="), NumWorkers);
+    FParse::Value(*Params, TEXT("Shard="), Shard);
+    FParse::Value(*Params, TEXT("Shards="), NumShards);
+    FParse::Value(*Params, TEXT("Difficulty="), DifficultyName);
+    FParse::Value(*Params, TEXT("VehicleClass="), VehicleClassPath);
+    FParse::Value(*Params, TEXT("Report="), ReportPath);
+    FParse::Value(*Params, TEXT("Samples="), SamplesPath);
+
+    Settings.NumCars = FMath::Clamp(Settings.NumCars, 1, 64);
+    Settings.NumLaps = FMath::Max(Settings.NumLaps, 1);
+    Settings.NumRaces = FMath::Max(Settings.NumRaces, 1);
+    Settings.StepSeconds = 1.0f / FMath::Clamp(Hz, 10, 1000);
+    Settings.MaxSeconds = FMath::Max(Settings.MaxSeconds, 1.0f);
+
+    if (!DifficultyName.IsEmpty())
+    {
+        const int64 Value = StaticEnum<EAIDifficulty>()->GetValueByNameString(DifficultyName);
+        if (Value == INDEX_NONE)
+        {
+            UE_LOG(LogTemp, Error, TEXT("AIRaceSweep: unknown difficulty %s"), *DifficultyName);
+            return 1;
+        }
+        Settings.Difficulty = static_cast<EAIDifficulty>(Value);
+    }
+
+    // Native ARacingVehicle has no mesh or wheels, so every car would sit still until MaxSeconds
+    if (VehicleClassPath.IsEmpty())
+    {
+        UE_LOG(LogTemp, Error, TEXT("AIRaceSweep: -VehicleClass= is required (a vehicle Blueprint with a mesh and wheels)"));
+        return 1;
+    }
+    Settings.VehicleClass = LoadClass<ARacingVehicle>(nullptr, *VehicleClassPath);
+    if (!Settings.VehicleClass)
+    {
+        UE_LOG(LogTemp, Error, TEXT("AIRaceSweep: %s is not an ARacingVehicle class"), *VehicleClassPath);
+        return 1;
+    }
+    if (!Settings.VehicleClass->GetDefaultObject<ARacingVehicle>()->HasSimulatedBody())
+    {
+        UE_LOG(LogTemp, Error, TEXT("AIRaceSweep: %s has no skeletal mesh or no wheels to simulate"), *VehicleClassPath);
+        return 1;
+    }
+
+    // Every combination of the swept values
+    for (const float Braking : ParseList(Params, TEXT("Braking="), 1.0f))
+    {
+        for (const float Steering : ParseList(Params, TEXT("Steering="), 1.0f))
+        {
+            for (const float Mistakes : ParseList(Params, TEXT("Mistakes="), 0.05f))
+            {
+                Settings.Sets.Add({ Braking, Steering, Mistakes });
+            }
+        }
+    }
+
+    TArray<FLapSample> Samples;
+
+    // Worker: run a share and hand the raw laps back to the parent
+    if (Shard != INDEX_NONE)
+    {
+        if (!RunShard(Settings, Shard, FMath::Max(NumShards, 1), Samples))
+        {
+            return 1;
+        }
+
+        FString Text;
+        for (const FLapSample& Sample : Samples)
+        {
+            Text += FormatSample(Sample) + LINE_TERMINATOR;
+        }
+        return FFileHelper::SaveStringToFile(Text, *SamplesPath) ? 0 : 1;
+    }
+
+    NumWorkers = FMath::Clamp(NumWorkers, 1, Settings.Sets.Num());
+    UE_LOG(LogTemp, Display, TEXT("AIRaceSweep: %d parameter sets x %d races on %d worker(s)"), Settings.Sets.Num(), Settings.NumRaces, NumWorkers);
+
+    const double StartSeconds = FPlatformTime::Seconds();
+    const bool bSuccess = NumWorkers > 1 ? RunWorkers(Settings, NumWorkers, Samples) : RunShard(Settings, 0, 1, Samples);
+    if (!bSuccess)
+    {
+        return 1;
+    }
+
+    ReportDistribution(Settings, Samples, ReportPath);
+    UE_LOG(LogTemp, Display, TEXT("AIRaceSweep: finished in %.1f s"), FPlatformTime::Seconds() - StartSeconds);
+    return 0;
+}
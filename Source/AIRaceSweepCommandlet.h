@@ -0,0 +1,40 @@
+// AIRaceSweepCommandlet.h
+// Headless AI-only races over a grid of driver settings, for difficulty calibration
+// Copyright 2025. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "AIRaceSweepCommandlet.generated.h"
+
+/**
+ * Races AI cars on a generated circuit for every combination of the given
+ * BrakingAggressiveness, SteeringSharpness and MistakeChance values, and reports
+ * the lap-time distribution of each combination (mean, spread, percentiles, DNFs).
+ * Every race gets its own world and race seed, so results are reproducible.
+ *
+ * Worlds tick on the game thread, so races are spread over -Workers child
+ * processes, each running every Workers-th parameter set and writing raw lap
+ * times that the parent merges. Inside each process the AI and vehicle passes
+ * still run wide.
+ *
+ * Usage:
+ *   UnrealEditor-Cmd CarGame.uproject -run=AIRaceSweep -nullrhi -unattended
+ *     -VehicleClass=/Game/Vehicles/BP_Car.BP_Car_C
+ *     [-Braking=0.8,1.0,1.2] [-Steering=0.8,1.0,1.2] [-Mistakes=0,0.05,0.1]
+ *     [-Difficulty=Medium] [-Cars=8] [-Laps=3] [-Races=4] [-Seed=1] [-Hz=60]
+ *     [-MaxSeconds=900] [-Workers=4] [-Report=Saved/AIRaceSweep.csv]
+ *
+ * -VehicleClass must have a skeletal mesh and wheel setups; native ARacingVehicle has neither.
+ */
+UCLASS()
+class CARGAME_API UAIRaceSweepCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UAIRaceSweepCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -3,7 +3,9 @@
 #include "AIRacingController.h"
 #include "RacingVehicle.h"
 #include "RaceTrackManager.h"
-#include "GameFramework/PlayerController.h"
+#include "RacingLine.h"
+#include "AIDrivingKernel.h"
+#include "AIRacingSubsystem.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "DrawDebugHelpers.h"
@@ -23,27 +25,36 @@ void AAIRacingController::BeginPlay()
     // Find track manager
     TrackManager = Cast<ARaceTrackManager>(UGameplayStatics::GetActorOfClass(GetWorld(), ARaceTrackManager::StaticClass()));
 
-    // Apply difficulty settings
+    // Follow the track's shared racing line unless one was assigned already
+    if (TrackManager && !HasRaceline())
+    {
+        SetRacingLine(TrackManager->GetRacingLine());
+        bFollowsTrackRacingLine = true;
+        TrackManager->OnRacingLineChanged.AddUniqueDynamic(this, &AAIRacingController::HandleTrackRacingLineChanged);
+    }
+
+    // Hand the per-frame update to the batched AI pass
+    if (UAIRacingSubsystem* AIRacing = GetWorld()->GetSubsystem<UAIRacingSubsystem>())
+    {
+        AIRacing->RegisterController(this);
+    }
+
+    // Apply difficulty settings; pace comes from the racing line's speed profile for this difficulty
     switch (Difficulty)
     {
         case EAIDifficulty::Easy:
-            MaxSpeedMultiplier = 0.7f;
             MistakeChance = 0.2f;
             break;
         case EAIDifficulty::Medium:
-            MaxSpeedMultiplier = 0.85f;
             MistakeChance = 0.1f;
             break;
         case EAIDifficulty::Hard:
-            MaxSpeedMultiplier = 0.95f;
             MistakeChance = 0.05f;
             break;
         case EAIDifficulty::Expert:
-            MaxSpeedMultiplier = 1.0f;
             MistakeChance = 0.02f;
             break;
         case EAIDifficulty::Impossible:
-            MaxSpeedMultiplier = 1.1f;
             MistakeChance = 0.0f;
             break;
     }
@@ -54,6 +65,7 @@ void AAIRacingController::OnPossess(APawn* InPawn)
     Super::OnPossess(InPawn);
 
     ControlledVehicle = Cast<ARacingVehicle>(InPawn);
+    bWaypointTracked = false;
     
     if (ControlledVehicle)
     {
@@ -61,6 +73,24 @@ void AAIRacingController::OnPossess(APawn* InPawn)
     }
 }
 
+void AAIRacingController::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (TrackManager)
+    {
+        TrackManager->OnRacingLineChanged.RemoveDynamic(this, &AAIRacingController::HandleTrackRacingLineChanged);
+    }
+
+    if (BatchSlot != INDEX_NONE)
+    {
+        if (UAIRacingSubsystem* AIRacing = GetWorld()->GetSubsystem<UAIRacingSubsystem>())
+        {
+            AIRacing->UnregisterController(this);
+        }
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
 void AAIRacingController::OnUnPossess()
 {
     ControlledVehicle = nullptr;
@@ -71,7 +101,19 @@ void AAIRacingController::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
 
-    if (!ControlledVehicle || RacelineWaypoints.Num() == 0)
+    if (!ControlledVehicle || !HasRaceline())
+    {
+        return;
+    }
+
+    // Distant cars are moved along the line by the simulation subsystem's physics LOD
+    if (ControlledVehicle->IsKinematicLOD())
+    {
+        return;
+    }
+
+    // Decided together with every other AI car by UAIRacingSubsystem
+    if (BatchSlot != INDEX_NONE && UAIRacingSubsystem::IsBatchedUpdateEnabled())
     {
         return;
     }
@@ -91,34 +133,72 @@ void AAIRacingController::Tick(float DeltaTime)
 
 void AAIRacingController::InitializeRacingAI(const TArray<FVector>& Waypoints)
 {
-    RacelineWaypoints = Waypoints;
-    
-    // Generate optimal speeds for each waypoint
-    WaypointSpeeds.SetNum(Waypoints.Num());
-    
-    for (int32 i = 0; i < Waypoints.Num(); i++)
+    // Controllers given the same waypoints share one line
+    SetRacingLine(FRacingLine::FindOrBuild(Waypoints));
+    bFollowsTrackRacingLine = false;
+
+    UE_LOG(LogTemp, Log, TEXT("AI Racing initialized with %d waypoints"), Waypoints.Num());
+}
+
+void AAIRacingController::SetRacingLine(const TSharedPtr<const FRacingLine, ESPMode::ThreadSafe>& InRacingLine)
+{
+    RacingLine = InRacingLine;
+    RacingData.CurrentWaypointIndex = 0;
+    bWaypointTracked = false;
+}
+
+void AAIRacingController::HandleTrackRacingLineChanged()
+{
+    if (bFollowsTrackRacingLine && TrackManager)
     {
-        int32 NextIndex = (i + 1) % Waypoints.Num();
-        int32 PrevIndex = (i - 1 + Waypoints.Num()) % Waypoints.Num();
-        
-        FVector ToNext = Waypoints[NextIndex] - Waypoints[i];
-        FVector ToPrev = Waypoints[i] - Waypoints[PrevIndex];
-        
-        ToNext.Normalize();
-        ToPrev.Normalize();
-        
-        // Calculate corner sharpness (lower dot = sharper corner)
-        float CornerSharpness = FVector::DotProduct(ToNext, ToPrev);
-        
-        // Speed based on corner sharpness (sharper = slower)
-        float BaseSpeed = 200.0f; // km/h
-        float MaxSpeed = 300.0f;
-        float CornerSpeed = FMath::Lerp(BaseSpeed, MaxSpeed, (CornerSharpness + 1.0f) * 0.5f);
-        
-        WaypointSpeeds[i] = CornerSpeed * MaxSpeedMultiplier;
+        SetRacingLine(TrackManager->GetRacingLine());
     }
+}
 
-    UE_LOG(LogTemp, Log, TEXT("AI Racing initialized with %d waypoints"), Waypoints.Num());
+void AAIRacingController::SetRandomSeed(int32 Seed)
+{
+    RandomStream.Initialize(Seed);
+}
+
+bool AAIRacingController::HasRaceline() const
+{
+    return RacingLine.IsValid() && RacingLine->IsValid();
+}
+
+float AAIRacingController::GetRacelineLength() const
+{
+    return RacingLine.IsValid() ? RacingLine->GetLength() : 0.0f;
+}
+
+int32 AAIRacingController::GetNumRacelineWaypoints() const
+{
+    return RacingLine.IsValid() ? RacingLine->Num() : 0;
+}
+
+float AAIRacingController::GetWaypointSpeed(int32 WaypointIndex) const
+{
+    if (!RacingLine.IsValid())
+    {
+        return 0.0f;
+    }
+
+    const TArray<float>& ProfileSpeeds = RacingLine->GetSpeedProfile(Difficulty).Speed;
+    if (!ProfileSpeeds.IsValidIndex(WaypointIndex))
+    {
+        return 0.0f;
+    }
+    return ProfileSpeeds[WaypointIndex] * 0.036f * MaxSpeedMultiplier; // cm/s to km/h
+}
+
+float AAIRacingController::GetDistanceToBrakingPoint() const
+{
+    if (!ControlledVehicle || !HasRaceline())
+    {
+        return 0.0f;
+    }
+
+    const float Distance = RacingLine->ProjectNear(ControlledVehicle->GetActorLocation(), RacingData.CurrentWaypointIndex);
+    return RacingLine->GetSpeedProfile(Difficulty).GetDistanceToBrakingPoint(Distance) * 0.01f; // cm to m
 }
 
 void AAIRacingController::UpdateRacingInputs(float DeltaTime)
@@ -130,23 +210,11 @@ void AAIRacingController::UpdateRacingInputs(float DeltaTime)
 
     // Update current waypoint
     FVector VehicleLocation = ControlledVehicle->GetActorLocation();
-    float ClosestDistance = MAX_FLT;
-    
-    for (int32 i = 0; i < RacelineWaypoints.Num(); i++)
-    {
-        float Distance = FVector::Dist(VehicleLocation, RacelineWaypoints[i]);
-        if (Distance < ClosestDistance)
-        {
-            ClosestDistance = Distance;
-            RacingData.CurrentWaypointIndex = i;
-        }
-    }
-
-    RacingData.DistanceToNextWaypoint = ClosestDistance;
+    RacingData.DistanceToNextWaypoint = FMath::Sqrt(UpdateCurrentWaypoint(VehicleLocation));
 
     // Check for mistakes
     TimeSinceMistake += DeltaTime;
-    if (!bCurrentlyMakingMistake && FMath::FRand() < MistakeChance * DeltaTime)
+    if (!bCurrentlyMakingMistake && RandomStream.FRand() < MistakeChance * DeltaTime)
     {
         SimulateMistake();
     }
@@ -180,7 +248,10 @@ void AAIRacingController::UpdateRacingInputs(float DeltaTime)
     {
         RacingData.CurrentState = EAIRacingState::Overtaking;
         RacingData.bIsOvertaking = true;
-        OvertakeTimer = 3.0f; // Overtake attempt duration
+        OvertakeTimer = AIDriving::OvertakeDuration;
+
+        // Alternate sides between attempts
+        bOvertakeLeft = !bOvertakeLeft;
     }
 
     // Update overtaking
@@ -195,125 +266,77 @@ void AAIRacingController::UpdateRacingInputs(float DeltaTime)
     }
 }
 
+float AAIRacingController::UpdateCurrentWaypoint(const FVector& Location)
+{
+    // Windowed walk from last tick's waypoint; the grid takes over after respawns and off-track excursions
+    const int32 Hint = bWaypointTracked ? RacingData.CurrentWaypointIndex : INDEX_NONE;
+    float DistanceSquared = MAX_FLT;
+    const int32 Closest = RacingLine->GetSpatialIndex().FindNearestFrom(Location, Hint, WaypointSearchWindow, WaypointRecoveryDistance * 100.0f, DistanceSquared);
+
+    if (Closest != INDEX_NONE)
+    {
+        RacingData.CurrentWaypointIndex = Closest;
+        bWaypointTracked = true;
+    }
+    return DistanceSquared;
+}
+
+void AAIRacingController::ResetWaypointTracking()
+{
+    bWaypointTracked = false;
+}
+
 float AAIRacingController::CalculateSteeringInput()
 {
-    if (!ControlledVehicle || RacelineWaypoints.Num() == 0)
+    if (!ControlledVehicle || !HasRaceline())
     {
         return 0.0f;
     }
 
-    // Get target waypoint (look ahead)
-    int32 LookAheadWaypoints = FMath::CeilToInt(ControlledVehicle->GetVehicleMovementComponent()->GetForwardSpeed() / 100.0f);
-    LookAheadWaypoints = FMath::Clamp(LookAheadWaypoints, 1, 10);
-    
-    int32 TargetIndex = GetNextWaypointIndex(RacingData.CurrentWaypointIndex, LookAheadWaypoints);
-    FVector TargetWaypoint = RacelineWaypoints[TargetIndex];
+    FVector TargetOffset = FVector::ZeroVector;
 
     // Apply overtaking offset
     if (RacingData.bIsOvertaking)
     {
-        float Offset = GetOvertakingOffset();
-        FVector Right = ControlledVehicle->GetActorRightVector();
-        TargetWaypoint += Right * Offset;
+        TargetOffset += ControlledVehicle->GetActorRightVector() * GetOvertakingOffset();
     }
 
     // Apply mistake offset
     if (bCurrentlyMakingMistake)
     {
-        TargetWaypoint += MistakeOffset;
+        TargetOffset += MistakeOffset;
     }
 
-    // Calculate steering angle
-    FVector VehicleLocation = ControlledVehicle->GetActorLocation();
-    FVector VehicleForward = ControlledVehicle->GetActorForwardVector();
-    FVector ToTarget = TargetWaypoint - VehicleLocation;
-    ToTarget.Z = 0.0f;
-    ToTarget.Normalize();
-
-    // Cross product for steering direction
-    float CrossProduct = FVector::CrossProduct(VehicleForward, ToTarget).Z;
-    
-    // Dot product for steering magnitude
-    float DotProduct = FVector::DotProduct(VehicleForward, ToTarget);
-    
-    float SteeringAngle = FMath::Asin(FMath::Clamp(CrossProduct, -1.0f, 1.0f));
-    float SteeringInput = SteeringAngle / (PI * 0.5f); // Normalize to -1 to 1
-
     // Apply behavior-specific steering sharpness
-    SteeringInput *= SteeringSharpness * GetBehaviorSpeedMultiplier();
-
-    return FMath::Clamp(SteeringInput, -1.0f, 1.0f);
+    return AIDriving::ComputeSteering(*RacingLine, RacingData.CurrentWaypointIndex, ControlledVehicle->GetActorLocation(),
+        ControlledVehicle->GetActorForwardVector(), ControlledVehicle->GetVehicleMovementComponent()->GetForwardSpeed(),
+        TargetOffset, SteeringSharpness * GetBehaviorSpeedMultiplier());
 }
 
 void AAIRacingController::CalculateThrottleBrake(float& OutThrottle, float& OutBrake)
 {
-    if (!ControlledVehicle || WaypointSpeeds.Num() == 0)
+    if (!ControlledVehicle || !HasRaceline())
     {
         OutThrottle = 0.0f;
         OutBrake = 0.0f;
         return;
     }
 
-    // Get current and target speed
-    float CurrentSpeed = ControlledVehicle->GetVehicleMovementComponent()->GetForwardSpeed() * 0.036f; // cm/s to km/h
-    
-    // Look ahead for corner speeds
-    int32 LookAheadWaypoints = 3;
-    float TargetSpeed = WaypointSpeeds[RacingData.CurrentWaypointIndex];
-    
-    for (int32 i = 1; i <= LookAheadWaypoints; i++)
+    float ObstacleDistance;
+    if (!DetectObstaclesAhead(ObstacleDistance))
     {
-        int32 CheckIndex = GetNextWaypointIndex(RacingData.CurrentWaypointIndex, i);
-        TargetSpeed = FMath::Min(TargetSpeed, WaypointSpeeds[CheckIndex]);
+        ObstacleDistance = MAX_FLT;
     }
 
-    // Apply behavior multiplier
-    TargetSpeed *= GetBehaviorSpeedMultiplier();
-
-    // Calculate braking distance needed
-    float SpeedDifference = CurrentSpeed - TargetSpeed;
-    float BrakingDistance = (SpeedDifference > 0.0f) ? (SpeedDifference * SpeedDifference) / (2.0f * 9.8f * 1.2f) : 0.0f;
-    BrakingDistance *= BrakingAggressiveness * GetBehaviorBrakingMultiplier();
-
-    // Distance to next waypoint
-    float DistanceToCorner = RacingData.DistanceToNextWaypoint * 0.01f; // cm to m
+    const float Distance = RacingLine->ProjectNear(ControlledVehicle->GetActorLocation(), RacingData.CurrentWaypointIndex);
+    float TargetSpeed;
+    const bool bBraking = AIDriving::ComputeThrottleBrake(*RacingLine, Difficulty, Distance,
+        ControlledVehicle->GetVehicleMovementComponent()->GetForwardSpeed(), MaxSpeedMultiplier * GetBehaviorSpeedMultiplier(),
+        GetBrakingResponseTime(), ObstacleDistance, OutThrottle, OutBrake, TargetSpeed);
 
-    // Decide throttle/brake
-    if (CurrentSpeed > TargetSpeed && DistanceToCorner < BrakingDistance)
-    {
-        // Need to brake
-        OutThrottle = 0.0f;
-        OutBrake = FMath::Clamp((CurrentSpeed - TargetSpeed) / TargetSpeed, 0.0f, 1.0f);
-        RacingData.CurrentState = EAIRacingState::Braking;
-    }
-    else if (CurrentSpeed < TargetSpeed * 0.95f)
-    {
-        // Can accelerate
-        OutThrottle = FMath::Clamp((TargetSpeed - CurrentSpeed) / TargetSpeed, 0.3f, 1.0f);
-        OutBrake = 0.0f;
-        RacingData.CurrentState = EAIRacingState::FollowingRaceline;
-    }
-    else
-    {
-        // Maintain speed
-        OutThrottle = 0.5f;
-        OutBrake = 0.0f;
-    }
-
-    // Check for obstacles
-    float ObstacleDistance;
-    if (DetectObstaclesAhead(ObstacleDistance))
-    {
-        if (ObstacleDistance < 10.0f)
-        {
-            OutBrake = 1.0f;
-            OutThrottle = 0.0f;
-        }
-        else if (ObstacleDistance < 30.0f)
-        {
-            OutThrottle *= 0.5f;
-        }
-    }
+    RacingData.TargetSpeed = TargetSpeed * 0.036f; // cm/s to km/h
+    RacingData.CurrentState = bCurrentlyMakingMistake ? EAIRacingState::Recovering
+        : bBraking ? EAIRacingState::Braking : EAIRacingState::FollowingRaceline;
 }
 
 bool AAIRacingController::ShouldAttemptOvertake()
@@ -336,25 +359,22 @@ bool AAIRacingController::ShouldAttemptOvertake()
 
 float AAIRacingController::GetOvertakingOffset()
 {
-    float MaxOffset = 400.0f; // cm (4 meters)
-    
-    // Alternate sides
-    bOvertakeLeft = !bOvertakeLeft;
+    // Side is picked when the attempt starts
     float Direction = bOvertakeLeft ? -1.0f : 1.0f;
-    
-    return Direction * MaxOffset * GetOvertakingAggression();
+
+    return Direction * AIDriving::OvertakeOffset * GetOvertakingAggression();
 }
 
 void AAIRacingController::SimulateMistake()
 {
     bCurrentlyMakingMistake = true;
-    MistakeDuration = FMath::RandRange(0.5f, 2.0f);
+    MistakeDuration = RandomStream.FRandRange(0.5f, 2.0f);
     TimeSinceMistake = 0.0f;
 
     // Random offset from racing line
     MistakeOffset = FVector(
-        FMath::RandRange(-300.0f, 300.0f),
-        FMath::RandRange(-300.0f, 300.0f),
+        RandomStream.FRandRange(-300.0f, 300.0f),
+        RandomStream.FRandRange(-300.0f, 300.0f),
         0.0f
     );
 
@@ -365,49 +385,74 @@ void AAIRacingController::SimulateMistake()
 
 void AAIRacingController::ApplyRubberBanding()
 {
-    // Find player vehicle
-    APlayerController* PlayerController = UGameplayStatics::GetPlayerController(GetWorld(), 0);
-    if (!PlayerController)
+    // Gap along the track, published once per frame by the AI subsystem
+    const UAIRacingSubsystem* AIRacing = GetWorld()->GetSubsystem<UAIRacingSubsystem>();
+    float GapToPlayer;
+    if (!AIRacing || !AIRacing->GetGapToPlayer(this, GapToPlayer))
     {
         return;
     }
 
-    ARacingVehicle* PlayerVehicle = Cast<ARacingVehicle>(PlayerController->GetPawn());
-    if (!PlayerVehicle || !ControlledVehicle)
+    MaxSpeedMultiplier = AIDriving::ComputeRubberBanding(MaxSpeedMultiplier, GapToPlayer, RubberBandingStrength, GetWorld()->GetDeltaSeconds());
+}
+
+float AAIRacingController::GetRacelineDistance(const FVector& Location) const
+{
+    return HasRaceline() ? RacingLine->ProjectNear(Location, RacingData.CurrentWaypointIndex) : 0.0f;
+}
+
+void AAIRacingController::SampleRaceline(float Distance, FVector& OutLocation, FVector& OutTangent, float& OutTargetSpeed) const
+{
+    if (!RacingLine.IsValid())
     {
+        OutLocation = FVector::ZeroVector;
+        OutTangent = FVector::ForwardVector;
+        OutTargetSpeed = 0.0f;
         return;
     }
 
-    // Calculate distance to player
-    float Distance = FVector::Dist(PlayerVehicle->GetActorLocation(), ControlledVehicle->GetActorLocation());
-    
-    // If AI is far ahead, slow down
-    // If AI is far behind, speed up
-    float IdealDistance = 5000.0f; // 50 meters
-    float DistanceDifference = Distance - IdealDistance;
-    
-    float SpeedAdjustment = (DistanceDifference / IdealDistance) * RubberBandingStrength;
-    MaxSpeedMultiplier = FMath::Clamp(MaxSpeedMultiplier + SpeedAdjustment * 0.01f, 0.5f, 1.2f);
+    RacingLine->Sample(Distance, OutLocation, OutTangent);
+
+    // Same target as CalculateThrottleBrake
+    OutTargetSpeed = RacingLine->SampleSpeed(Difficulty, Distance) * MaxSpeedMultiplier * GetBehaviorSpeedMultiplier();
+}
+
+void AAIRacingController::SyncToRacelineDistance(float Distance)
+{
+    if (!HasRaceline())
+    {
+        return;
+    }
+
+    Distance = RacingLine->WrapDistance(Distance);
+
+    // Snap to whichever end of the segment is closer, as the nearest-waypoint search would
+    const TArray<float>& ArcLengths = RacingLine->GetArcLengths();
+    const int32 Segment = RacingLine->FindSegment(Distance);
+    const bool bNearerNext = Distance - ArcLengths[Segment] > ArcLengths[Segment + 1] - Distance;
+    RacingData.CurrentWaypointIndex = bNearerNext ? (Segment + 1) % RacingLine->Num() : Segment;
+    bWaypointTracked = true;
 }
 
 int32 AAIRacingController::GetNextWaypointIndex(int32 CurrentIndex, int32 LookAhead)
 {
-    if (RacelineWaypoints.Num() == 0)
+    const int32 NumWaypoints = GetNumRacelineWaypoints();
+    if (NumWaypoints == 0)
     {
         return 0;
     }
 
-    return (CurrentIndex + LookAhead) % RacelineWaypoints.Num();
+    return (CurrentIndex + LookAhead) % NumWaypoints;
 }
 
 float AAIRacingController::GetDistanceToWaypoint(int32 WaypointIndex)
 {
-    if (!ControlledVehicle || WaypointIndex >= RacelineWaypoints.Num())
+    if (!ControlledVehicle || !RacingLine.IsValid() || !RacingLine->GetPositions().IsValidIndex(WaypointIndex))
     {
         return 0.0f;
     }
 
-    return FVector::Dist(ControlledVehicle->GetActorLocation(), RacelineWaypoints[WaypointIndex]);
+    return FVector::Dist(ControlledVehicle->GetActorLocation(), RacingLine->GetPositions()[WaypointIndex]);
 }
 
 bool AAIRacingController::DetectObstaclesAhead(float& OutDistance)
@@ -417,9 +462,33 @@ bool AAIRacingController::DetectObstaclesAhead(float& OutDistance)
         return false;
     }
 
+    // The shared proximity index sees every car on the line; only trace to confirm a full stop
+    const UAIRacingSubsystem* AIRacing = GetWorld()->GetSubsystem<UAIRacingSubsystem>();
+    float IndexDistance;
+    if (AIRacing && AIRacing->GetVehicleAhead(this, IndexDistance))
+    {
+        if (IndexDistance >= AIDriving::ObstacleBrakeDistance)
+        {
+            OutDistance = IndexDistance;
+            return IndexDistance < MAX_FLT;
+        }
+
+        // Unconfirmed cars are only close enough to lift for
+        if (!TraceObstacleAhead(OutDistance))
+        {
+            OutDistance = AIDriving::ObstacleBrakeDistance;
+        }
+        return true;
+    }
+
+    return TraceObstacleAhead(OutDistance);
+}
+
+bool AAIRacingController::TraceObstacleAhead(float& OutDistance)
+{
     FVector Start = ControlledVehicle->GetActorLocation();
     FVector Forward = ControlledVehicle->GetActorForwardVector();
-    FVector End = Start + Forward * 3000.0f; // 30 meters ahead
+    FVector End = Start + Forward * AIDriving::ObstacleProbeLength;
 
     FHitResult HitResult;
     FCollisionQueryParams QueryParams;
@@ -444,13 +513,13 @@ void AAIRacingController::ApplyInputsToVehicle()
     }
 
     // Apply steering
-    ControlledVehicle->SetSteeringInput(RacingData.SteeringInput);
+    ControlledVehicle->SetSteering(RacingData.SteeringInput);
 
     // Apply throttle
-    ControlledVehicle->SetThrottleInput(RacingData.ThrottleInput);
+    ControlledVehicle->SetThrottle(RacingData.ThrottleInput);
 
     // Apply brake
-    ControlledVehicle->SetBrakeInput(RacingData.BrakeInput);
+    ControlledVehicle->SetBrake(RacingData.BrakeInput);
 }
 
 float AAIRacingController::GetBehaviorSpeedMultiplier() const
@@ -472,6 +541,11 @@ float AAIRacingController::GetBehaviorSpeedMultiplier() const
     }
 }
 
+float AAIRacingController::GetBrakingResponseTime() const
+{
+    return 0.3f * BrakingAggressiveness * GetBehaviorBrakingMultiplier();
+}
+
 float AAIRacingController::GetBehaviorBrakingMultiplier() const
 {
     switch (RacingBehavior)
@@ -512,11 +586,13 @@ float AAIRacingController::GetOvertakingAggression() const
 
 void AAIRacingController::DrawDebugRaceline()
 {
-    if (!GetWorld() || RacelineWaypoints.Num() < 2)
+    if (!GetWorld() || !HasRaceline())
     {
         return;
     }
 
+    const TArray<FVector>& RacelineWaypoints = RacingLine->GetPositions();
+
     // Draw waypoints
     for (int32 i = 0; i < RacelineWaypoints.Num(); i++)
     {
@@ -9,6 +9,7 @@
 
 class ARacingVehicle;
 class ARaceTrackManager;
+class FRacingLine;
 
 /**
  * AI Racing Behavior Types
@@ -109,6 +110,7 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void OnPossess(APawn* InPawn) override;
     virtual void OnUnPossess() override;
 
@@ -127,9 +129,9 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Racing|Config")
     EAIDifficulty Difficulty = EAIDifficulty::Medium;
 
-    /** Maximum speed multiplier (1.0 = 100% of vehicle max speed) */
+    /** Multiplier on the difficulty's speed profile (1.0 = drive the profile exactly); rubber-banding adjusts it */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Racing|Config", meta = (ClampMin = "0.5", ClampMax = "1.5"))
-    float MaxSpeedMultiplier = 0.85f;
+    float MaxSpeedMultiplier = 1.0f;
 
     /** How aggressively AI brakes (higher = earlier braking) */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Racing|Config", meta = (ClampMin = "0.5", ClampMax = "2.0"))
@@ -139,7 +141,7 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Racing|Config", meta = (ClampMin = "0.5", ClampMax = "2.0"))
     float SteeringSharpness = 1.0f;
 
-    /** Enable rubber-banding (AI adjusts speed based on player position) */
+    /** Enable rubber-banding (AI adjusts speed to its time gap to the player along the track) */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Racing|Config")
     bool bEnableRubberBanding = false;
 
@@ -155,17 +157,61 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Racing|Config", meta = (ClampMin = "10.0", ClampMax = "200.0"))
     float LookAheadDistance = 50.0f;
 
+    /** Waypoints searched ahead of the current one each tick when tracking the closest waypoint */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Racing|Config", meta = (ClampMin = "2", ClampMax = "256"))
+    int32 WaypointSearchWindow = 16;
+
+    /** Further than this from the tracked waypoint (meters), the closest one is searched for across the whole line */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI Racing|Config", meta = (ClampMin = "1.0", ClampMax = "500.0"))
+    float WaypointRecoveryDistance = 25.0f;
+
+    /**
+     * Reseed this driver's mistake, overtake and behavior randomness.
+     * UAIRacingSubsystem derives the seed from the race seed when the controller registers.
+     */
+    void SetRandomSeed(int32 Seed);
+
+    int32 GetRandomSeed() const { return RandomStream.GetInitialSeed(); }
+
     // ============================================================
     // Racing Line
     // ============================================================
 
-    /** Racing line waypoints (set by RaceTrackManager) */
-    UPROPERTY(BlueprintReadWrite, Category = "AI Racing|Waypoints")
-    TArray<FVector> RacelineWaypoints;
+    /** Follow an already-built racing line; every controller on a track should share the same one */
+    void SetRacingLine(const TSharedPtr<const FRacingLine, ESPMode::ThreadSafe>& InRacingLine);
+
+    /** Shared, immutable racing line this controller follows (null until initialized) */
+    const TSharedPtr<const FRacingLine, ESPMode::ThreadSafe>& GetRacingLine() const { return RacingLine; }
+
+    /** True once a usable racing line has been assigned */
+    bool HasRaceline() const;
+
+    /** Length of the closed racing line (cm) */
+    float GetRacelineLength() const;
+
+    UFUNCTION(BlueprintCallable, Category = "AI Racing|Waypoints")
+    int32 GetNumRacelineWaypoints() const;
+
+    /** This driver's target speed (km/h) at a waypoint: the difficulty's speed profile times MaxSpeedMultiplier */
+    UFUNCTION(BlueprintCallable, Category = "AI Racing|Waypoints")
+    float GetWaypointSpeed(int32 WaypointIndex) const;
+
+    /** Distance (meters) along the racing line from the car to the start of the next braking zone */
+    UFUNCTION(BlueprintCallable, Category = "AI Racing|Waypoints")
+    float GetDistanceToBrakingPoint() const;
+
+    /** Arc length (cm) of the point on the racing line closest to Location, searched around the current waypoint */
+    float GetRacelineDistance(const FVector& Location) const;
+
+    /** Position, unit tangent and speed profile target (cm/s) at arc length Distance; wraps around the lap */
+    void SampleRaceline(float Distance, FVector& OutLocation, FVector& OutTangent, float& OutTargetSpeed) const;
 
-    /** Corner speeds for each waypoint */
-    UPROPERTY(BlueprintReadWrite, Category = "AI Racing|Waypoints")
-    TArray<float> WaypointSpeeds;
+    /** Continue from arc length Distance, e.g. after the car was moved kinematically by the physics LOD */
+    void SyncToRacelineDistance(float Distance);
+
+    /** Forget the tracked waypoint so the next tick searches the whole line (call after teleporting the car) */
+    UFUNCTION(BlueprintCallable, Category = "AI Racing")
+    void ResetWaypointTracking();
 
     // ============================================================
     // AI State
@@ -227,7 +273,7 @@ public:
     UFUNCTION(BlueprintCallable, Category = "AI Racing")
     float GetDistanceToWaypoint(int32 WaypointIndex);
 
-    /** Detect obstacles ahead */
+    /** Distance (m) to the nearest car ahead, from the AI subsystem's proximity index when registered, else a line trace */
     UFUNCTION(BlueprintCallable, Category = "AI Racing")
     bool DetectObstaclesAhead(float& OutDistance);
 
@@ -247,6 +293,9 @@ public:
     UFUNCTION(BlueprintCallable, Category = "AI Racing")
     float GetBehaviorBrakingMultiplier() const;
 
+    /** Seconds ahead the speed profile is read, from BrakingAggressiveness and behavior */
+    float GetBrakingResponseTime() const;
+
     /** Get behavior-specific overtaking aggression */
     UFUNCTION(BlueprintCallable, Category = "AI Racing")
     float GetOvertakingAggression() const;
@@ -264,7 +313,10 @@ public:
     void DrawDebugRaceline();
 
 private:
+    friend class UAIRacingSubsystem;
+
     // Internal state
+    FRandomStream RandomStream;
     float TimeSinceMistake = 0.0f;
     float MistakeDuration = 0.0f;
     FVector MistakeOffset = FVector::ZeroVector;
@@ -273,4 +325,26 @@ private:
     // Overtaking state
     float OvertakeTimer = 0.0f;
     bool bOvertakeLeft = true;
+
+    // Shared with every other controller on the track
+    TSharedPtr<const FRacingLine, ESPMode::ThreadSafe> RacingLine;
+
+    // Following TrackManager's line, so a newly optimized one replaces it
+    bool bFollowsTrackRacingLine = false;
+
+    // CurrentWaypointIndex is only a valid search hint while tracked
+    bool bWaypointTracked = false;
+
+    // Slot in UAIRacingSubsystem's batch (INDEX_NONE when this controller updates itself)
+    int32 BatchSlot = INDEX_NONE;
+
+    /** Line trace straight ahead of the vehicle. OutDistance in m. */
+    bool TraceObstacleAhead(float& OutDistance);
+
+    /** Update RacingData.CurrentWaypointIndex for Location. Returns the squared distance to it. */
+    float UpdateCurrentWaypoint(const FVector& Location);
+
+    /** The track's racing line was rebuilt, e.g. once its optimized line finished solving */
+    UFUNCTION()
+    void HandleTrackRacingLineChanged();
 };
@@ -0,0 +1,1048 @@
+// AIRacingSubsystem.cpp
+// Batched AI decision update implementation
+// Copyright 2025. All Rights Reserved.
+
+#include "AIRacingSubsystem.h"
+#include "AIRacingController.h"
+#include "AIDrivingKernel.h"
+#include "RacingLine.h"
+#include "RacingVehicle.h"
+#include "RaceProgressSubsystem.h"
+#include "VehicleSimulationSubsystem.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Misc/Crc.h"
+
+DECLARE_CYCLE_STAT(TEXT("AI Racing Total"), STAT_AIRacing_Total, STATGROUP_AIRacing);
+DECLARE_CYCLE_STAT(TEXT("AI Racing Tracking"), STAT_AIRacing_Tracking, STATGROUP_AIRacing);
+DECLARE_CYCLE_STAT(TEXT("AI Racing Gather"), STAT_AIRacing_Gather, STATGROUP_AIRacing);
+DECLARE_CYCLE_STAT(TEXT("AI Racing Compute"), STAT_AIRacing_Compute, STATGROUP_AIRacing);
+DECLARE_CYCLE_STAT(TEXT("AI Racing Compute Full"), STAT_AIRacing_ComputeFull, STATGROUP_AIRacing);
+DECLARE_CYCLE_STAT(TEXT("AI Racing Compute Reduced"), STAT_AIRacing_ComputeReduced, STATGROUP_AIRacing);
+DECLARE_CYCLE_STAT(TEXT("AI Racing Compute Distant"), STAT_AIRacing_ComputeDistant, STATGROUP_AIRacing);
+DECLARE_CYCLE_STAT(TEXT("AI Racing Scatter"), STAT_AIRacing_Scatter, STATGROUP_AIRacing);
+DECLARE_CYCLE_STAT(TEXT("AI Racing Significance"), STAT_AIRacing_Significance, STATGROUP_AIRacing);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AI Controllers"), STAT_AIRacing_NumControllers, STATGROUP_AIRacing);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AI Active Drivers"), STAT_AIRacing_NumActive, STATGROUP_AIRacing);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AI Drivers Full"), STAT_AIRacing_NumFull, STATGROUP_AIRacing);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AI Drivers Reduced"), STAT_AIRacing_NumReduced, STATGROUP_AIRacing);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AI Drivers Distant"), STAT_AIRacing_NumDistant, STATGROUP_AIRacing);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AI Decisions"), STAT_AIRacing_NumDecisions, STATGROUP_AIRacing);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AI Proximity Entries"), STAT_AIRacing_NumProximityEntries, STATGROUP_AIRacing);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AI Obstacle Probes"), STAT_AIRacing_NumProbes, STATGROUP_AIRacing);
+
+static TAutoConsoleVariable<int32> CVarAIRacingRaceSeed(
+    TEXT("CarGame.AI.RaceSeed"),
+    0,
+    TEXT("Seed for every AI driver's mistakes and overtakes; the same seed replays the same race.\n")
+    TEXT("0 = pick one at random when the world starts (it is logged)."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarAIRacingBatched(
+    TEXT("CarGame.AI.Batched"),
+    1,
+    TEXT("1 = AI racing controllers are updated in one batched pass by UAIRacingSubsystem.\n")
+    TEXT("0 = every controller runs its own Tick (legacy path)."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarAIRacingParallel(
+    TEXT("CarGame.AI.Parallel"),
+    1,
+    TEXT("1 = run the batched AI compute stage as a ParallelFor.\n")
+    TEXT("0 = run it inline on the game thread."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarAIRacingParallelMinBatch(
+    TEXT("CarGame.AI.ParallelMinBatch"),
+    8,
+    TEXT("Minimum number of AI drivers before the compute stage goes wide."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarAIRacingUpdateLOD(
+    TEXT("CarGame.AI.UpdateLOD"),
+    1,
+    TEXT("1 = AI drivers far from every player and camera run their decision logic at a reduced rate.\n")
+    TEXT("0 = every driver decides every frame."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarAIRacingUpdateLODReducedDistance(
+    TEXT("CarGame.AI.UpdateLOD.ReducedDistance"),
+    80.0f,
+    TEXT("Distance (m) from every player car and camera beyond which a driver decides at ReducedRate."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarAIRacingUpdateLODDistantDistance(
+    TEXT("CarGame.AI.UpdateLOD.DistantDistance"),
+    200.0f,
+    TEXT("Distance (m) from every player car and camera beyond which a driver decides at DistantRate."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarAIRacingUpdateLODReducedRate(
+    TEXT("CarGame.AI.UpdateLOD.ReducedRate"),
+    30.0f,
+    TEXT("Decisions per second for drivers in the reduced tier."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarAIRacingUpdateLODDistantRate(
+    TEXT("CarGame.AI.UpdateLOD.DistantRate"),
+    15.0f,
+    TEXT("Decisions per second for drivers in the distant tier."),
+    ECVF_Default);
+
+namespace
+{
+    // A driver has to get this much further past a tier distance before it drops to the slower tier
+    constexpr float TierHysteresis = 1.1f;
+
+    // Same thresholds as AAIRacingController::SimulateMistake and ShouldAttemptOvertake
+    constexpr float MinMistakeDuration = 0.5f;
+    constexpr float MaxMistakeDuration = 2.0f;
+    constexpr float MaxMistakeOffset = 300.0f;
+    constexpr float OvertakeTriggerDistance = 20.0f;
+
+    /** Last physics step's transform, shared with every other consumer */
+    FTransform GetFrameTransform(const ARacingVehicle& Vehicle)
+    {
+        const FVehicleFrameState& FrameState = Vehicle.GetFrameState();
+        return FrameState.FrameNumber > 0 ? FrameState.Transform : Vehicle.GetActorTransform();
+    }
+}
+
+// ============================================================
+// SOA BATCH
+// ============================================================
+
+void FAIRacingBatch::AddSlot()
+{
+    Location.Add(FVector::ZeroVector);
+    Forward.Add(FVector::ForwardVector);
+    Right.Add(FVector::RightVector);
+    ForwardSpeed.Add(0.0f);
+
+    RacelineDistance.Add(0.0f);
+    LateralOffset.Add(0.0f);
+    GapToPlayer.Add(0.0f);
+    bHasGapToPlayer.Add(0);
+
+    ObstacleDistance.Add(MAX_FLT);
+    AheadLateral.Add(0.0f);
+    ProbeDistance.Add(MAX_FLT);
+
+    RacingLine.Add(nullptr);
+    Difficulty.AddZeroed();
+    MaxSpeedMultiplier.Add(1.0f);
+    BehaviorSpeed.Add(1.0f);
+    SteeringScale.Add(1.0f);
+    ResponseTime.Add(0.0f);
+    OvertakeAggression.Add(1.0f);
+    MistakeChance.Add(0.0f);
+    RubberBandingStrength.Add(0.0f);
+    SearchWindow.Add(0);
+    RecoveryDistance.Add(0.0f);
+
+    WaypointIndex.Add(0);
+    bWaypointTracked.Add(0);
+
+    Random.AddDefaulted();
+    MistakeTime.Add(0.0f);
+    MistakeOffset.Add(FVector::ZeroVector);
+    OvertakeTime.Add(0.0f);
+    OvertakeSide.Add(-1.0f);
+
+    Steering.Add(0.0f);
+    Throttle.Add(0.0f);
+    Brake.Add(0.0f);
+    TargetSpeed.Add(0.0f);
+    DistanceToWaypoint.Add(0.0f);
+    RacingState.Add(static_cast<uint8>(EAIRacingState::FollowingRaceline));
+
+    Tier.Add(EAIUpdateTier::Full);
+    DecisionElapsed.Add(MAX_FLT);
+    DecisionInterval.Add(0.0f);
+
+    SteeringFrom.Add(0.0f);
+    AppliedSteering.Add(0.0f);
+
+    bOnTrack.Add(0);
+    bIndexed.Add(0);
+    bActive.Add(0);
+    bDecide.Add(0);
+    ObstacleTrace.AddDefaulted();
+}
+
+void FAIRacingBatch::RemoveSlotSwap(int32 Index)
+{
+    Location.RemoveAtSwap(Index, 1, false);
+    Forward.RemoveAtSwap(Index, 1, false);
+    Right.RemoveAtSwap(Index, 1, false);
+    ForwardSpeed.RemoveAtSwap(Index, 1, false);
+
+    RacelineDistance.RemoveAtSwap(Index, 1, false);
+    LateralOffset.RemoveAtSwap(Index, 1, false);
+    GapToPlayer.RemoveAtSwap(Index, 1, false);
+    bHasGapToPlayer.RemoveAtSwap(Index, 1, false);
+
+    ObstacleDistance.RemoveAtSwap(Index, 1, false);
+    AheadLateral.RemoveAtSwap(Index, 1, false);
+    ProbeDistance.RemoveAtSwap(Index, 1, false);
+
+    RacingLine.RemoveAtSwap(Index, 1, false);
+    Difficulty.RemoveAtSwap(Index, 1, false);
+    MaxSpeedMultiplier.RemoveAtSwap(Index, 1, false);
+    BehaviorSpeed.RemoveAtSwap(Index, 1, false);
+    SteeringScale.RemoveAtSwap(Index, 1, false);
+    ResponseTime.RemoveAtSwap(Index, 1, false);
+    OvertakeAggression.RemoveAtSwap(Index, 1, false);
+    MistakeChance.RemoveAtSwap(Index, 1, false);
+    RubberBandingStrength.RemoveAtSwap(Index, 1, false);
+    SearchWindow.RemoveAtSwap(Index, 1, false);
+    RecoveryDistance.RemoveAtSwap(Index, 1, false);
+
+    WaypointIndex.RemoveAtSwap(Index, 1, false);
+    bWaypointTracked.RemoveAtSwap(Index, 1, false);
+
+    Random.RemoveAtSwap(Index, 1, false);
+    MistakeTime.RemoveAtSwap(Index, 1, false);
+    MistakeOffset.RemoveAtSwap(Index, 1, false);
+    OvertakeTime.RemoveAtSwap(Index, 1, false);
+    OvertakeSide.RemoveAtSwap(Index, 1, false);
+
+    Steering.RemoveAtSwap(Index, 1, false);
+    Throttle.RemoveAtSwap(Index, 1, false);
+    Brake.RemoveAtSwap(Index, 1, false);
+    TargetSpeed.RemoveAtSwap(Index, 1, false);
+    DistanceToWaypoint.RemoveAtSwap(Index, 1, false);
+    RacingState.RemoveAtSwap(Index, 1, false);
+
+    Tier.RemoveAtSwap(Index, 1, false);
+    DecisionElapsed.RemoveAtSwap(Index, 1, false);
+    DecisionInterval.RemoveAtSwap(Index, 1, false);
+
+    SteeringFrom.RemoveAtSwap(Index, 1, false);
+    AppliedSteering.RemoveAtSwap(Index, 1, false);
+
+    bOnTrack.RemoveAtSwap(Index, 1, false);
+    bIndexed.RemoveAtSwap(Index, 1, false);
+    bActive.RemoveAtSwap(Index, 1, false);
+    bDecide.RemoveAtSwap(Index, 1, false);
+    ObstacleTrace.RemoveAtSwap(Index, 1, false);
+}
+
+void FAIRacingBatch::Reset()
+{
+    Location.Reset();
+    Forward.Reset();
+    Right.Reset();
+    ForwardSpeed.Reset();
+
+    RacelineDistance.Reset();
+    LateralOffset.Reset();
+    GapToPlayer.Reset();
+    bHasGapToPlayer.Reset();
+
+    ObstacleDistance.Reset();
+    AheadLateral.Reset();
+    ProbeDistance.Reset();
+
+    RacingLine.Reset();
+    Difficulty.Reset();
+    MaxSpeedMultiplier.Reset();
+    BehaviorSpeed.Reset();
+    SteeringScale.Reset();
+    ResponseTime.Reset();
+    OvertakeAggression.Reset();
+    MistakeChance.Reset();
+    RubberBandingStrength.Reset();
+    SearchWindow.Reset();
+    RecoveryDistance.Reset();
+
+    WaypointIndex.Reset();
+    bWaypointTracked.Reset();
+
+    Random.Reset();
+    MistakeTime.Reset();
+    MistakeOffset.Reset();
+    OvertakeTime.Reset();
+    OvertakeSide.Reset();
+
+    Steering.Reset();
+    Throttle.Reset();
+    Brake.Reset();
+    TargetSpeed.Reset();
+    DistanceToWaypoint.Reset();
+    RacingState.Reset();
+
+    Tier.Reset();
+    DecisionElapsed.Reset();
+    DecisionInterval.Reset();
+
+    SteeringFrom.Reset();
+    AppliedSteering.Reset();
+
+    bOnTrack.Reset();
+    bIndexed.Reset();
+    bActive.Reset();
+    bDecide.Reset();
+    ObstacleTrace.Reset();
+}
+
+// ============================================================
+// TICK FUNCTION
+// ============================================================
+
+void FAIRacingTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+    if (Subsystem && TickType != LEVELTICK_ViewportsOnly)
+    {
+        Subsystem->UpdateControllers(DeltaTime);
+    }
+}
+
+FString FAIRacingTickFunction::DiagnosticMessage()
+{
+    return TEXT("FAIRacingTickFunction");
+}
+
+FName FAIRacingTickFunction::DiagnosticContext(bool bDetailed)
+{
+    return FName(TEXT("AIRacing"));
+}
+
+// ============================================================
+// SUBSYSTEM LIFECYCLE
+// ============================================================
+
+void UAIRacingSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    UpdateTickFunction.Subsystem = this;
+    UpdateTickFunction.bCanEverTick = true;
+    UpdateTickFunction.bStartWithTickEnabled = true;
+    UpdateTickFunction.bRunOnAnyThread = false;
+    UpdateTickFunction.TickGroup = TG_PrePhysics;
+
+    RaceSeed = CVarAIRacingRaceSeed.GetValueOnGameThread();
+    if (RaceSeed == 0)
+    {
+        RaceSeed = FMath::RandRange(1, MAX_int32);
+    }
+}
+
+void UAIRacingSubsystem::Deinitialize()
+{
+    if (UpdateTickFunction.IsTickFunctionRegistered())
+    {
+        UpdateTickFunction.UnRegisterTickFunction();
+    }
+    UpdateTickFunction.Subsystem = nullptr;
+
+    for (AAIRacingController* Controller : Controllers)
+    {
+        if (Controller)
+        {
+            Controller->BatchSlot = INDEX_NONE;
+        }
+    }
+
+    Controllers.Reset();
+    Batch.Reset();
+    ProximityIndex.Reset(0.0f);
+
+    Super::Deinitialize();
+}
+
+void UAIRacingSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    UpdateTickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+
+    // Decide before the vehicle pass reads this frame's inputs
+    if (UVehicleSimulationSubsystem* VehicleSimulation = InWorld.GetSubsystem<UVehicleSimulationSubsystem>())
+    {
+        VehicleSimulation->AddSimulationPrerequisite(this, UpdateTickFunction);
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("AI Racing Subsystem started (batched: %d, parallel: %d, race seed: %d)"),
+        CVarAIRacingBatched.GetValueOnGameThread(), CVarAIRacingParallel.GetValueOnGameThread(), RaceSeed);
+}
+
+bool UAIRacingSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UAIRacingSubsystem::IsBatchedUpdateEnabled()
+{
+    return CVarAIRacingBatched.GetValueOnGameThread() != 0;
+}
+
+void UAIRacingSubsystem::SetRaceSeed(int32 Seed)
+{
+    RaceSeed = Seed;
+
+    for (AAIRacingController* Controller : Controllers)
+    {
+        if (Controller)
+        {
+            Controller->SetRandomSeed(MakeControllerSeed(Controller));
+        }
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("AI race seed: %d"), RaceSeed);
+}
+
+int32 UAIRacingSubsystem::MakeControllerSeed(const AAIRacingController* Controller) const
+{
+    // Names, unlike registration order, do not depend on which actor happens to begin play first
+    return static_cast<int32>(HashCombine(GetTypeHash(RaceSeed), FCrc::StrCrc32(*Controller->GetName())));
+}
+
+bool UAIRacingSubsystem::GetVehicleAhead(const AAIRacingController* Controller, float& OutDistance) const
+{
+    if (!Controller || !Controllers.IsValidIndex(Controller->BatchSlot) || Controllers[Controller->BatchSlot] != Controller
+        || !Batch.bIndexed[Controller->BatchSlot])
+    {
+        return false;
+    }
+
+    OutDistance = Batch.ObstacleDistance[Controller->BatchSlot];
+    return true;
+}
+
+bool UAIRacingSubsystem::GetGapToPlayer(const AAIRacingController* Controller, float& OutGap) const
+{
+    if (!Controller || !Controllers.IsValidIndex(Controller->BatchSlot)
+        || Controllers[Controller->BatchSlot] != Controller || !Batch.bHasGapToPlayer[Controller->BatchSlot])
+    {
+        return false;
+    }
+
+    OutGap = Batch.GapToPlayer[Controller->BatchSlot];
+    return true;
+}
+
+int32 UAIRacingSubsystem::GetNumControllersInTier(uint8 Tier) const
+{
+    return Tier < static_cast<uint8>(EAIUpdateTier::Count) ? TierCounts[Tier] : 0;
+}
+
+// ============================================================
+// REGISTRY
+// ============================================================
+
+int32 UAIRacingSubsystem::RegisterController(AAIRacingController* Controller)
+{
+    if (!Controller)
+    {
+        return INDEX_NONE;
+    }
+
+    if (Controllers.IsValidIndex(Controller->BatchSlot) && Controllers[Controller->BatchSlot] == Controller)
+    {
+        return Controller->BatchSlot;
+    }
+
+    const int32 Slot = Controllers.Add(Controller);
+    Batch.AddSlot();
+    Controller->SetRandomSeed(MakeControllerSeed(Controller));
+
+    Controller->BatchSlot = Slot;
+    return Slot;
+}
+
+void UAIRacingSubsystem::UnregisterController(AAIRacingController* Controller)
+{
+    if (!Controller || !Controllers.IsValidIndex(Controller->BatchSlot) || Controllers[Controller->BatchSlot] != Controller)
+    {
+        return;
+    }
+
+    const int32 Slot = Controller->BatchSlot;
+    const int32 LastSlot = Controllers.Num() - 1;
+
+    Controllers.RemoveAtSwap(Slot, 1, false);
+    Batch.RemoveSlotSwap(Slot);
+
+    // The controller that used to live in the last slot now lives in the freed one
+    if (Slot != LastSlot && Controllers[Slot])
+    {
+        Controllers[Slot]->BatchSlot = Slot;
+    }
+
+    Controller->BatchSlot = INDEX_NONE;
+}
+
+// ============================================================
+// UPDATE
+// ============================================================
+
+void UAIRacingSubsystem::UpdateControllers(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_AIRacing_Total);
+    SET_DWORD_STAT(STAT_AIRacing_NumControllers, Controllers.Num());
+
+    if (Controllers.Num() == 0 || DeltaTime <= 0.0f)
+    {
+        return;
+    }
+
+    // Legacy controllers read the proximity index too
+    UpdateTracking();
+
+    if (!IsBatchedUpdateEnabled())
+    {
+        return;
+    }
+
+    UpdateSignificance(DeltaTime);
+    GatherBatch(DeltaTime);
+    ComputeBatch(DeltaTime);
+    ScatterBatch(DeltaTime);
+}
+
+void UAIRacingSubsystem::UpdateTracking()
+{
+    SCOPE_CYCLE_COUNTER(STAT_AIRacing_Tracking);
+
+    const int32 NumSlots = Controllers.Num();
+    for (int32 i = 0; i < NumSlots; i++)
+    {
+        const AAIRacingController* Controller = Controllers[i];
+        const ARacingVehicle* Vehicle = Controller ? Controller->ControlledVehicle : nullptr;
+
+        const bool bOnTrack = Vehicle && Controller->HasRaceline();
+        Batch.bOnTrack[i] = bOnTrack;
+
+        // Kinematic cars are moved along the line by the vehicle simulation's physics LOD
+        Batch.bActive[i] = bOnTrack && !Vehicle->IsKinematicLOD();
+        if (!bOnTrack)
+        {
+            continue;
+        }
+
+        const FTransform Transform = GetFrameTransform(*Vehicle);
+        Batch.Location[i] = Transform.GetLocation();
+        Batch.Forward[i] = Transform.GetUnitAxis(EAxis::X);
+        Batch.Right[i] = Transform.GetUnitAxis(EAxis::Y);
+        Batch.ForwardSpeed[i] = FVector::DotProduct(Vehicle->GetFrameState().Velocity, Batch.Forward[i]);
+
+        Batch.RacingLine[i] = Controller->GetRacingLine().Get();
+        Batch.Difficulty[i] = Controller->Difficulty;
+        Batch.SearchWindow[i] = Controller->WaypointSearchWindow;
+        Batch.RecoveryDistance[i] = Controller->WaypointRecoveryDistance * 100.0f;
+
+        // Copied in every frame so controller-side resets and LOD syncs are honored
+        Batch.WaypointIndex[i] = Controller->RacingData.CurrentWaypointIndex;
+        Batch.bWaypointTracked[i] = Controller->bWaypointTracked;
+    }
+
+    const bool bParallel = CVarAIRacingParallel.GetValueOnGameThread() != 0
+        && NumSlots >= CVarAIRacingParallelMinBatch.GetValueOnGameThread();
+
+    ParallelFor(NumSlots, [this](int32 i)
+    {
+        if (!Batch.bOnTrack[i])
+        {
+            return;
+        }
+
+        const FRacingLine& Line = *Batch.RacingLine[i];
+        const FVector& Location = Batch.Location[i];
+
+        // Windowed walk from last frame's waypoint; the grid takes over after respawns and off-track excursions
+        const int32 Hint = Batch.bWaypointTracked[i] ? Batch.WaypointIndex[i] : INDEX_NONE;
+        float DistanceSquared = MAX_FLT;
+        const int32 Closest = Line.GetSpatialIndex().FindNearestFrom(Location, Hint, Batch.SearchWindow[i], Batch.RecoveryDistance[i], DistanceSquared);
+        if (Closest != INDEX_NONE)
+        {
+            Batch.WaypointIndex[i] = Closest;
+            Batch.bWaypointTracked[i] = 1;
+        }
+        Batch.DistanceToWaypoint[i] = FMath::Sqrt(DistanceSquared);
+
+        Batch.RacelineDistance[i] = Line.ProjectNear(Location, Batch.WaypointIndex[i], &Batch.LateralOffset[i]);
+    }, !bParallel);
+
+    BuildProximityIndex();
+}
+
+void UAIRacingSubsystem::BuildProximityIndex()
+{
+    // Every controller normally follows the track's one shared line
+    const FRacingLine* Line = nullptr;
+    for (int32 i = 0; i < Controllers.Num() && !Line; i++)
+    {
+        Line = Batch.bOnTrack[i] ? Batch.RacingLine[i] : nullptr;
+    }
+
+    ProximityIndex.Reset(Line ? Line->GetLength() : 0.0f);
+
+    for (int32 i = 0; i < Controllers.Num(); i++)
+    {
+        Batch.bHasGapToPlayer[i] = 0;
+        Batch.bIndexed[i] = Batch.bOnTrack[i] && Batch.RacingLine[i] == Line;
+        if (Batch.bIndexed[i])
+        {
+            ProximityIndex.Add(Batch.RacelineDistance[i], Batch.LateralOffset[i], i);
+        }
+    }
+
+    if (!Line)
+    {
+        return;
+    }
+
+    // Player cars are few, so a grid lookup each frame is cheap enough
+    const int32 FirstPlayerId = Controllers.Num();
+    int32 PlayerId = FirstPlayerId;
+    const ARacingVehicle* FirstPlayer = nullptr;
+    for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+    {
+        const APlayerController* PlayerController = It->Get();
+        const ARacingVehicle* Vehicle = PlayerController ? Cast<ARacingVehicle>(PlayerController->GetPawn()) : nullptr;
+        if (!Vehicle)
+        {
+            continue;
+        }
+        if (!FirstPlayer)
+        {
+            FirstPlayer = Vehicle;
+        }
+
+        const FVector Location = GetFrameTransform(*Vehicle).GetLocation();
+        float DistanceSquared;
+        const int32 Nearest = Line->GetSpatialIndex().FindNearest(Location, DistanceSquared);
+        if (Nearest != INDEX_NONE)
+        {
+            float Lateral;
+            const float Distance = Line->ProjectNear(Location, Nearest, &Lateral);
+            ProximityIndex.Add(Distance, Lateral, PlayerId++);
+        }
+    }
+
+    ProximityIndex.Build();
+    SET_DWORD_STAT(STAT_AIRacing_NumProximityEntries, ProximityIndex.Num());
+
+    // Nearest car in each driver's path, reported like a bumper probe would
+    const TArray<FTrackProximityEntry>& Entries = ProximityIndex.GetEntries();
+    const URaceProgressSubsystem* RaceProgress = GetWorld()->GetSubsystem<URaceProgressSubsystem>();
+    float PlayerProgress;
+    const bool bPlayerTracked = RaceProgress && RaceProgress->GetProgress(FirstPlayer, PlayerProgress);
+    for (int32 i = 0; i < Controllers.Num(); i++)
+    {
+        if (!Batch.bIndexed[i])
+        {
+            continue;
+        }
+
+        float Gap;
+        const int32 Ahead = ProximityIndex.FindAhead(Batch.RacelineDistance[i], Batch.LateralOffset[i],
+            AIDriving::ObstacleProbeLength + AIDriving::VehicleLength, AIDriving::ObstacleLateralHalfWidth, i, Gap);
+        if (Ahead != INDEX_NONE)
+        {
+            Batch.ObstacleDistance[i] = FMath::Max(Gap - AIDriving::VehicleLength, 0.0f) * 0.01f; // cm to m
+            Batch.AheadLateral[i] = Entries[Ahead].Lateral;
+        }
+        else
+        {
+            Batch.ObstacleDistance[i] = MAX_FLT;
+        }
+
+        // Rubber-banding reads the race's own timing gap to the first player
+        float Progress;
+        const ARacingVehicle* Vehicle = Controllers[i]->ControlledVehicle;
+        if (bPlayerTracked && Vehicle && RaceProgress->GetProgress(Vehicle, Progress))
+        {
+            Batch.GapToPlayer[i] = Progress > PlayerProgress
+                ? RaceProgress->GetTimeGap(FirstPlayer, Vehicle)
+                : -RaceProgress->GetTimeGap(Vehicle, FirstPlayer);
+            Batch.bHasGapToPlayer[i] = 1;
+        }
+    }
+}
+
+void UAIRacingSubsystem::UpdateSignificance(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_AIRacing_Significance);
+
+    const bool bEnabled = CVarAIRacingUpdateLOD.GetValueOnGameThread() != 0;
+    const float ReducedDistanceSquared = FMath::Square(CVarAIRacingUpdateLODReducedDistance.GetValueOnGameThread() * 100.0f);
+    const float DistantDistanceSquared = FMath::Square(CVarAIRacingUpdateLODDistantDistance.GetValueOnGameThread() * 100.0f);
+    const float HysteresisSquared = FMath::Square(TierHysteresis);
+
+    const float Intervals[] =
+    {
+        0.0f,
+        1.0f / FMath::Max(CVarAIRacingUpdateLODReducedRate.GetValueOnGameThread(), 1.0f),
+        1.0f / FMath::Max(CVarAIRacingUpdateLODDistantRate.GetValueOnGameThread(), 1.0f)
+    };
+
+    // Everything a player can see or touch: their pawns and their cameras
+    TArray<FVector, TInlineAllocator<8>> Viewers;
+    for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+    {
+        const APlayerController* PlayerController = It->Get();
+        if (!PlayerController)
+        {
+            continue;
+        }
+        if (const APawn* Pawn = PlayerController->GetPawn())
+        {
+            Viewers.Add(Pawn->GetActorLocation());
+        }
+        if (PlayerController->PlayerCameraManager)
+        {
+            Viewers.Add(PlayerController->PlayerCameraManager->GetCameraLocation());
+        }
+    }
+
+    for (TArray<int32>& Slots : DecidingSlots)
+    {
+        Slots.Reset();
+    }
+    FMemory::Memzero(TierCounts);
+
+    int32 NumActive = 0;
+    for (int32 i = 0; i < Controllers.Num(); i++)
+    {
+        const AAIRacingController* Controller = Controllers[i];
+
+        Batch.bDecide[i] = 0;
+        if (!Batch.bActive[i])
+        {
+            // Decide as soon as the driver is back, starting from what it last applied
+            Batch.DecisionElapsed[i] = MAX_FLT;
+            Batch.AppliedSteering[i] = Controller ? Controller->RacingData.SteeringInput : 0.0f;
+            continue;
+        }
+        NumActive++;
+
+        const FVector& Location = Batch.Location[i];
+
+        EAIUpdateTier Tier = EAIUpdateTier::Full;
+        if (bEnabled && Batch.ObstacleDistance[i] >= AIDriving::ObstacleLiftDistance)
+        {
+            float ViewerDistanceSquared = MAX_FLT;
+            for (const FVector& Viewer : Viewers)
+            {
+                ViewerDistanceSquared = FMath::Min(ViewerDistanceSquared, FVector::DistSquared(Viewer, Location));
+            }
+
+            // Only slow a driver down once it is clearly past the tier distance
+            const EAIUpdateTier Previous = Batch.Tier[i];
+            const float DistantThreshold = DistantDistanceSquared * (Previous == EAIUpdateTier::Distant ? 1.0f : HysteresisSquared);
+            const float ReducedThreshold = ReducedDistanceSquared * (Previous >= EAIUpdateTier::Reduced ? 1.0f : HysteresisSquared);
+
+            if (ViewerDistanceSquared > DistantThreshold)
+            {
+                Tier = EAIUpdateTier::Distant;
+            }
+            else if (ViewerDistanceSquared > ReducedThreshold)
+            {
+                Tier = EAIUpdateTier::Reduced;
+            }
+        }
+
+        const float Interval = Intervals[static_cast<int32>(Tier)];
+        float& Elapsed = Batch.DecisionElapsed[i];
+
+        if (Tier != Batch.Tier[i] && Tier > Batch.Tier[i] && Elapsed != MAX_FLT)
+        {
+            // Spread drivers entering a slower tier across its interval so decisions do not bunch up
+            Elapsed = Interval * FMath::Frac(i * 0.618034f);
+        }
+
+        // Capped so a driver promoted to a faster tier, or just activated, decides straight away with a sane step
+        Elapsed = FMath::Min(Elapsed + DeltaTime, FMath::Max(Interval, DeltaTime));
+
+        Batch.Tier[i] = Tier;
+        Batch.DecisionInterval[i] = Interval;
+        TierCounts[static_cast<int32>(Tier)]++;
+
+        if (Elapsed >= Interval)
+        {
+            Batch.bDecide[i] = 1;
+            DecidingSlots[static_cast<int32>(Tier)].Add(i);
+        }
+    }
+
+    SET_DWORD_STAT(STAT_AIRacing_NumActive, NumActive);
+    SET_DWORD_STAT(STAT_AIRacing_NumFull, TierCounts[static_cast<int32>(EAIUpdateTier::Full)]);
+    SET_DWORD_STAT(STAT_AIRacing_NumReduced, TierCounts[static_cast<int32>(EAIUpdateTier::Reduced)]);
+    SET_DWORD_STAT(STAT_AIRacing_NumDistant, TierCounts[static_cast<int32>(EAIUpdateTier::Distant)]);
+}
+
+void UAIRacingSubsystem::GatherBatch(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_AIRacing_Gather);
+
+    UWorld* World = GetWorld();
+
+    for (int32 i = 0; i < Controllers.Num(); i++)
+    {
+        if (!Batch.bDecide[i])
+        {
+            continue;
+        }
+
+        const AAIRacingController* Controller = Controllers[i];
+
+        // Probe issued by last frame's scatter; without one the last reading stands
+        FTraceDatum Probe;
+        if (Batch.ObstacleTrace[i].IsValid() && World->QueryTraceData(Batch.ObstacleTrace[i], Probe))
+        {
+            const float HitDistance = Probe.OutHits.Num() > 0 ? Probe.OutHits[0].Distance * 0.01f : MAX_FLT; // cm to m
+
+            // Indexed drivers only probe to confirm; the others still see traffic through the probe alone
+            if (Batch.bIndexed[i])
+            {
+                Batch.ProbeDistance[i] = HitDistance;
+            }
+            else
+            {
+                Batch.ObstacleDistance[i] = HitDistance;
+            }
+        }
+
+        Batch.MaxSpeedMultiplier[i] = Controller->MaxSpeedMultiplier;
+        Batch.BehaviorSpeed[i] = Controller->GetBehaviorSpeedMultiplier();
+        Batch.SteeringScale[i] = Controller->SteeringSharpness * Batch.BehaviorSpeed[i];
+        Batch.ResponseTime[i] = Controller->GetBrakingResponseTime();
+        Batch.OvertakeAggression[i] = Controller->GetOvertakingAggression();
+        Batch.MistakeChance[i] = Controller->MistakeChance;
+        Batch.RubberBandingStrength[i] = Controller->bEnableRubberBanding ? Controller->RubberBandingStrength : 0.0f;
+        Batch.RacingState[i] = static_cast<uint8>(Controller->RacingData.CurrentState);
+        Batch.Random[i] = Controller->RandomStream;
+    }
+}
+
+void UAIRacingSubsystem::ComputeBatch(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_AIRacing_Compute);
+
+    int32 NumDecisions = 0;
+    for (const TArray<int32>& Slots : DecidingSlots)
+    {
+        NumDecisions += Slots.Num();
+    }
+    SET_DWORD_STAT(STAT_AIRacing_NumDecisions, NumDecisions);
+
+    const bool bParallel = CVarAIRacingParallel.GetValueOnGameThread() != 0
+        && NumDecisions >= CVarAIRacingParallelMinBatch.GetValueOnGameThread();
+
+    // One pass per tier so each tier's cost shows separately under stat AIRacing
+    {
+        SCOPE_CYCLE_COUNTER(STAT_AIRacing_ComputeFull);
+        ComputeTier(EAIUpdateTier::Full, bParallel);
+    }
+    {
+        SCOPE_CYCLE_COUNTER(STAT_AIRacing_ComputeReduced);
+        ComputeTier(EAIUpdateTier::Reduced, bParallel);
+    }
+    {
+        SCOPE_CYCLE_COUNTER(STAT_AIRacing_ComputeDistant);
+        ComputeTier(EAIUpdateTier::Distant, bParallel);
+    }
+}
+
+void UAIRacingSubsystem::ComputeTier(EAIUpdateTier Tier, bool bParallel)
+{
+    const TArray<int32>& Slots = DecidingSlots[static_cast<int32>(Tier)];
+
+    // Each decision covers the time since the driver's previous one
+    ParallelFor(Slots.Num(), [this, &Slots](int32 Index)
+    {
+        const int32 Slot = Slots[Index];
+        ComputeSlot(Slot, Batch.DecisionElapsed[Slot]);
+    }, !bParallel);
+}
+
+void UAIRacingSubsystem::ComputeSlot(int32 i, float DeltaTime)
+{
+    const FRacingLine& Line = *Batch.RacingLine[i];
+    const FVector& Location = Batch.Location[i];
+
+    // Mistakes
+    FRandomStream& Random = Batch.Random[i];
+    float& MistakeTime = Batch.MistakeTime[i];
+    if (MistakeTime <= 0.0f && Random.FRand() < Batch.MistakeChance[i] * DeltaTime)
+    {
+        MistakeTime = Random.FRandRange(MinMistakeDuration, MaxMistakeDuration);
+        Batch.MistakeOffset[i] = FVector(
+            Random.FRandRange(-MaxMistakeOffset, MaxMistakeOffset),
+            Random.FRandRange(-MaxMistakeOffset, MaxMistakeOffset),
+            0.0f);
+
+        UE_LOG(LogTemp, Warning, TEXT("AI made a mistake! Duration: %.2fs"), MistakeTime);
+    }
+    if (MistakeTime > 0.0f)
+    {
+        MistakeTime -= DeltaTime;
+        if (MistakeTime <= 0.0f)
+        {
+            Batch.MistakeOffset[i] = FVector::ZeroVector;
+        }
+    }
+
+    // Steering
+    float& OvertakeTime = Batch.OvertakeTime[i];
+    FVector TargetOffset = Batch.MistakeOffset[i];
+    if (OvertakeTime > 0.0f)
+    {
+        TargetOffset += Batch.Right[i] * (Batch.OvertakeSide[i] * AIDriving::OvertakeOffset * Batch.OvertakeAggression[i]);
+    }
+    Batch.Steering[i] = AIDriving::ComputeSteering(Line, Batch.WaypointIndex[i], Location, Batch.Forward[i],
+        Batch.ForwardSpeed[i], TargetOffset, Batch.SteeringScale[i]);
+
+    // Throttle/brake; the index alone only lifts, a full stop needs a probe hit as well
+    float ObstacleDistance = Batch.ObstacleDistance[i];
+    if (Batch.bIndexed[i] && ObstacleDistance < AIDriving::ObstacleBrakeDistance)
+    {
+        ObstacleDistance = FMath::Max(ObstacleDistance, FMath::Min(Batch.ProbeDistance[i], AIDriving::ObstacleBrakeDistance));
+    }
+    const bool bBraking = AIDriving::ComputeThrottleBrake(Line, Batch.Difficulty[i], Batch.RacelineDistance[i], Batch.ForwardSpeed[i],
+        Batch.MaxSpeedMultiplier[i] * Batch.BehaviorSpeed[i], Batch.ResponseTime[i], ObstacleDistance,
+        Batch.Throttle[i], Batch.Brake[i], Batch.TargetSpeed[i]);
+    // Recovering lasts as long as the mistake, as in AAIRacingController::CalculateThrottleBrake
+    EAIRacingState RacingState = MistakeTime > 0.0f ? EAIRacingState::Recovering
+        : bBraking ? EAIRacingState::Braking : EAIRacingState::FollowingRaceline;
+
+    // Rubber-banding
+    if (Batch.bHasGapToPlayer[i] && Batch.RubberBandingStrength[i] > 0.0f)
+    {
+        Batch.MaxSpeedMultiplier[i] = AIDriving::ComputeRubberBanding(Batch.MaxSpeedMultiplier[i],
+            Batch.GapToPlayer[i], Batch.RubberBandingStrength[i], DeltaTime);
+    }
+
+    // Overtaking
+    if (OvertakeTime <= 0.0f && MistakeTime <= 0.0f
+        && Batch.ObstacleDistance[i] < OvertakeTriggerDistance * Batch.OvertakeAggression[i])
+    {
+        const float Side = ChooseOvertakeSide(i);
+        if (Side != 0.0f)
+        {
+            OvertakeTime = AIDriving::OvertakeDuration;
+            Batch.OvertakeSide[i] = Side;
+            RacingState = EAIRacingState::Overtaking;
+        }
+    }
+    if (OvertakeTime > 0.0f)
+    {
+        OvertakeTime -= DeltaTime;
+        if (OvertakeTime <= 0.0f)
+        {
+            RacingState = EAIRacingState::FollowingRaceline;
+        }
+    }
+
+    Batch.RacingState[i] = static_cast<uint8>(RacingState);
+}
+
+float UAIRacingSubsystem::ChooseOvertakeSide(int32 i) const
+{
+    if (!Batch.bIndexed[i])
+    {
+        // No view of the traffic: alternate sides
+        return -Batch.OvertakeSide[i];
+    }
+
+    // Pass on the side away from the car ahead
+    const float Lateral = Batch.LateralOffset[i];
+    const float Preferred = Batch.AheadLateral[i] > Lateral ? -1.0f : 1.0f;
+
+    // The lane beside the car ahead, from just behind this car to past the car ahead
+    const float Offset = AIDriving::OvertakeOffset * Batch.OvertakeAggression[i];
+    const float Behind = AIDriving::VehicleLength;
+    const float Ahead = Batch.ObstacleDistance[i] * 100.0f + AIDriving::VehicleLength * 2.0f;
+
+    for (const float Side : { Preferred, -Preferred })
+    {
+        const float Inner = Lateral + Side * AIDriving::ObstacleLateralHalfWidth;
+        const float Outer = Lateral + Side * (Offset + AIDriving::ObstacleLateralHalfWidth);
+        if (ProximityIndex.FindInWindow(Batch.RacelineDistance[i], Behind, Ahead,
+            FMath::Min(Inner, Outer), FMath::Max(Inner, Outer), i) == INDEX_NONE)
+        {
+            return Side;
+        }
+    }
+
+    // Boxed in: stay behind
+    return 0.0f;
+}
+
+void UAIRacingSubsystem::ScatterBatch(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_AIRacing_Scatter);
+
+    UWorld* World = GetWorld();
+    int32 NumProbes = 0;
+
+    for (int32 i = 0; i < Controllers.Num(); i++)
+    {
+        AAIRacingController* Controller = Controllers[i];
+        if (!Batch.bActive[i])
+        {
+            continue;
+        }
+
+        if (Batch.bDecide[i])
+        {
+            FAIRacingData& RacingData = Controller->RacingData;
+            RacingData.ThrottleInput = Batch.Throttle[i];
+            RacingData.BrakeInput = Batch.Brake[i];
+            RacingData.TargetSpeed = Batch.TargetSpeed[i] * 0.036f; // cm/s to km/h
+            RacingData.CurrentState = static_cast<EAIRacingState>(Batch.RacingState[i]);
+            RacingData.bIsOvertaking = Batch.OvertakeTime[i] > 0.0f;
+
+            Controller->MaxSpeedMultiplier = Batch.MaxSpeedMultiplier[i];
+            Controller->RandomStream = Batch.Random[i];
+
+            Batch.SteeringFrom[i] = Batch.AppliedSteering[i];
+            Batch.DecisionElapsed[i] = 0.0f;
+        }
+
+        // Tracked every frame, whether or not the driver decided
+        Controller->RacingData.CurrentWaypointIndex = Batch.WaypointIndex[i];
+        Controller->RacingData.DistanceToNextWaypoint = Batch.DistanceToWaypoint[i];
+        Controller->bWaypointTracked = Batch.bWaypointTracked[i] != 0;
+
+        // Ramp towards the latest decision, arriving as the next one is due
+        const float Interval = Batch.DecisionInterval[i];
+        const float Alpha = Interval > 0.0f ? FMath::Min((Batch.DecisionElapsed[i] + DeltaTime) / Interval, 1.0f) : 1.0f;
+        Batch.AppliedSteering[i] = FMath::Lerp(Batch.SteeringFrom[i], Batch.Steering[i], Alpha);
+        Controller->RacingData.SteeringInput = Batch.AppliedSteering[i];
+
+        Controller->ApplyInputsToVehicle();
+
+        // Probe ahead when a decision is due next frame and the index has a car close enough to matter;
+        // the trace runs alongside the rest of the frame
+        if (Batch.DecisionElapsed[i] + DeltaTime >= Interval)
+        {
+            if (!Batch.bIndexed[i] || Batch.ObstacleDistance[i] < AIDriving::ObstacleLiftDistance)
+            {
+                FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(AIRacingObstacleProbe), false, Controller->ControlledVehicle);
+                const FVector Start = Batch.Location[i];
+                Batch.ObstacleTrace[i] = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Start,
+                    Start + Batch.Forward[i] * AIDriving::ObstacleProbeLength, ECC_Vehicle, QueryParams);
+                NumProbes++;
+            }
+            else
+            {
+                Batch.ObstacleTrace[i].Invalidate();
+                Batch.ProbeDistance[i] = MAX_FLT;
+            }
+        }
+
+        if (Controller->bShowDebugInfo)
+        {
+            Controller->DrawDebugRaceline();
+        }
+    }
+
+    SET_DWORD_STAT(STAT_AIRacing_NumProbes, NumProbes);
+}
@@ -0,0 +1,274 @@
+// AIRacingSubsystem.h
+// Batched decision update of every AI racing controller in a world
+// Copyright 2025. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+#include "WorldCollision.h"
+#include "TrackProximityIndex.h"
+#include "AIRacingSubsystem.generated.h"
+
+class AAIRacingController;
+class FRacingLine;
+class UAIRacingSubsystem;
+enum class EAIDifficulty : uint8;
+
+DECLARE_STATS_GROUP(TEXT("AIRacing"), STATGROUP_AIRacing, STATCAT_Advanced);
+
+/**
+ * How often a driver re-runs its decision logic, from its significance to the players
+ */
+enum class EAIUpdateTier : uint8
+{
+    Full,       // every frame
+    Reduced,    // CarGame.AI.UpdateLOD.ReducedRate
+    Distant,    // CarGame.AI.UpdateLOD.DistantRate
+    Count
+};
+
+/**
+ * Structure-of-arrays batch of every registered AI driver.
+ * Index N in every array belongs to the same controller slot.
+ */
+struct FAIRacingBatch
+{
+    // Vehicle state gathered from the last published frame state
+    TArray<FVector> Location;
+    TArray<FVector> Forward;
+    TArray<FVector> Right;
+    TArray<float> ForwardSpeed;         // cm/s
+
+    // Position on the racing line, refreshed every frame for the proximity index
+    TArray<float> RacelineDistance;     // cm
+    TArray<float> LateralOffset;        // cm, positive to the right
+    TArray<float> GapToPlayer;          // s, positive when ahead of the first player; from URaceProgressSubsystem
+    TArray<uint8> bHasGapToPlayer;      // both cars are tracked by URaceProgressSubsystem
+
+    // Nearest car ahead from the proximity index, confirmed by ProbeDistance before a full stop
+    TArray<float> ObstacleDistance;     // m, MAX_FLT when nothing is ahead
+    TArray<float> AheadLateral;         // cm, lateral offset of that car
+    TArray<float> ProbeDistance;        // m, last confirmation probe, MAX_FLT on a miss
+
+    // Driver settings gathered from the controller (it may be edited at runtime)
+    TArray<const FRacingLine*> RacingLine;  // kept alive by the controller
+    TArray<EAIDifficulty> Difficulty;
+    TArray<float> MaxSpeedMultiplier;       // in/out, rubber-banding adjusts it
+    TArray<float> BehaviorSpeed;
+    TArray<float> SteeringScale;
+    TArray<float> ResponseTime;
+    TArray<float> OvertakeAggression;
+    TArray<float> MistakeChance;
+    TArray<float> RubberBandingStrength;    // 0 when disabled
+    TArray<int32> SearchWindow;
+    TArray<float> RecoveryDistance;         // cm
+
+    // Waypoint tracking, copied in and out so controller-side resets and LOD syncs are honored
+    TArray<int32> WaypointIndex;
+    TArray<uint8> bWaypointTracked;
+
+    // Decision state owned by the batch while the controller is registered
+    TArray<FRandomStream> Random;       // copied in and out of the controller's stream so both paths draw the same sequence
+    TArray<float> MistakeTime;
+    TArray<FVector> MistakeOffset;
+    TArray<float> OvertakeTime;
+    TArray<float> OvertakeSide;
+
+    // Outputs
+    TArray<float> Steering;
+    TArray<float> Throttle;
+    TArray<float> Brake;
+    TArray<float> TargetSpeed;          // cm/s
+    TArray<float> DistanceToWaypoint;   // cm
+    TArray<uint8> RacingState;          // EAIRacingState
+
+    // Update-rate LOD: seconds since the last decision and between decisions
+    TArray<EAIUpdateTier> Tier;
+    TArray<float> DecisionElapsed;
+    TArray<float> DecisionInterval;
+
+    // Between decisions the applied steering ramps from SteeringFrom to Steering
+    TArray<float> SteeringFrom;
+    TArray<float> AppliedSteering;
+
+    // 1 = has a vehicle and a line, so it is tracked (kinematic cars included)
+    TArray<uint8> bOnTrack;
+
+    // 1 = in the proximity index; 0 = on another line, obstacles come from probes alone
+    TArray<uint8> bIndexed;
+
+    // 0 = skipped this frame (no vehicle, no line or kinematic LOD)
+    TArray<uint8> bActive;
+
+    // 1 = decision logic runs this frame
+    TArray<uint8> bDecide;
+
+    // Obstacle probes issued in Scatter, read back in the next Gather
+    TArray<FTraceHandle> ObstacleTrace;
+
+    int32 Num() const { return Location.Num(); }
+    void AddSlot();
+    void RemoveSlotSwap(int32 Index);
+    void Reset();
+};
+
+/**
+ * Pre-physics tick function that drives the batched AI update
+ */
+USTRUCT()
+struct FAIRacingTickFunction : public FTickFunction
+{
+    GENERATED_BODY()
+
+    UAIRacingSubsystem* Subsystem = nullptr;
+
+    virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+    virtual FString DiagnosticMessage() override;
+    virtual FName DiagnosticContext(bool bDetailed) override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FAIRacingTickFunction> : public TStructOpsTypeTraitsBase2<FAIRacingTickFunction>
+{
+    enum { WithCopy = false };
+};
+
+/**
+ * Runs the per-frame decision logic of every AAIRacingController in one pass,
+ * before UVehicleSimulationSubsystem reads the inputs it produces.
+ *
+ * - Tracking: waypoint and racing-line position of every car (ParallelFor), then the
+ *   FTrackProximityIndex of AI and player cars and each driver's nearest car ahead
+ * - Gather: vehicle frame state, driver settings and last frame's obstacle probes into the batch (game thread)
+ * - Compute: mistakes, steering, throttle/brake, rubber-banding and overtaking for
+ *   every driver (ParallelFor, see AIDrivingKernel.h)
+ * - Scatter: results back to each controller's RacingData, ApplyInputsToVehicle,
+ *   and async confirmation probes for the next frame (game thread)
+ *
+ * Cars ahead and alongside come from the proximity index. A physics probe is only cast
+ * for a driver with a car inside ObstacleLiftDistance, and only a probe hit makes it brake
+ * fully. Probes are async line traces, so that confirmation arrives one frame late.
+ * Tracking runs even with batching off, so legacy controllers share the index too.
+ *
+ * Tracking also unwraps each car's line distance into race progress, and publishes every
+ * driver's gap to the player in seconds at its difficulty's lap pace. Rubber-banding reads
+ * that gap, so it ignores hairpins between the cars and feels the same on any track length.
+ *
+ * Update-rate LOD: drivers far from every player pawn and camera decide less often
+ * (EAIUpdateTier). Decisions are staggered across frames, and steering is ramped
+ * towards each new decision so distant cars still drive smoothly. Cars in traffic
+ * always decide every frame.
+ *
+ * Every driver draws mistakes from its own FRandomStream, seeded from the race seed
+ * and the controller's name, so a race does not depend on any other random calls.
+ *
+ * Console variables:
+ * - CarGame.AI.RaceSeed (0 = pick a race seed at random)
+ * - CarGame.AI.Batched  (1 = registered controllers skip their own update)
+ * - CarGame.AI.Parallel (1 = compute stage runs as a ParallelFor)
+ * - CarGame.AI.UpdateLOD and CarGame.AI.UpdateLOD.* (distances and rates)
+ */
+UCLASS()
+class CARGAME_API UAIRacingSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // USubsystem
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    // UWorldSubsystem
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+    /** True when registered controllers should leave their update to this subsystem */
+    static bool IsBatchedUpdateEnabled();
+
+    // ============================================================
+    // RANDOMNESS
+    // ============================================================
+
+    /**
+     * Seed every driver's random stream derives from, reseeding registered controllers.
+     * The same seed and inputs replay the same race.
+     */
+    void SetRaceSeed(int32 Seed);
+
+    int32 GetRaceSeed() const { return RaceSeed; }
+
+    // ============================================================
+    // REGISTRY
+    // ============================================================
+
+    /** Add a controller to the batch. Returns its slot index. */
+    int32 RegisterController(AAIRacingController* Controller);
+
+    /** Remove a controller. The last slot is swapped into the freed one. */
+    void UnregisterController(AAIRacingController* Controller);
+
+    int32 GetNumControllers() const { return Controllers.Num(); }
+
+    const FAIRacingBatch& GetBatch() const { return Batch; }
+
+    /** Every tracked car on the racing line, as of the last update */
+    const FTrackProximityIndex& GetProximityIndex() const { return ProximityIndex; }
+
+    /**
+     * Distance (m) to the nearest car ahead of Controller from the proximity index,
+     * MAX_FLT when the lane is clear. False when the controller is not in the index.
+     */
+    bool GetVehicleAhead(const AAIRacingController* Controller, float& OutDistance) const;
+
+    /**
+     * URaceProgressSubsystem's time gap (s) from the first player to Controller, positive
+     * when the controller is ahead. False when there is no player or either car is not tracked.
+     */
+    bool GetGapToPlayer(const AAIRacingController* Controller, float& OutGap) const;
+
+    /** Active drivers in an update tier as of the last update */
+    UFUNCTION(BlueprintCallable, Category = "AI Racing")
+    int32 GetNumControllersInTier(uint8 Tier) const;
+
+    // ============================================================
+    // UPDATE
+    // ============================================================
+
+    /** Run one batched decision update of every registered controller */
+    void UpdateControllers(float DeltaTime);
+
+private:
+    UPROPERTY(Transient)
+    TArray<AAIRacingController*> Controllers;
+
+    FAIRacingBatch Batch;
+
+    FAIRacingTickFunction UpdateTickFunction;
+
+    int32 RaceSeed = 0;
+
+    /** Seed for Controller's stream: stable across runs for the same race seed and controller name */
+    int32 MakeControllerSeed(const AAIRacingController* Controller) const;
+
+    // Cars on the shared racing line: AI slots by slot index, player cars after them
+    FTrackProximityIndex ProximityIndex;
+
+    // Slots deciding this frame, per tier
+    TArray<int32> DecidingSlots[static_cast<int32>(EAIUpdateTier::Count)];
+    int32 TierCounts[static_cast<int32>(EAIUpdateTier::Count)] = {};
+
+    void UpdateTracking();
+    void BuildProximityIndex();
+    void UpdateSignificance(float DeltaTime);
+    void GatherBatch(float DeltaTime);
+    void ComputeBatch(float DeltaTime);
+    void ComputeTier(EAIUpdateTier Tier, bool bParallel);
+    void ScatterBatch(float DeltaTime);
+
+    void ComputeSlot(int32 Index, float DeltaTime);
+
+    /** Overtake side (-1 left, 1 right) away from the car ahead and into a free lane; 0 when both are taken */
+    float ChooseOvertakeSide(int32 Index) const;
+};
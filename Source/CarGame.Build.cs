@@ -17,6 +17,7 @@ public class CarGame : ModuleRules
 			"Engine", 
 			"InputCore",
 			"PhysicsCore",
+			"Chaos",
 			"ChaosVehicles",
 			"Niagara",
 			"AudioMixer"
@@ -4,6 +4,7 @@
 
 #include "CarGame.h"
 #include "Modules/ModuleManager.h"
+#include "TelemetryRecorder.h"
 
 IMPLEMENT_PRIMARY_GAME_MODULE( FCarGameModule, CarGame, "CarGame" );
 
@@ -16,5 +17,6 @@ void FCarGameModule::StartupModule()
 void FCarGameModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module
+	FTelemetryWriter::Shutdown();
 	UE_LOG(LogTemp, Log, TEXT("CarGame Module Shutdown"));
 }
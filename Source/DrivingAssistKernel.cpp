@@ -0,0 +1,178 @@
+// DrivingAssistKernel.cpp
+// Vectorised per-wheel assist controller
+// Copyright 2025. All Rights Reserved.
+
+#include "DrivingAssistKernel.h"
+#include "Math/VectorRegister.h"
+
+FWheelAssistBatch::FWheelAssistBatch()
+{
+    for (int32 Wheel = 0; Wheel < EVehicleWheel::Count; Wheel++)
+    {
+        WheelSpeed[Wheel] = 0.0f;
+        GroundSpeed[Wheel] = 0.0f;
+        SlipAngle[Wheel] = 0.0f;
+        DriveMask[Wheel] = 0.0f;
+
+        SlipRatio[Wheel] = 0.0f;
+        BrakeScale[Wheel] = 1.0f;
+        DriveScale[Wheel] = 1.0f;
+        StabilityBrakeTorque[Wheel] = 0.0f;
+    }
+}
+
+FDrivingAssistCounters::FDrivingAssistCounters()
+{
+    Reset();
+}
+
+void FDrivingAssistCounters::Accumulate(const FWheelAssistBatch& Batch)
+{
+    for (int32 Wheel = 0; Wheel < EVehicleWheel::Count; Wheel++)
+    {
+        const uint8 Bit = 1 << Wheel;
+        if (Batch.ABSMask & Bit) ABS[Wheel].fetch_add(1, std::memory_order_relaxed);
+        if (Batch.TractionMask & Bit) Traction[Wheel].fetch_add(1, std::memory_order_relaxed);
+        if (Batch.StabilityMask & Bit) Stability[Wheel].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint8 Active = EVehicleAssistFlags::None;
+    if (Batch.ABSMask) Active |= EVehicleAssistFlags::ABS;
+    if (Batch.TractionMask) Active |= EVehicleAssistFlags::TractionControl;
+    if (Batch.StabilityMask) Active |= EVehicleAssistFlags::StabilityControl;
+    LastActiveAssists.store(Active, std::memory_order_relaxed);
+}
+
+void FDrivingAssistCounters::Reset()
+{
+    for (int32 Wheel = 0; Wheel < EVehicleWheel::Count; Wheel++)
+    {
+        ABS[Wheel].store(0, std::memory_order_relaxed);
+        Traction[Wheel].store(0, std::memory_order_relaxed);
+        Stability[Wheel].store(0, std::memory_order_relaxed);
+    }
+    LastActiveAssists.store(EVehicleAssistFlags::None, std::memory_order_relaxed);
+}
+
+// ============================================================
+// KERNEL
+// ============================================================
+
+namespace
+{
+    /** Stability control is a single corrective wheel per vehicle, so it stays scalar */
+    void EvaluateStabilityControl(const FDrivingAssistParams& Params, FWheelAssistBatch& Batch)
+    {
+        Batch.StabilityMask = 0;
+        for (int32 Wheel = 0; Wheel < EVehicleWheel::Count; Wheel++)
+        {
+            Batch.StabilityBrakeTorque[Wheel] = 0.0f;
+        }
+
+        const float Speed = Batch.ForwardSpeed;
+        if (!Params.bStabilityControlEnabled || Speed < Params.MinGroundSpeed)
+        {
+            return;
+        }
+
+        // Steady-state yaw rate from the bicycle model: r = V * delta / (L + K * V^2)
+        const float TargetYawRate = Speed * Batch.SteeringAngle / (Params.Wheelbase + Params.UnderSteerGradient * Speed * Speed);
+        const float YawError = Batch.YawRate - TargetYawRate;
+        const float AbsError = FMath::Abs(YawError);
+
+        if (AbsError <= Params.YawRateTolerance)
+        {
+            return;
+        }
+
+        const float Strength = FMath::Min((AbsError - Params.YawRateTolerance) / Params.YawRateTolerance, 1.0f);
+        const bool bTurningRight = (FMath::Abs(TargetYawRate) > KINDA_SMALL_NUMBER) ? (TargetYawRate > 0.0f) : (Batch.YawRate > 0.0f);
+        const bool bOversteer = FMath::Abs(Batch.YawRate) > FMath::Abs(TargetYawRate);
+
+        // Oversteer: brake the outside front. Understeer: brake the inside rear.
+        int32 Wheel;
+        if (bOversteer)
+        {
+            Wheel = bTurningRight ? EVehicleWheel::FrontLeft : EVehicleWheel::FrontRight;
+        }
+        else
+        {
+            Wheel = bTurningRight ? EVehicleWheel::RearRight : EVehicleWheel::RearLeft;
+        }
+
+        Batch.StabilityBrakeTorque[Wheel] = Params.StabilityBrakeTorque * Strength;
+        Batch.StabilityMask = 1 << Wheel;
+    }
+
+    FORCEINLINE void EvaluateWheels(const FDrivingAssistParams& Params, FWheelAssistBatch& Batch)
+    {
+        const VectorRegister4Float One = VectorOneFloat();
+        const VectorRegister4Float Zero = VectorZeroFloat();
+        const VectorRegister4Float MinGround = VectorSetFloat1(Params.MinGroundSpeed);
+
+        const VectorRegister4Float WheelSpeed = VectorLoadAligned(Batch.WheelSpeed);
+        const VectorRegister4Float GroundSpeed = VectorLoadAligned(Batch.GroundSpeed);
+        const VectorRegister4Float AbsGround = VectorAbs(GroundSpeed);
+
+        // Longitudinal slip ratio: (wheel - ground) / |ground|
+        const VectorRegister4Float Slip = VectorDivide(VectorSubtract(WheelSpeed, GroundSpeed), VectorMax(AbsGround, MinGround));
+        VectorStoreAligned(Slip, Batch.SlipRatio);
+
+        // ABS: the wheel is locking once wheel speed < ABSThreshold * ground speed
+        VectorRegister4Float BrakeScale = One;
+        Batch.ABSMask = 0;
+        if (Params.bABSEnabled && Batch.Brake > 0.0f)
+        {
+            const VectorRegister4Float Limit = VectorSetFloat1(Params.ABSThreshold - 1.0f);
+            const VectorRegister4Float Excess = VectorSubtract(Limit, Slip);
+            const VectorRegister4Float Mask = VectorBitwiseAnd(VectorCompareGT(Excess, Zero), VectorCompareGT(AbsGround, MinGround));
+
+            const VectorRegister4Float Scaled = VectorMax(
+                VectorSubtract(One, VectorMultiply(Excess, VectorSetFloat1(Params.ABSGain))),
+                VectorSetFloat1(Params.MinBrakeScale));
+
+            BrakeScale = VectorSelect(Mask, Scaled, One);
+            Batch.ABSMask = static_cast<uint8>(VectorMaskBits(Mask));
+        }
+        VectorStoreAligned(BrakeScale, Batch.BrakeScale);
+
+        // Traction control: the driven wheel is spinning once ground speed < TCThreshold * wheel speed
+        VectorRegister4Float DriveScale = One;
+        Batch.TractionMask = 0;
+        if (Params.bTractionControlEnabled && Batch.Throttle > 0.0f)
+        {
+            const float SlipLimit = 1.0f / FMath::Max(Params.TractionControlThreshold, KINDA_SMALL_NUMBER) - 1.0f;
+            const VectorRegister4Float Excess = VectorSubtract(Slip, VectorSetFloat1(SlipLimit));
+            const VectorRegister4Float Driven = VectorCompareGT(VectorLoadAligned(Batch.DriveMask), Zero);
+            const VectorRegister4Float Mask = VectorBitwiseAnd(VectorCompareGT(Excess, Zero), Driven);
+
+            const VectorRegister4Float Scaled = VectorMax(
+                VectorSubtract(One, VectorMultiply(Excess, VectorSetFloat1(Params.TractionControlGain))),
+                VectorSetFloat1(Params.MinDriveScale));
+
+            DriveScale = VectorSelect(Mask, Scaled, One);
+            Batch.TractionMask = static_cast<uint8>(VectorMaskBits(Mask));
+        }
+        VectorStoreAligned(DriveScale, Batch.DriveScale);
+
+        EvaluateStabilityControl(Params, Batch);
+    }
+}
+
+void RunDrivingAssists(const FDrivingAssistParams& Params, TArrayView<FWheelAssistBatch> Batches)
+{
+    for (FWheelAssistBatch& Batch : Batches)
+    {
+        EvaluateWheels(Params, Batch);
+    }
+}
+
+void RunDrivingAssists(TArrayView<const FDrivingAssistParams> Params, TArrayView<FWheelAssistBatch> Batches)
+{
+    check(Params.Num() == Batches.Num());
+
+    for (int32 i = 0; i < Batches.Num(); i++)
+    {
+        EvaluateWheels(Params[i], Batches[i]);
+    }
+}
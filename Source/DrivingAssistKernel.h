@@ -0,0 +1,141 @@
+// DrivingAssistKernel.h
+// Per-wheel ABS, traction control and stability control
+// Copyright 2025. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/** Wheel order used by every per-wheel array in the assist kernel */
+namespace EVehicleWheel
+{
+    enum Type : int32
+    {
+        FrontLeft   = 0,
+        FrontRight  = 1,
+        RearLeft    = 2,
+        RearRight   = 3,
+        Count       = 4
+    };
+}
+
+/** Bit flags for which assists are enabled / intervening on a vehicle */
+namespace EVehicleAssistFlags
+{
+    enum Type : uint8
+    {
+        None                = 0,
+        ABS                 = 1 << 0,
+        TractionControl     = 1 << 1,
+        StabilityControl    = 1 << 2
+    };
+}
+
+/**
+ * Controller settings shared by all wheels of a vehicle
+ */
+struct FDrivingAssistParams
+{
+    bool bABSEnabled = true;
+    bool bTractionControlEnabled = true;
+    bool bStabilityControlEnabled = true;
+
+    /** ABS releases brake once wheel speed drops below this fraction of ground speed */
+    float ABSThreshold = 0.95f;
+
+    /** TC cuts drive once ground speed drops below this fraction of wheel speed */
+    float TractionControlThreshold = 0.9f;
+
+    /** How hard brake/drive torque is cut per unit of excess slip */
+    float ABSGain = 4.0f;
+    float TractionControlGain = 3.0f;
+
+    /** Never cut brake/drive torque below these fractions */
+    float MinBrakeScale = 0.2f;
+    float MinDriveScale = 0.0f;
+
+    /** Stability control: allowed yaw rate error (rad/s) and corrective brake torque (Nm) */
+    float YawRateTolerance = 0.15f;
+    float StabilityBrakeTorque = 1500.0f;
+
+    /** Bicycle model used for the target yaw rate */
+    float Wheelbase = 2.6f;             // m
+    float UnderSteerGradient = 0.0025f; // rad per (m/s^2)
+
+    /** Wheels slower than this (m/s) are ignored to avoid noisy slip at standstill */
+    float MinGroundSpeed = 1.0f;
+};
+
+/**
+ * One vehicle's four wheels laid out as SIMD lanes.
+ * Inputs are filled by the caller, outputs written by RunDrivingAssists.
+ * Every per-wheel array is loaded and stored as one aligned register, so all of
+ * them come first and the per-vehicle scalars follow.
+ */
+struct alignas(16) FWheelAssistBatch
+{
+    // Inputs (per wheel, SI units)
+    float WheelSpeed[EVehicleWheel::Count];     // angular velocity * radius (m/s)
+    float GroundSpeed[EVehicleWheel::Count];    // contact patch longitudinal speed (m/s)
+    float SlipAngle[EVehicleWheel::Count];      // rad
+    float DriveMask[EVehicleWheel::Count];      // 1 = driven wheel, 0 = free
+
+    // Outputs (per wheel)
+    float SlipRatio[EVehicleWheel::Count];
+    float BrakeScale[EVehicleWheel::Count];
+    float DriveScale[EVehicleWheel::Count];
+    float StabilityBrakeTorque[EVehicleWheel::Count];
+
+    // Inputs (per vehicle)
+    float ForwardSpeed = 0.0f;     // m/s
+    float SteeringAngle = 0.0f;    // rad, positive = right
+    float YawRate = 0.0f;          // rad/s, positive = right
+    float Brake = 0.0f;            // 0..1
+    float Throttle = 0.0f;         // 0..1
+
+    // Outputs (bit N = wheel N intervened this step)
+    uint8 ABSMask = 0;
+    uint8 TractionMask = 0;
+    uint8 StabilityMask = 0;
+
+    FWheelAssistBatch();
+};
+
+static_assert(STRUCT_OFFSET(FWheelAssistBatch, WheelSpeed) % 16 == 0, "WheelSpeed must be 16-byte aligned for vector loads");
+static_assert(STRUCT_OFFSET(FWheelAssistBatch, GroundSpeed) % 16 == 0, "GroundSpeed must be 16-byte aligned for vector loads");
+static_assert(STRUCT_OFFSET(FWheelAssistBatch, SlipAngle) % 16 == 0, "SlipAngle must be 16-byte aligned for vector loads");
+static_assert(STRUCT_OFFSET(FWheelAssistBatch, DriveMask) % 16 == 0, "DriveMask must be 16-byte aligned for vector loads");
+static_assert(STRUCT_OFFSET(FWheelAssistBatch, SlipRatio) % 16 == 0, "SlipRatio must be 16-byte aligned for vector stores");
+static_assert(STRUCT_OFFSET(FWheelAssistBatch, BrakeScale) % 16 == 0, "BrakeScale must be 16-byte aligned for vector stores");
+static_assert(STRUCT_OFFSET(FWheelAssistBatch, DriveScale) % 16 == 0, "DriveScale must be 16-byte aligned for vector stores");
+static_assert(STRUCT_OFFSET(FWheelAssistBatch, StabilityBrakeTorque) % 16 == 0, "StabilityBrakeTorque must be 16-byte aligned");
+
+/**
+ * Per-wheel intervention counters. Written on the physics thread,
+ * read on the game thread for telemetry.
+ */
+struct FDrivingAssistCounters
+{
+    std::atomic<uint32> ABS[EVehicleWheel::Count];
+    std::atomic<uint32> Traction[EVehicleWheel::Count];
+    std::atomic<uint32> Stability[EVehicleWheel::Count];
+
+    /** Combined EVehicleAssistFlags of the most recent step */
+    std::atomic<uint8> LastActiveAssists;
+
+    FDrivingAssistCounters();
+
+    void Accumulate(const FWheelAssistBatch& Batch);
+    void Reset();
+};
+
+/**
+ * Evaluate ABS, traction control and stability control for any number of vehicles.
+ * Each batch processes its four wheels in one SIMD register, so a full grid
+ * costs one pass over a contiguous array.
+ */
+CARGAME_API void RunDrivingAssists(const FDrivingAssistParams& Params, TArrayView<FWheelAssistBatch> Batches);
+
+/** Per-vehicle params variant, same length as Batches */
+CARGAME_API void RunDrivingAssists(TArrayView<const FDrivingAssistParams> Params, TArrayView<FWheelAssistBatch> Batches);
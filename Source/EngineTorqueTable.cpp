@@ -0,0 +1,58 @@
+// EngineTorqueTable.cpp
+// Engine torque table baking
+// Copyright 2025. All Rights Reserved.
+
+#include "EngineTorqueTable.h"
+#include "Curves/CurveFloat.h"
+
+namespace
+{
+    /** Used when no torque curve asset is assigned: rises from idle, peaks at 70% of the rev range */
+    float DefaultTorqueFraction(float RPM, float IdleRPM, float RevLimit)
+    {
+        const float PeakRPM = FMath::Lerp(IdleRPM, RevLimit, 0.7f);
+        if (RPM <= PeakRPM)
+        {
+            return FMath::GetMappedRangeValueClamped(FVector2f(0.0f, PeakRPM), FVector2f(0.6f, 1.0f), RPM);
+        }
+        return FMath::GetMappedRangeValueClamped(FVector2f(PeakRPM, RevLimit), FVector2f(1.0f, 0.8f), RPM);
+    }
+}
+
+FEngineTorqueTable::FEngineTorqueTable()
+    : InvStep(0.0f)
+    , RevLimit(0.0f)
+    , PeakTorque(0.0f)
+    , PeakTorqueRPM(0.0f)
+{
+    FMemory::Memzero(Samples, sizeof(Samples));
+}
+
+void FEngineTorqueTable::Bake(const UCurveFloat* Curve, const FEngineTorqueBakeSettings& Settings)
+{
+    RevLimit = FMath::Max(Settings.RevLimit, Settings.IdleRPM + 1.0f);
+    InvStep = (NumSamples - 1) / RevLimit;
+    PeakTorque = 0.0f;
+    PeakTorqueRPM = 0.0f;
+
+    const float Scale = Settings.MaxTorque * Settings.TorqueScale;
+
+    for (int32 i = 0; i < NumSamples; i++)
+    {
+        const float RPM = RevLimit * i / (NumSamples - 1);
+
+        // Shifting the band up means reading the stock curve at a lower RPM
+        const float CurveRPM = RPM - Settings.CurveShiftRPM;
+        const float Fraction = Curve
+            ? Curve->GetFloatValue(CurveRPM)
+            : DefaultTorqueFraction(CurveRPM, Settings.IdleRPM, RevLimit);
+
+        Samples[i] = FMath::Max(Fraction, 0.0f) * Scale;
+
+        if (Samples[i] > PeakTorque)
+        {
+            PeakTorque = Samples[i];
+            PeakTorqueRPM = RPM;
+        }
+    }
+}
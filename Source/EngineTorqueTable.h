@@ -0,0 +1,79 @@
+// EngineTorqueTable.h
+// Fixed-resolution RPM to torque table baked from the engine curve and tuning
+// Copyright 2025. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UCurveFloat;
+
+/**
+ * Inputs to FEngineTorqueTable::Bake
+ */
+struct FEngineTorqueBakeSettings
+{
+    /** Torque at curve value 1.0 (Nm) */
+    float MaxTorque = 500.0f;
+
+    float IdleRPM = 1000.0f;
+
+    /** Table extent; torque is zero above it */
+    float RevLimit = 7500.0f;
+
+    /** Combined FEngineTuning PowerMultiplier * TorqueMultiplier */
+    float TorqueScale = 1.0f;
+
+    /** Positive moves the torque band up the rev range (RPM) */
+    float CurveShiftRPM = 0.0f;
+};
+
+/**
+ * Immutable after Bake(). The physics thread samples it every substep,
+ * so it never touches UCurveFloat keys.
+ */
+class CARGAME_API FEngineTorqueTable
+{
+public:
+    static constexpr int32 NumSamples = 128;
+
+    /** RPM shift applied per step of FEngineTuning::TorqueCurveAdjustment */
+    static constexpr float CurveShiftPerStep = 100.0f;
+
+    FEngineTorqueTable();
+
+    /**
+     * Sample Curve (RPM -> fraction of MaxTorque) at fixed RPM intervals.
+     * A null curve falls back to a generic naturally aspirated shape.
+     */
+    void Bake(const UCurveFloat* Curve, const FEngineTorqueBakeSettings& Settings);
+
+    /** Linearly interpolated torque at RPM (Nm) */
+    FORCEINLINE float GetTorque(float RPM) const
+    {
+        const float Position = RPM * InvStep;
+        if (Position <= 0.0f)
+        {
+            return Samples[0];
+        }
+        if (Position >= NumSamples - 1)
+        {
+            return 0.0f;
+        }
+
+        const int32 Index = static_cast<int32>(Position);
+        const float Alpha = Position - Index;
+        return Samples[Index] + (Samples[Index + 1] - Samples[Index]) * Alpha;
+    }
+
+    float GetRevLimit() const { return RevLimit; }
+    float GetPeakTorque() const { return PeakTorque; }
+    float GetPeakTorqueRPM() const { return PeakTorqueRPM; }
+
+private:
+    float Samples[NumSamples];
+    float InvStep;
+    float RevLimit;
+    float PeakTorque;
+    float PeakTorqueRPM;
+};
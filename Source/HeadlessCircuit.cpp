@@ -0,0 +1,154 @@
+// HeadlessCircuit.cpp
+// Seeded closed circuit for commandlets that race without a level
+// Copyright 2025. All Rights Reserved.
+
+#include "HeadlessCircuit.h"
+#include "ProceduralTrackGenerator.h"
+#include "RacingLineOptimizer.h"
+#include "Engine/World.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Components/StaticMeshComponent.h"
+
+namespace
+{
+    constexpr int32 NumControlPoints = 10;
+
+    // Ellipse semi-axes before jitter (cm); the largest radius stays under 700 m
+    constexpr float RadiusX = 60000.0f;
+    constexpr float RadiusY = 35000.0f;
+
+    constexpr float MaxElevation = 600.0f; // cm above the start line
+    constexpr float TrackWidth = 14.0f;    // m
+    constexpr float SlabThickness = 20.0f; // cm
+
+    // Hermite samples per segment when measuring its length
+    constexpr int32 LengthSubsteps = 16;
+
+    ECornerType GetCornerType(float TurnDegrees)
+    {
+        if (TurnDegrees > 60.0f)
+        {
+            return ECornerType::Slow;
+        }
+        return TurnDegrees > 30.0f ? ECornerType::Medium : ECornerType::Fast;
+    }
+}
+
+FTrackLayout FHeadlessCircuit::MakeLayout(int32 Seed)
+{
+    FRandomStream Random(Seed);
+
+    TArray<FVector> Points;
+    Points.SetNumUninitialized(NumControlPoints);
+    const float AngleStep = 2.0f * PI / NumControlPoints;
+    for (int32 i = 0; i < NumControlPoints; i++)
+    {
+        const float Angle = i * AngleStep + Random.FRandRange(-0.3f, 0.3f) * AngleStep;
+        const float Scale = Random.FRandRange(0.7f, 1.15f);
+        const float Z = i == 0 ? 0.0f : Random.FRandRange(0.0f, MaxElevation);
+        Points[i] = FVector(FMath::Cos(Angle) * RadiusX * Scale, FMath::Sin(Angle) * RadiusY * Scale, Z);
+    }
+
+    TArray<FVector> Tangents;
+    Tangents.SetNumUninitialized(NumControlPoints);
+    for (int32 i = 0; i < NumControlPoints; i++)
+    {
+        const FVector& Previous = Points[(i + NumControlPoints - 1) % NumControlPoints];
+        const FVector& Next = Points[(i + 1) % NumControlPoints];
+        Tangents[i] = (Next - Previous).GetSafeNormal();
+    }
+
+    FTrackLayout Layout;
+    Layout.TrackName = FString::Printf(TEXT("Headless Circuit %d"), Seed);
+    Layout.TrackType = ETrackType::Circuit;
+    Layout.AverageWidth = TrackWidth;
+    Layout.StartLineLocation = Points[0];
+    Layout.StartLineRotation = Tangents[0].Rotation();
+
+    for (int32 i = 0; i < NumControlPoints; i++)
+    {
+        const int32 Next = (i + 1) % NumControlPoints;
+
+        FTrackSegment& Segment = Layout.Segments.AddDefaulted_GetRef();
+        Segment.StartLocation = Points[i];
+        Segment.EndLocation = Points[Next];
+        Segment.StartTangent = Tangents[i];
+        Segment.EndTangent = Tangents[Next];
+        Segment.TrackWidth = TrackWidth;
+        Segment.ElevationChange = (Points[Next].Z - Points[i].Z) / 100.0f;
+
+        // Same curve FRacingLineOptimizer::SampleCentreline follows
+        const float Chord = FVector::Dist(Segment.StartLocation, Segment.EndLocation);
+        FVector Last = Segment.StartLocation;
+        float Length = 0.0f;
+        for (int32 Step = 1; Step <= LengthSubsteps; Step++)
+        {
+            const FVector Point = FMath::CubicInterp(Segment.StartLocation, Segment.StartTangent * Chord,
+                Segment.EndLocation, Segment.EndTangent * Chord, static_cast<float>(Step) / LengthSubsteps);
+            Length += FVector::Dist(Last, Point);
+            Last = Point;
+        }
+        Segment.SegmentLength = Length / 100.0f;
+
+        const float TurnDegrees = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(
+            FVector::DotProduct(Segment.StartTangent.GetSafeNormal2D(), Segment.EndTangent.GetSafeNormal2D()), -1.0f, 1.0f)));
+        Segment.CornerType = GetCornerType(TurnDegrees);
+
+        Layout.TotalLength += Segment.SegmentLength;
+        Layout.ElevationGain += FMath::Max(Segment.ElevationChange, 0.0f);
+        Layout.ElevationLoss += FMath::Max(-Segment.ElevationChange, 0.0f);
+        if (TurnDegrees > 15.0f)
+        {
+            Layout.NumberOfCorners++;
+        }
+        else
+        {
+            Layout.LongestStraight = FMath::Max(Layout.LongestStraight, Segment.SegmentLength);
+        }
+    }
+
+    return Layout;
+}
+
+int32 FHeadlessCircuit::SpawnSurface(UWorld* World, const FTrackLayout& Layout, float SlabLength)
+{
+    UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+    if (!World || !Cube)
+    {
+        return 0;
+    }
+
+    TArray<FVector> Centre;
+    TArray<FVector> Normals;
+    TArray<float> HalfWidths;
+    bool bClosed = false;
+    FRacingLineOptimizer::SampleCentreline(Layout, SlabLength, Centre, Normals, HalfWidths, bClosed);
+
+    const int32 NumSlabs = bClosed ? Centre.Num() : Centre.Num() - 1;
+    int32 NumSpawned = 0;
+    for (int32 i = 0; i < NumSlabs; i++)
+    {
+        const FVector& Start = Centre[i];
+        const FVector& End = Centre[(i + 1) % Centre.Num()];
+        const FVector Direction = End - Start;
+        const FRotator Rotation = Direction.Rotation();
+
+        // Top face on the centreline; a little overlap so the joins have no gaps
+        const FVector Location = 0.5f * (Start + End) - Rotation.RotateVector(FVector::UpVector) * (0.5f * SlabThickness);
+        AStaticMeshActor* Slab = World->SpawnActor<AStaticMeshActor>(Location, Rotation);
+        if (!Slab)
+        {
+            continue;
+        }
+
+        // The engine cube is 1 m on each side
+        UStaticMeshComponent* Mesh = Slab->GetStaticMeshComponent();
+        Mesh->SetMobility(EComponentMobility::Movable);
+        Mesh->SetStaticMesh(Cube);
+        Mesh->SetWorldScale3D(FVector((Direction.Size() + 50.0f) / 100.0f, 2.0f * HalfWidths[i] / 100.0f, SlabThickness / 100.0f));
+        Mesh->SetCollisionProfileName(TEXT("BlockAll"));
+        NumSpawned++;
+    }
+    return NumSpawned;
+}
@@ -0,0 +1,28 @@
+// HeadlessCircuit.h
+// Seeded closed circuit for commandlets that race without a level
+// Copyright 2025. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FTrackLayout;
+class UWorld;
+
+/**
+ * Closed circuit built straight into an FTrackLayout, without AProceduralTrackGenerator.
+ *
+ * A ring of control points on a jittered ellipse is joined by Hermite segments with
+ * Catmull-Rom tangents, so FRacingLineOptimizer samples the same curve the surface is
+ * built from. The circuit stays inside the 2 km ground plane the harnesses spawn, and
+ * never dips below its start line, so that plane catches every car that leaves it.
+ */
+class CARGAME_API FHeadlessCircuit
+{
+public:
+    /** Same seed, same circuit */
+    static FTrackLayout MakeLayout(int32 Seed);
+
+    /** Collidable slabs along the layout's centreline, SlabLength (cm) apart. Returns the number spawned. */
+    static int32 SpawnSurface(UWorld* World, const FTrackLayout& Layout, float SlabLength = 1000.0f);
+};
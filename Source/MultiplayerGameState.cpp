@@ -0,0 +1,46 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MultiplayerGameState.h"
+#include "RacingGameMode.h"
+#include "RacingVehicle.h"
+#include "GameFramework/PlayerState.h"
+
+// ============================================================
+// Standings
+// ============================================================
+
+void AMultiplayerGameState::BindToRaceStandings(ARacingGameMode* GameMode)
+{
+    if (!GameMode || !HasAuthority())
+    {
+        return;
+    }
+
+    GameMode->OnRacerPositionChanged.AddUniqueDynamic(this, &AMultiplayerGameState::HandleRacerPositionChanged);
+
+    // Racers registered before binding already have positions
+    for (const FRacerData& Data : GameMode->GetLeaderboard())
+    {
+        HandleRacerPositionChanged(Data.Vehicle, Data.Position, 0);
+    }
+}
+
+void AMultiplayerGameState::HandleRacerPositionChanged(ARacingVehicle* Racer, int32 NewPosition, int32 OldPosition)
+{
+    // AI racers have no player state and no entry here
+    const APlayerState* RacerPlayerState = Racer ? Racer->GetPlayerState() : nullptr;
+    if (!RacerPlayerState)
+    {
+        return;
+    }
+
+    const int32 PlayerID = RacerPlayerState->GetPlayerId();
+    for (FPlayerRaceData& Player : ConnectedPlayers)
+    {
+        if (Player.PlayerID == PlayerID)
+        {
+            Player.CurrentPosition = NewPosition;
+            return;
+        }
+    }
+}
@@ -6,6 +6,9 @@
 #include "GameFramework/GameStateBase.h"
 #include "MultiplayerGameState.generated.h"
 
+class ARacingGameMode;
+class ARacingVehicle;
+
 /**
  * Multiplayer Race State
  */
@@ -225,6 +228,19 @@ public:
     /** Return to lobby */
     UFUNCTION(BlueprintCallable, Category = "Multiplayer")
     void ReturnToLobby();
+
+    // ============================================================
+    // Standings
+    // ============================================================
+
+    /** Follow the game mode's position changes (server only); positions then reach clients by replication */
+    UFUNCTION(BlueprintCallable, Category = "Multiplayer")
+    void BindToRaceStandings(ARacingGameMode* GameMode);
+
+private:
+    /** Copy a racer's new position into its ConnectedPlayers entry */
+    UFUNCTION()
+    void HandleRacerPositionChanged(ARacingVehicle* Racer, int32 NewPosition, int32 OldPosition);
 };
 
 /**
@@ -150,6 +150,14 @@ struct FTrackLayout
 	UPROPERTY(BlueprintReadWrite)
 	FRotator StartLineRotation;
 
+	// Minimum-curvature racing line cached by FRacingLineOptimizer (empty until optimized)
+	UPROPERTY(BlueprintReadWrite)
+	TArray<FVector> OptimizedRacingLine;
+
+	// FRacingLineOptimizer::HashLayout of the segments OptimizedRacingLine was solved for
+	UPROPERTY()
+	int32 OptimizedRacingLineHash;
+
 	FTrackLayout()
 		: TrackName(TEXT("Unnamed Track"))
 		, TrackType(ETrackType::Circuit)
@@ -162,6 +170,7 @@ struct FTrackLayout
 		, AverageWidth(12.0f)
 		, StartLineLocation(FVector::ZeroVector)
 		, StartLineRotation(FRotator::ZeroRotator)
+		, OptimizedRacingLineHash(0)
 	{}
 };
 
@@ -329,6 +338,7 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Track Generator|Analysis")
 	float CalculateTrackLength(const FTrackLayout& Layout) const;
 
+	// Centreline samples; FRacingLineOptimizer solves the line the AI should drive
 	UFUNCTION(BlueprintPure, Category = "Track Generator|Analysis")
 	TArray<FVector> CalculateRacingLine(const FTrackLayout& Layout, int32 PointsPerSegment = 10) const;
 
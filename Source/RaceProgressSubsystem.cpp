@@ -0,0 +1,488 @@
+// RaceProgressSubsystem.cpp
+// Continuous race progress implementation
+// Copyright 2025. All Rights Reserved.
+
+#include "RaceProgressSubsystem.h"
+#include "RaceTrackManager.h"
+#include "RacingLine.h"
+#include "RacingVehicle.h"
+#include "VehicleSimulationSubsystem.h"
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Race Progress Update"), STAT_RaceProgress_Update, STATGROUP_RaceProgress);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Tracked Cars"), STAT_RaceProgress_NumTracked, STATGROUP_RaceProgress);
+
+namespace
+{
+    // Same search as AAIRacingController's defaults: a few segments around last frame's point
+    constexpr int32 SearchWindow = 16;
+    constexpr float RecoveryDistance = 2500.0f; // cm
+
+    // Fewer cars than this are projected inline
+    constexpr int32 ParallelMinBatch = 16;
+
+    // Speed the fallback gap assumes for a car that is barely moving (cm/s)
+    constexpr float MinGapSpeed = 1000.0f;
+}
+
+// ============================================================
+// SOA BATCH
+// ============================================================
+
+void FRaceProgressBatch::AddSlot()
+{
+    Location.Add(FVector::ZeroVector);
+    PreviousLocation.Add(FVector::ZeroVector);
+    bHasLocation.Add(0);
+    bSwept.Add(0);
+    SegmentHint.Add(INDEX_NONE);
+    bHintValid.Add(0);
+    LapDistance.Add(0.0f);
+    Speed.Add(0.0f);
+    Progress.Add(MAX_FLT);
+    MarkTimes.AddDefaulted();
+    bTracked.Add(0);
+}
+
+void FRaceProgressBatch::ResetSlot(int32 Index)
+{
+    bHasLocation[Index] = 0;
+    bSwept[Index] = 0;
+    SegmentHint[Index] = INDEX_NONE;
+    bHintValid[Index] = 0;
+    LapDistance[Index] = 0.0f;
+    Speed[Index] = 0.0f;
+    Progress[Index] = MAX_FLT;
+    MarkTimes[Index].Reset();
+    bTracked[Index] = 0;
+}
+
+void FRaceProgressBatch::Reset()
+{
+    Location.Reset();
+    PreviousLocation.Reset();
+    bHasLocation.Reset();
+    bSwept.Reset();
+    SegmentHint.Reset();
+    bHintValid.Reset();
+    LapDistance.Reset();
+    Speed.Reset();
+    Progress.Reset();
+    MarkTimes.Reset();
+    bTracked.Reset();
+}
+
+// ============================================================
+// TICK FUNCTION
+// ============================================================
+
+void FRaceProgressTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+    if (Subsystem && TickType != LEVELTICK_ViewportsOnly)
+    {
+        Subsystem->UpdateProgress(DeltaTime);
+    }
+}
+
+FString FRaceProgressTickFunction::DiagnosticMessage()
+{
+    return TEXT("FRaceProgressTickFunction");
+}
+
+FName FRaceProgressTickFunction::DiagnosticContext(bool bDetailed)
+{
+    return FName(TEXT("RaceProgress"));
+}
+
+// ============================================================
+// SUBSYSTEM LIFECYCLE
+// ============================================================
+
+void URaceProgressSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    UpdateTickFunction.Subsystem = this;
+    UpdateTickFunction.bCanEverTick = true;
+    UpdateTickFunction.bStartWithTickEnabled = true;
+    UpdateTickFunction.bRunOnAnyThread = false;
+    UpdateTickFunction.TickGroup = TG_PostPhysics;
+}
+
+void URaceProgressSubsystem::Deinitialize()
+{
+    if (UpdateTickFunction.IsTickFunctionRegistered())
+    {
+        UpdateTickFunction.UnRegisterTickFunction();
+    }
+    UpdateTickFunction.Subsystem = nullptr;
+
+    for (ARacingVehicle* Vehicle : Vehicles)
+    {
+        if (Vehicle)
+        {
+            Vehicle->RacerSlot = INDEX_NONE;
+        }
+    }
+    Vehicles.Reset();
+    FreeSlots.Reset();
+    Batch.Reset();
+    TrackManager = nullptr;
+    Line.Reset();
+
+    Super::Deinitialize();
+}
+
+void URaceProgressSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    UpdateTickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+
+    // Measure where the cars ended up this frame
+    if (UVehicleSimulationSubsystem* VehicleSimulation = InWorld.GetSubsystem<UVehicleSimulationSubsystem>())
+    {
+        VehicleSimulation->AddFrameStateConsumer(UpdateTickFunction);
+    }
+}
+
+bool URaceProgressSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+// ============================================================
+// SETUP
+// ============================================================
+
+void URaceProgressSubsystem::SetTrack(ARaceTrackManager* InTrackManager)
+{
+    TrackManager = InTrackManager;
+    RefreshLine();
+}
+
+int32 URaceProgressSubsystem::RegisterVehicle(ARacingVehicle* Vehicle)
+{
+    if (!Vehicle)
+    {
+        return INDEX_NONE;
+    }
+
+    const int32 Existing = FindSlot(Vehicle);
+    if (Existing != INDEX_NONE)
+    {
+        return Existing;
+    }
+
+    int32 Slot;
+    if (FreeSlots.Num() > 0)
+    {
+        Slot = FreeSlots.Pop(false);
+        Vehicles[Slot] = Vehicle;
+        Batch.ResetSlot(Slot);
+    }
+    else
+    {
+        Slot = Vehicles.Add(Vehicle);
+        Batch.AddSlot();
+    }
+
+    Vehicle->RacerSlot = Slot;
+    return Slot;
+}
+
+void URaceProgressSubsystem::UnregisterVehicle(ARacingVehicle* Vehicle)
+{
+    const int32 Slot = FindSlot(Vehicle);
+    if (Slot == INDEX_NONE)
+    {
+        return;
+    }
+
+    Vehicles[Slot] = nullptr;
+    Batch.ResetSlot(Slot);
+    FreeSlots.Add(Slot);
+    Vehicle->RacerSlot = INDEX_NONE;
+}
+
+void URaceProgressSubsystem::ResetProgress()
+{
+    for (int32 i = 0; i < Batch.Num(); i++)
+    {
+        Batch.Progress[i] = MAX_FLT;
+        Batch.Speed[i] = 0.0f;
+        Batch.MarkTimes[i].Reset();
+    }
+}
+
+bool URaceProgressSubsystem::RefreshLine()
+{
+    TSharedPtr<const FRacingLine, ESPMode::ThreadSafe> TrackLine = TrackManager ? TrackManager->GetRacingLine() : nullptr;
+    if (TrackLine != Line)
+    {
+        Line = TrackLine;
+        StartDistance = 0.0f;
+
+        // Laps complete at the last checkpoint
+        if (Line.IsValid() && Line->IsValid() && TrackManager->Checkpoints.Num() > 0)
+        {
+            const FVector StartLocation = TrackManager->GetActorLocation() + TrackManager->Checkpoints.Last().Location;
+            float DistanceSquared;
+            const int32 Nearest = Line->GetSpatialIndex().FindNearest(StartLocation, DistanceSquared);
+            if (Nearest != INDEX_NONE)
+            {
+                StartDistance = Line->ProjectNear(StartLocation, Nearest);
+            }
+        }
+
+        // Hints were found on the old line. Completed laps stand, but the lap in progress
+        // is measured again along the new one, so a line swapped in mid-race keeps the standings.
+        const bool bHasLine = Line.IsValid() && Line->IsValid();
+        for (int32 i = 0; i < Batch.Num(); i++)
+        {
+            Batch.bHintValid[i] = 0;
+
+            float& Progress = Batch.Progress[i];
+            float DistanceSquared;
+            const int32 Nearest = bHasLine && Progress != MAX_FLT && Batch.bHasLocation[i]
+                ? Line->GetSpatialIndex().FindNearest(Batch.Location[i], DistanceSquared)
+                : INDEX_NONE;
+            if (Nearest == INDEX_NONE)
+            {
+                continue;
+            }
+
+            const float CompletedLaps = FMath::FloorToFloat(Progress);
+            const float LapFraction = Line->WrapDistance(Line->ProjectNear(Batch.Location[i], Nearest) - StartDistance) / Line->GetLength();
+            float Delta = LapFraction - (Progress - CompletedLaps);
+            Delta -= FMath::RoundToFloat(Delta);
+            Progress += Delta;
+
+            // Marks up to the last completed lap were timed on the same track and stay
+            const int32 MarksKept = CompletedLaps >= 0.0f ? FMath::FloorToInt(CompletedLaps) * TimingMarksPerLap + 1 : 0;
+            TArray<float>& Marks = Batch.MarkTimes[i];
+            Marks.SetNum(FMath::Min(Marks.Num(), MarksKept), false);
+        }
+    }
+
+    return Line.IsValid() && Line->IsValid();
+}
+
+// ============================================================
+// QUERIES
+// ============================================================
+
+int32 URaceProgressSubsystem::FindSlot(const ARacingVehicle* Vehicle) const
+{
+    return Vehicle && Vehicles.IsValidIndex(Vehicle->RacerSlot) && Vehicles[Vehicle->RacerSlot] == Vehicle
+        ? Vehicle->RacerSlot
+        : INDEX_NONE;
+}
+
+bool URaceProgressSubsystem::GetProgress(const ARacingVehicle* Vehicle, float& OutProgress) const
+{
+    const int32 Slot = FindSlot(Vehicle);
+    if (Slot == INDEX_NONE || !Batch.bTracked[Slot] || Batch.Progress[Slot] == MAX_FLT)
+    {
+        return false;
+    }
+
+    OutProgress = Batch.Progress[Slot];
+    return true;
+}
+
+bool URaceProgressSubsystem::GetLapDistance(const ARacingVehicle* Vehicle, float& OutDistance) const
+{
+    const int32 Slot = FindSlot(Vehicle);
+    if (Slot == INDEX_NONE || !Batch.bTracked[Slot])
+    {
+        return false;
+    }
+
+    OutDistance = Batch.LapDistance[Slot];
+    return true;
+}
+
+bool URaceProgressSubsystem::ProjectToLap(const FVector& Location, float& OutDistance) const
+{
+    if (!Line.IsValid() || !Line->IsValid())
+    {
+        return false;
+    }
+
+    float DistanceSquared;
+    const int32 Nearest = Line->GetSpatialIndex().FindNearest(Location, DistanceSquared);
+    if (Nearest == INDEX_NONE)
+    {
+        return false;
+    }
+
+    OutDistance = Line->WrapDistance(Line->ProjectNear(Location, Nearest) - StartDistance);
+    return true;
+}
+
+float URaceProgressSubsystem::GetTimeGap(const ARacingVehicle* Behind, const ARacingVehicle* Ahead) const
+{
+    float BehindProgress, AheadProgress;
+    if (!GetProgress(Behind, BehindProgress) || !GetProgress(Ahead, AheadProgress) || AheadProgress <= BehindProgress)
+    {
+        return 0.0f;
+    }
+
+    const double Now = GetWorld()->GetTimeSeconds();
+    double Time;
+    if (GetTimeAtProgress(FindSlot(Ahead), BehindProgress, Now, Time))
+    {
+        return static_cast<float>(Now - Time);
+    }
+
+    // Still on the grid: nobody has reached the first mark yet
+    return (AheadProgress - BehindProgress) * GetLapLength() / FMath::Max(Batch.Speed[FindSlot(Behind)], MinGapSpeed);
+}
+
+float URaceProgressSubsystem::GetRaceProgress(const ARacingVehicle* Vehicle) const
+{
+    float Progress;
+    return GetProgress(Vehicle, Progress) ? Progress : 0.0f;
+}
+
+float URaceProgressSubsystem::GetLapLength() const
+{
+    return Line.IsValid() ? Line->GetLength() : 0.0f;
+}
+
+bool URaceProgressSubsystem::GetTimeAtProgress(int32 Slot, float AtProgress, double Now, double& OutTime) const
+{
+    const TArray<float>& Marks = Batch.MarkTimes[Slot];
+    const float MarkPosition = AtProgress * TimingMarksPerLap;
+    const int32 Mark = FMath::FloorToInt(MarkPosition);
+    if (Mark < 0 || Mark >= Marks.Num())
+    {
+        return false;
+    }
+
+    if (Mark + 1 < Marks.Num())
+    {
+        OutTime = FMath::Lerp(static_cast<double>(Marks[Mark]), static_cast<double>(Marks[Mark + 1]), static_cast<double>(MarkPosition - Mark));
+        return true;
+    }
+
+    // Past the last mark: between it and where the car is now
+    const float Span = Batch.Progress[Slot] * TimingMarksPerLap - Mark;
+    const float Alpha = Span > KINDA_SMALL_NUMBER ? FMath::Clamp((MarkPosition - Mark) / Span, 0.0f, 1.0f) : 0.0f;
+    OutTime = FMath::Lerp(static_cast<double>(Marks[Mark]), Now, static_cast<double>(Alpha));
+    return true;
+}
+
+// ============================================================
+// UPDATE
+// ============================================================
+
+void URaceProgressSubsystem::UpdateProgress(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_RaceProgress_Update);
+
+    const int32 NumSlots = Vehicles.Num();
+    if (NumSlots == 0)
+    {
+        SET_DWORD_STAT(STAT_RaceProgress_NumTracked, 0);
+        return;
+    }
+
+    const double Now = GetWorld()->GetTimeSeconds();
+    const double PreviousTime = Now - DeltaTime;
+
+    // Gather on the game thread from the published frame state
+    for (int32 i = 0; i < NumSlots; i++)
+    {
+        const ARacingVehicle* Vehicle = Vehicles[i];
+        const bool bHadLocation = Batch.bHasLocation[i] != 0;
+        Batch.PreviousLocation[i] = Batch.Location[i];
+        Batch.bHasLocation[i] = Vehicle != nullptr;
+        Batch.bSwept[i] = Vehicle && bHadLocation;
+        Batch.bTracked[i] = 0;
+        if (!Vehicle)
+        {
+            continue;
+        }
+
+        const FVehicleFrameState& FrameState = Vehicle->GetFrameState();
+        Batch.Location[i] = FrameState.FrameNumber > 0 ? FrameState.Transform.GetLocation() : Vehicle->GetActorLocation();
+    }
+
+    // Checkpoints first: lap events fire at this frame's crossings
+    if (TrackManager)
+    {
+        TrackManager->DetectCheckpointCrossings(Vehicles, Batch.PreviousLocation, Batch.Location, Batch.bSwept, PreviousTime, Now);
+    }
+
+    if (!RefreshLine())
+    {
+        SET_DWORD_STAT(STAT_RaceProgress_NumTracked, 0);
+        return;
+    }
+
+    const FRacingLine& TrackLine = *Line;
+    const float LapLength = TrackLine.GetLength();
+
+    ParallelFor(NumSlots, [this, &TrackLine, LapLength, Now, PreviousTime, DeltaTime](int32 i)
+    {
+        if (!Batch.bHasLocation[i])
+        {
+            return;
+        }
+
+        // Windowed walk from last frame's point; the grid takes over after respawns
+        const FVector& Location = Batch.Location[i];
+        float DistanceSquared;
+        const int32 Nearest = TrackLine.GetSpatialIndex().FindNearestFrom(Location,
+            Batch.bHintValid[i] ? Batch.SegmentHint[i] : INDEX_NONE, SearchWindow, RecoveryDistance, DistanceSquared);
+        if (Nearest == INDEX_NONE)
+        {
+            return;
+        }
+        Batch.bTracked[i] = 1;
+        Batch.SegmentHint[i] = Nearest;
+        Batch.bHintValid[i] = 1;
+
+        Batch.LapDistance[i] = TrackLine.WrapDistance(TrackLine.ProjectNear(Location, Nearest) - StartDistance);
+        const float LapFraction = Batch.LapDistance[i] / LapLength;
+
+        // Cars cover far less than half a lap per frame, so the shorter way round is the way they went.
+        // A car first seen more than half a lap along is on the grid behind the start line.
+        float& Progress = Batch.Progress[i];
+        const float PreviousProgress = Progress;
+        if (Progress == MAX_FLT)
+        {
+            Progress = LapFraction > 0.5f ? LapFraction - 1.0f : LapFraction;
+            Batch.Speed[i] = 0.0f;
+        }
+        else
+        {
+            float Delta = LapFraction - Progress;
+            Delta -= FMath::RoundToFloat(Delta);
+            Progress += Delta;
+            Batch.Speed[i] = DeltaTime > 0.0f ? Delta * LapLength / DeltaTime : 0.0f;
+        }
+
+        // Timing marks passed this frame, at the sub-frame time the car reached each one
+        TArray<float>& Marks = Batch.MarkTimes[i];
+        const float Covered = Progress - PreviousProgress;
+        for (int32 Mark = Marks.Num(); Mark <= Progress * TimingMarksPerLap; Mark = Marks.Num())
+        {
+            const float MarkProgress = static_cast<float>(Mark) / TimingMarksPerLap;
+            const float Alpha = PreviousProgress != MAX_FLT && Covered > KINDA_SMALL_NUMBER
+                ? FMath::Clamp((MarkProgress - PreviousProgress) / Covered, 0.0f, 1.0f)
+                : 1.0f;
+            Marks.Add(static_cast<float>(FMath::Lerp(PreviousTime, Now, static_cast<double>(Alpha))));
+        }
+    }, NumSlots < ParallelMinBatch);
+
+    int32 NumTracked = 0;
+    for (int32 i = 0; i < NumSlots; i++)
+    {
+        NumTracked += Batch.bTracked[i];
+    }
+    SET_DWORD_STAT(STAT_RaceProgress_NumTracked, NumTracked);
+}
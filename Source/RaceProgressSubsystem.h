@@ -0,0 +1,206 @@
+// RaceProgressSubsystem.h
+// Continuous race progress of every car along the track
+// Copyright 2025. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+#include "RaceProgressSubsystem.generated.h"
+
+class ARacingVehicle;
+class ARaceTrackManager;
+class FRacingLine;
+class URaceProgressSubsystem;
+
+DECLARE_STATS_GROUP(TEXT("RaceProgress"), STATGROUP_RaceProgress, STATCAT_Advanced);
+
+/**
+ * Structure-of-arrays state of every registered car.
+ * Index N in every array belongs to the same racer slot; freed slots stay in place until reused.
+ */
+struct FRaceProgressBatch
+{
+    // Gathered from the last published frame state, and the frame before for checkpoint sweeps
+    TArray<FVector> Location;
+    TArray<FVector> PreviousLocation;
+    TArray<uint8> bHasLocation;
+    TArray<uint8> bSwept;               // 1 = both locations are from consecutive updates
+
+    // Line point the next projection starts its windowed search from
+    TArray<int32> SegmentHint;
+    TArray<uint8> bHintValid;
+
+    // Position on the lap: arc length past the start line (cm) and its rate (cm/s)
+    TArray<float> LapDistance;
+    TArray<float> Speed;
+
+    // Laps since the start line (lap + fraction), MAX_FLT until the car is first seen
+    TArray<float> Progress;
+
+    // Race time each timing mark was first reached; mark K sits at progress K / TimingMarksPerLap
+    TArray<TArray<float>> MarkTimes;
+
+    // 1 = has a vehicle and was projected this frame
+    TArray<uint8> bTracked;
+
+    int32 Num() const { return Location.Num(); }
+    void AddSlot();
+    void ResetSlot(int32 Index);
+    void Reset();
+};
+
+/**
+ * Post-physics tick function that drives the progress update
+ */
+USTRUCT()
+struct FRaceProgressTickFunction : public FTickFunction
+{
+    GENERATED_BODY()
+
+    URaceProgressSubsystem* Subsystem = nullptr;
+
+    virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+    virtual FString DiagnosticMessage() override;
+    virtual FName DiagnosticContext(bool bDetailed) override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FRaceProgressTickFunction> : public TStructOpsTypeTraitsBase2<FRaceProgressTickFunction>
+{
+    enum { WithCopy = false };
+};
+
+/**
+ * Projects every registered car onto the track's line once per frame, after physics,
+ * and keeps its race progress as a continuous lap count from the start line
+ * (1.25 = one lap done and a quarter of the next).
+ *
+ * The track's FRacingLine is the arc-length lookup table: each car's projection
+ * starts from the line point it was nearest last frame, so the search is a few
+ * segments wide and only falls back to the grid after a respawn. Wrapped lap
+ * distances are unwrapped into progress, so positions change continuously instead
+ * of at checkpoints, and driving backwards loses progress.
+ *
+ * Every car also records the race time it first reached each of TimingMarksPerLap
+ * marks per lap. The time gap between two cars is how long ago the car ahead stood
+ * where the car behind is now, as a timing screen would show it.
+ *
+ * Progress 0 is the track manager's last checkpoint, where its laps complete, or the
+ * first racing line point on tracks without checkpoints.
+ *
+ * The same pass hands each car's motion since the last update to the track manager,
+ * which sweeps it against the checkpoint gates (ECheckpointDetection::Swept).
+ *
+ * This is also the race's racer registry. Every car gets a dense slot when it registers
+ * (ARacingVehicle::GetRacerSlot) and keeps it until it leaves. Slots are never swapped,
+ * so the track manager and game mode index their own per-racer arrays by them directly.
+ */
+UCLASS()
+class CARGAME_API URaceProgressSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /** Timing marks per lap the gaps are interpolated between */
+    static constexpr int32 TimingMarksPerLap = 100;
+
+    // USubsystem
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    // UWorldSubsystem
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+    // ============================================================
+    // SETUP
+    // ============================================================
+
+    /** Track whose racing line and start line progress is measured along */
+    void SetTrack(ARaceTrackManager* InTrackManager);
+
+    /** Add a car. Returns its slot, which stays the same until the car is unregistered. */
+    int32 RegisterVehicle(ARacingVehicle* Vehicle);
+
+    /** Remove a car. Its slot is left empty and handed to the next car registered. */
+    void UnregisterVehicle(ARacingVehicle* Vehicle);
+
+    /** Slots in use or free; per-racer arrays elsewhere are at most this long */
+    int32 GetNumSlots() const { return Vehicles.Num(); }
+
+    /** Car in a slot, null when the slot is free */
+    ARacingVehicle* GetVehicle(int32 Slot) const { return Vehicles.IsValidIndex(Slot) ? Vehicles[Slot] : nullptr; }
+
+    /** Forget every car's progress and timing marks; call when the cars are on the grid */
+    UFUNCTION(BlueprintCallable, Category = "Race Progress")
+    void ResetProgress();
+
+    // ============================================================
+    // QUERIES
+    // ============================================================
+
+    /** Laps since the start line (lap + fraction). False when the car is not tracked. */
+    bool GetProgress(const ARacingVehicle* Vehicle, float& OutProgress) const;
+
+    /** Arc length (cm) past the start line on the current lap. False when the car is not tracked. */
+    bool GetLapDistance(const ARacingVehicle* Vehicle, float& OutDistance) const;
+
+    /** Arc length (cm) past the start line of the point on the line nearest Location. False without a line. */
+    bool ProjectToLap(const FVector& Location, float& OutDistance) const;
+
+    /**
+     * Seconds since Ahead stood where Behind is now. Falls back to the distance
+     * between them at Behind's speed before either has reached a timing mark.
+     * 0 when either car is not tracked or Ahead is not actually ahead.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Race Progress")
+    float GetTimeGap(const ARacingVehicle* Behind, const ARacingVehicle* Ahead) const;
+
+    /** Laps since the start line, 0 when the car is not tracked */
+    UFUNCTION(BlueprintCallable, Category = "Race Progress")
+    float GetRaceProgress(const ARacingVehicle* Vehicle) const;
+
+    /** Lap length (cm) of the line progress is measured along, 0 without one */
+    float GetLapLength() const;
+
+    const FRaceProgressBatch& GetBatch() const { return Batch; }
+
+    // ============================================================
+    // UPDATE
+    // ============================================================
+
+    /** Sweep every car through the checkpoints, then project it and advance its progress */
+    void UpdateProgress(float DeltaTime);
+
+private:
+    UPROPERTY(Transient)
+    TArray<ARacingVehicle*> Vehicles;
+
+    UPROPERTY(Transient)
+    ARaceTrackManager* TrackManager = nullptr;
+
+    FRaceProgressBatch Batch;
+
+    // Empty slots, reused before the arrays grow
+    TArray<int32> FreeSlots;
+
+    FRaceProgressTickFunction UpdateTickFunction;
+
+    // Line progress was last measured along and its start line arc length (cm)
+    TSharedPtr<const FRacingLine, ESPMode::ThreadSafe> Line;
+    float StartDistance = 0.0f;
+
+    /** Vehicle's slot when it is registered here, else INDEX_NONE */
+    int32 FindSlot(const ARacingVehicle* Vehicle) const;
+
+    /**
+     * Pick up the track's line, which may be built or replaced after BeginPlay. Progress is
+     * re-based onto a new line, keeping completed laps. False without a line.
+     */
+    bool RefreshLine();
+
+    /** Race time Slot reached Progress at, interpolated between its marks. False before its first mark. */
+    bool GetTimeAtProgress(int32 Slot, float AtProgress, double Now, double& OutTime) const;
+};
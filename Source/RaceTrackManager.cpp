@@ -5,9 +5,19 @@
 #include "RaceTrackManager.h"
 #include "RacingVehicle.h"
 #include "RacingGameMode.h"
+#include "RacingLine.h"
+#include "RaceProgressSubsystem.h"
 #include "Components/BoxComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "DrawDebugHelpers.h"
+#include "EngineUtils.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+    // Longer jumps between frames are respawns and teleports, not driving
+    constexpr float MaxSweepDistance = 5000.0f; // cm
+}
 
 ARaceTrackManager::ARaceTrackManager()
 {
@@ -15,6 +25,7 @@ ARaceTrackManager::ARaceTrackManager()
 
     bAutoGenerateCheckpoints = false;
     CheckpointSpacing = 1000.0f;
+    CheckpointDetection = ECheckpointDetection::Swept;
     TrackName = TEXT("Unnamed Track");
     TrackLength = 0.0f;
     TotalCheckpoints = 0;
@@ -31,14 +42,65 @@ void ARaceTrackManager::BeginPlay()
     TotalCheckpoints = Checkpoints.Num();
     CreateCheckpointColliders();
 
+    if (TrackLayout.Segments.Num() > 0)
+    {
+        SetTrackLayout(TrackLayout);
+    }
+
+    // Race progress is measured along this track's line from its last checkpoint
+    if (URaceProgressSubsystem* RaceProgress = GetWorld()->GetSubsystem<URaceProgressSubsystem>())
+    {
+        RaceProgress->SetTrack(this);
+    }
+
+    // Cars the game mode never registers would otherwise pass every gate unseen
+    if (CheckpointDetection == ECheckpointDetection::Swept)
+    {
+        for (TActorIterator<ARacingVehicle> It(GetWorld()); It; ++It)
+        {
+            RegisterForSweep(*It);
+        }
+        ActorSpawnedHandle = GetWorld()->AddOnActorSpawnedHandler(
+            FOnActorSpawned::FDelegate::CreateUObject(this, &ARaceTrackManager::RegisterForSweep));
+    }
+
     UE_LOG(LogTemp, Log, TEXT("Race Track Manager initialized: %s with %d checkpoints"), 
         *TrackName, TotalCheckpoints);
 }
 
+void ARaceTrackManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (ActorSpawnedHandle.IsValid())
+    {
+        GetWorld()->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+        ActorSpawnedHandle.Reset();
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
 void ARaceTrackManager::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
 
+    if (PendingRacingLine.IsValid() && PendingRacingLine.IsReady())
+    {
+        const FRacingLineOptimizerResult Result = PendingRacingLine.Get();
+        PendingRacingLine.Reset();
+
+        if (FRacingLineOptimizer::StoreInLayout(TrackLayout, Result))
+        {
+            UE_LOG(LogTemp, Log, TEXT("%s: optimized racing line ready %.1f ms after track setup (%d points, %.1f ms solving)"),
+                *TrackName, (FPlatformTime::Seconds() - RacingLineRequestTime) * 1000.0, Result.Points.Num(), Result.SolveSeconds * 1000.0);
+            ApplyRacingLine(TrackLayout.OptimizedRacingLine);
+        }
+        else
+        {
+            // TrackLayout was edited while the old one was being solved
+            StartRacingLineOptimization();
+        }
+    }
+
     // Draw debug visualization for checkpoints
     if (GetWorld()->WorldType == EWorldType::Editor || GetWorld()->WorldType == EWorldType::PIE)
     {
@@ -51,6 +113,51 @@ void ARaceTrackManager::Tick(float DeltaTime)
     }
 }
 
+// ============================================================
+// RACING LINE
+// ============================================================
+
+TSharedPtr<const FRacingLine, ESPMode::ThreadSafe> ARaceTrackManager::GetRacingLine()
+{
+    if (!RacingLine.IsValid() && RacingLineWaypoints.Num() > 2)
+    {
+        RacingLine = FRacingLine::FindOrBuild(RacingLineWaypoints);
+    }
+    return RacingLine;
+}
+
+void ARaceTrackManager::SetTrackLayout(const FTrackLayout& Layout)
+{
+    TrackLayout = Layout;
+    PendingRacingLine.Reset();
+
+    if (FRacingLineOptimizer::HasCachedRacingLine(TrackLayout))
+    {
+        UE_LOG(LogTemp, Log, TEXT("%s: using the racing line cached in the layout (%d points)"),
+            *TrackName, TrackLayout.OptimizedRacingLine.Num());
+        ApplyRacingLine(TrackLayout.OptimizedRacingLine);
+        return;
+    }
+
+    RacingLineRequestTime = FPlatformTime::Seconds();
+    StartRacingLineOptimization();
+}
+
+void ARaceTrackManager::StartRacingLineOptimization()
+{
+    PendingRacingLine = FRacingLineOptimizer::OptimizeAsync(TrackLayout);
+}
+
+void ARaceTrackManager::ApplyRacingLine(const TArray<FVector>& Waypoints)
+{
+    RacingLineWaypoints = Waypoints;
+    RacingLine.Reset();
+    GetRacingLine();
+
+    // The progress subsystem notices the new line itself; the AI is told
+    OnRacingLineChanged.Broadcast();
+}
+
 // ============================================================
 // CHECKPOINT MANAGEMENT
 // ============================================================
@@ -100,6 +207,7 @@ void ARaceTrackManager::ClearAllCheckpoints()
         }
     }
     CheckpointColliders.Empty();
+    CheckpointGates.Empty();
 
     UE_LOG(LogTemp, Log, TEXT("All checkpoints cleared"));
 }
@@ -126,17 +234,51 @@ void ARaceTrackManager::OnCheckpointEnter(UPrimitiveComponent* OverlappedCompone
     int32 CheckpointIndex = CheckpointColliders.Find(Cast<UBoxComponent>(OverlappedComponent));
     if (CheckpointIndex != INDEX_NONE)
     {
-        HandleVehicleCheckpoint(Vehicle, CheckpointIndex);
+        HandleVehicleCheckpoint(Vehicle, CheckpointIndex, GetWorld()->GetTimeSeconds());
     }
 }
 
-int32 ARaceTrackManager::GetVehicleCheckpointIndex(ARacingVehicle* Vehicle)
+void ARaceTrackManager::DetectCheckpointCrossings(TArrayView<ARacingVehicle* const> Vehicles, TArrayView<const FVector> From,
+    TArrayView<const FVector> To, TArrayView<const uint8> bValid, double FromTime, double ToTime)
 {
-    if (VehicleCheckpoints.Contains(Vehicle))
+    if (CheckpointDetection != ECheckpointDetection::Swept || CheckpointGates.Num() == 0)
     {
-        return VehicleCheckpoints[Vehicle];
+        return;
+    }
+
+    for (int32 i = 0; i < Vehicles.Num(); i++)
+    {
+        ARacingVehicle* Vehicle = Vehicles[i];
+        if (!Vehicle || !bValid[i] || FVector::DistSquared(From[i], To[i]) > FMath::Square(MaxSweepDistance))
+        {
+            continue;
+        }
+
+        // Only the expected gate counts, so a fast car may pass several in one frame
+        float Start = 0.0f;
+        for (int32 Crossed = 0; Crossed < CheckpointGates.Num() && Start < 1.0f; Crossed++)
+        {
+            const int32 Slot = FindRacer(Vehicle);
+            const int32 Expected = Slot != INDEX_NONE ? RacerNextCheckpoint[Slot] : 0;
+            float Alpha;
+            if (!SweepCheckpoint(Expected, FMath::Lerp(From[i], To[i], Start), To[i], Alpha))
+            {
+                break;
+            }
+
+            Start += (1.0f - Start) * Alpha;
+            HandleVehicleCheckpoint(Vehicle, Expected, FMath::Lerp(FromTime, ToTime, static_cast<double>(Start)));
+
+            // Step off the plane so a single-gate track can't count it twice
+            Start += KINDA_SMALL_NUMBER;
+        }
     }
-    return 0;
+}
+
+int32 ARaceTrackManager::GetVehicleCheckpointIndex(ARacingVehicle* Vehicle)
+{
+    const int32 Slot = FindRacer(Vehicle);
+    return Slot != INDEX_NONE ? RacerNextCheckpoint[Slot] : 0;
 }
 
 float ARaceTrackManager::GetVehicleDistanceToNextCheckpoint(ARacingVehicle* Vehicle)
@@ -147,14 +289,24 @@ float ARaceTrackManager::GetVehicleDistanceToNextCheckpoint(ARacingVehicle* Vehi
     int32 CurrentCheckpoint = GetVehicleCheckpointIndex(Vehicle);
     int32 NextCheckpoint = (CurrentCheckpoint + 1) % TotalCheckpoints;
 
-    if (Checkpoints.IsValidIndex(NextCheckpoint))
+    if (!Checkpoints.IsValidIndex(NextCheckpoint))
     {
-        FVector VehicleLocation = Vehicle->GetActorLocation();
-        FVector CheckpointLocation = GetActorLocation() + Checkpoints[NextCheckpoint].Location;
-        return FVector::Dist(VehicleLocation, CheckpointLocation);
+        return 0.0f;
+    }
+
+    FVector CheckpointLocation = GetActorLocation() + Checkpoints[NextCheckpoint].Location;
+
+    // Along the track when the car's progress is tracked, so hairpins don't shorten it
+    const URaceProgressSubsystem* RaceProgress = GetWorld()->GetSubsystem<URaceProgressSubsystem>();
+    float VehicleDistance, CheckpointDistance;
+    if (RaceProgress && RaceProgress->GetLapDistance(Vehicle, VehicleDistance)
+        && RaceProgress->ProjectToLap(CheckpointLocation, CheckpointDistance))
+    {
+        const float LapLength = RaceProgress->GetLapLength();
+        return FMath::Fmod(CheckpointDistance - VehicleDistance + LapLength, LapLength);
     }
 
-    return 0.0f;
+    return FVector::Dist(Vehicle->GetActorLocation(), CheckpointLocation);
 }
 
 // ============================================================
@@ -163,20 +315,14 @@ float ARaceTrackManager::GetVehicleDistanceToNextCheckpoint(ARacingVehicle* Vehi
 
 float ARaceTrackManager::GetCurrentLapTime(ARacingVehicle* Vehicle)
 {
-    if (VehicleLapStartTimes.Contains(Vehicle))
-    {
-        return GetWorld()->GetTimeSeconds() - VehicleLapStartTimes[Vehicle];
-    }
-    return 0.0f;
+    const int32 Slot = FindRacer(Vehicle);
+    return Slot != INDEX_NONE ? GetWorld()->GetTimeSeconds() - RacerLapStartTime[Slot] : 0.0f;
 }
 
 float ARaceTrackManager::GetBestLapTime(ARacingVehicle* Vehicle)
 {
-    if (VehicleBestLaps.Contains(Vehicle))
-    {
-        return VehicleBestLaps[Vehicle];
-    }
-    return 0.0f;
+    const int32 Slot = FindRacer(Vehicle);
+    return Slot != INDEX_NONE ? RacerBestLap[Slot] : 0.0f;
 }
 
 // ============================================================
@@ -195,6 +341,18 @@ void ARaceTrackManager::CreateCheckpointColliders()
     }
     CheckpointColliders.Empty();
 
+    // Gates for swept detection, placed where the colliders would be
+    CheckpointGates.Reset(Checkpoints.Num());
+    for (const FCheckpointData& Checkpoint : Checkpoints)
+    {
+        CheckpointGates.Add(FTransform(Checkpoint.Rotation, Checkpoint.Location) * GetActorTransform());
+    }
+
+    if (CheckpointDetection != ECheckpointDetection::Overlap)
+    {
+        return;
+    }
+
     // Create new colliders
     for (int32 i = 0; i < Checkpoints.Num(); i++)
     {
@@ -222,22 +380,65 @@ void ARaceTrackManager::CreateCheckpointColliders()
     UE_LOG(LogTemp, Log, TEXT("Created %d checkpoint colliders"), CheckpointColliders.Num());
 }
 
-void ARaceTrackManager::HandleVehicleCheckpoint(ARacingVehicle* Vehicle, int32 CheckpointIndex)
+void ARaceTrackManager::RegisterForSweep(AActor* Actor)
+{
+    ARacingVehicle* Vehicle = Cast<ARacingVehicle>(Actor);
+    if (!Vehicle || Vehicle->GetRacerSlot() != INDEX_NONE)
+    {
+        return;
+    }
+
+    URaceProgressSubsystem* RaceProgress = GetWorld()->GetSubsystem<URaceProgressSubsystem>();
+    if (!RaceProgress || RaceProgress->RegisterVehicle(Vehicle) == INDEX_NONE)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("%s: %s has no racer slot and checkpoints are swept, not overlapped; its laps will not count"),
+            *TrackName, *Vehicle->GetName());
+    }
+}
+
+bool ARaceTrackManager::SweepCheckpoint(int32 CheckpointIndex, const FVector& From, const FVector& To, float& OutAlpha) const
+{
+    if (!CheckpointGates.IsValidIndex(CheckpointIndex))
+    {
+        return false;
+    }
+
+    // Signed distances to the gate plane must change sign (either direction; ordering rejects wrong-way passes)
+    const FTransform& Gate = CheckpointGates[CheckpointIndex];
+    const FVector LocalFrom = Gate.InverseTransformPosition(From);
+    const FVector LocalTo = Gate.InverseTransformPosition(To);
+    if ((LocalFrom.X < 0.0f) == (LocalTo.X < 0.0f))
+    {
+        return false;
+    }
+
+    OutAlpha = LocalFrom.X / (LocalFrom.X - LocalTo.X);
+
+    // Through the gate, not around it
+    const FVector Crossing = FMath::Lerp(LocalFrom, LocalTo, OutAlpha);
+    const FVector& Extent = Checkpoints[CheckpointIndex].BoxExtent;
+    return FMath::Abs(Crossing.Y) <= Extent.Y && FMath::Abs(Crossing.Z) <= Extent.Z;
+}
+
+void ARaceTrackManager::HandleVehicleCheckpoint(ARacingVehicle* Vehicle, int32 CheckpointIndex, double CrossingTime)
 {
     // Initialize vehicle tracking if needed
-    if (!VehicleCheckpoints.Contains(Vehicle))
+    int32 Slot = FindRacer(Vehicle);
+    if (Slot == INDEX_NONE)
     {
-        VehicleCheckpoints.Add(Vehicle, 0);
-        VehicleLapStartTimes.Add(Vehicle, GetWorld()->GetTimeSeconds());
-        VehicleBestLaps.Add(Vehicle, FLT_MAX);
+        Slot = AddRacer(Vehicle, CrossingTime);
+        if (Slot == INDEX_NONE)
+        {
+            return;
+        }
     }
 
-    int32 ExpectedCheckpoint = VehicleCheckpoints[Vehicle];
+    int32 ExpectedCheckpoint = RacerNextCheckpoint[Slot];
 
     // Check if vehicle hit the correct next checkpoint
     if (CheckpointIndex == ExpectedCheckpoint)
     {
-        VehicleCheckpoints[Vehicle] = (CheckpointIndex + 1) % TotalCheckpoints;
+        RacerNextCheckpoint[Slot] = (CheckpointIndex + 1) % TotalCheckpoints;
         
         OnCheckpointPassed.Broadcast(Vehicle, CheckpointIndex);
 
@@ -251,16 +452,16 @@ void ARaceTrackManager::HandleVehicleCheckpoint(ARacingVehicle* Vehicle, int32 C
         // Check for lap completion
         if (IsLapComplete(Vehicle, CheckpointIndex))
         {
-            float LapTime = GetCurrentLapTime(Vehicle);
+            float LapTime = static_cast<float>(CrossingTime - RacerLapStartTime[Slot]);
             
             // Update best lap
-            if (LapTime < VehicleBestLaps[Vehicle])
+            if (LapTime < RacerBestLap[Slot])
             {
-                VehicleBestLaps[Vehicle] = LapTime;
+                RacerBestLap[Slot] = LapTime;
             }
 
             // Reset lap timer
-            VehicleLapStartTimes[Vehicle] = GetWorld()->GetTimeSeconds();
+            RacerLapStartTime[Slot] = static_cast<float>(CrossingTime);
 
             OnLapCompleted.Broadcast(Vehicle, LapTime);
 
@@ -276,6 +477,44 @@ void ARaceTrackManager::HandleVehicleCheckpoint(ARacingVehicle* Vehicle, int32 C
     }
 }
 
+int32 ARaceTrackManager::FindRacer(const ARacingVehicle* Vehicle) const
+{
+    const int32 Slot = Vehicle ? Vehicle->GetRacerSlot() : INDEX_NONE;
+    return RacerVehicles.IsValidIndex(Slot) && RacerVehicles[Slot] == Vehicle ? Slot : INDEX_NONE;
+}
+
+int32 ARaceTrackManager::AddRacer(ARacingVehicle* Vehicle, double StartTime)
+{
+    // Cars the game mode hasn't registered (overlap detection sees every car) join the registry here
+    int32 Slot = Vehicle->GetRacerSlot();
+    if (Slot == INDEX_NONE)
+    {
+        if (URaceProgressSubsystem* RaceProgress = GetWorld()->GetSubsystem<URaceProgressSubsystem>())
+        {
+            Slot = RaceProgress->RegisterVehicle(Vehicle);
+        }
+        if (Slot == INDEX_NONE)
+        {
+            return INDEX_NONE;
+        }
+    }
+
+    if (Slot >= RacerVehicles.Num())
+    {
+        const int32 NumAdded = Slot + 1 - RacerVehicles.Num();
+        RacerVehicles.AddZeroed(NumAdded);
+        RacerNextCheckpoint.AddZeroed(NumAdded);
+        RacerLapStartTime.AddZeroed(NumAdded);
+        RacerBestLap.AddZeroed(NumAdded);
+    }
+
+    RacerVehicles[Slot] = Vehicle;
+    RacerNextCheckpoint[Slot] = 0;
+    RacerLapStartTime[Slot] = static_cast<float>(StartTime);
+    RacerBestLap[Slot] = FLT_MAX;
+    return Slot;
+}
+
 bool ARaceTrackManager::IsLapComplete(ARacingVehicle* Vehicle, int32 CheckpointIndex)
 {
     // Lap is complete when vehicle passes the last checkpoint (finishes a full loop)
@@ -6,10 +6,20 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "ProceduralTrackGenerator.h"
+#include "RacingLineOptimizer.h"
 #include "RaceTrackManager.generated.h"
 
 class ARacingVehicle;
 class UBoxComponent;
+class FRacingLine;
+
+UENUM(BlueprintType)
+enum class ECheckpointDetection : uint8
+{
+    Swept       UMETA(DisplayName = "Swept Segment"),
+    Overlap     UMETA(DisplayName = "Overlap Boxes")
+};
 
 USTRUCT(BlueprintType)
 struct FCheckpointData
@@ -49,6 +59,7 @@ public:
     ARaceTrackManager();
 
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void Tick(float DeltaTime) override;
 
     // ============================================================
@@ -64,6 +75,15 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Track Setup")
     float CheckpointSpacing;
 
+    /**
+     * Swept: each racer's motion since the last frame is tested against the checkpoint
+     * gates after physics, with the crossing time interpolated inside the frame. Every
+     * car in the world is registered as a racer so it is swept, game mode or not.
+     * Overlap: a box collider per checkpoint, triggered by the physics scene.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Track Setup")
+    ECheckpointDetection CheckpointDetection;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Track Info")
     FString TrackName;
 
@@ -89,6 +109,36 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Track")
     void GenerateCheckpointsFromSpline();
 
+    // ============================================================
+    // RACING LINE
+    // ============================================================
+
+    /** Closed racing line for AI drivers, in world space */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Track Setup")
+    TArray<FVector> RacingLineWaypoints;
+
+    /**
+     * Generated layout this track runs on, in world space. With segments, BeginPlay hands it
+     * to SetTrackLayout so the AI follows its optimized racing line.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Track Setup")
+    FTrackLayout TrackLayout;
+
+    /**
+     * Race on Layout. A racing line it already carries for its current segments replaces
+     * RacingLineWaypoints at once; otherwise FRacingLineOptimizer solves one on the thread pool
+     * and it replaces them when done. Until then the previous waypoints stay in use.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Track")
+    void SetTrackLayout(const FTrackLayout& Layout);
+
+    /** True while the racing line for TrackLayout is still being solved */
+    UFUNCTION(BlueprintCallable, Category = "Track")
+    bool IsOptimizingRacingLine() const { return PendingRacingLine.IsValid(); }
+
+    /** Line shared by every AI controller on this track, built on first use. Null without waypoints. */
+    TSharedPtr<const FRacingLine, ESPMode::ThreadSafe> GetRacingLine();
+
     // ============================================================
     // VEHICLE TRACKING
     // ============================================================
@@ -101,6 +151,14 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Track")
     int32 GetVehicleCheckpointIndex(ARacingVehicle* Vehicle);
 
+    /**
+     * Swept detection: every vehicle moved from From to To between FromTime and ToTime (s).
+     * Each is tested against the gate it needs next, analytically, and any gates it
+     * crossed are handled in order at their interpolated crossing times.
+     */
+    void DetectCheckpointCrossings(TArrayView<ARacingVehicle* const> Vehicles, TArrayView<const FVector> From,
+        TArrayView<const FVector> To, TArrayView<const uint8> bValid, double FromTime, double ToTime);
+
     UFUNCTION(BlueprintCallable, Category = "Track")
     float GetVehicleDistanceToNextCheckpoint(ARacingVehicle* Vehicle);
 
@@ -126,20 +184,53 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "Track Events")
     FOnLapCompleted OnLapCompleted;
 
+    /** RacingLineWaypoints were replaced; GetRacingLine returns the new line */
+    DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnRacingLineChanged);
+    UPROPERTY(BlueprintAssignable, Category = "Track Events")
+    FOnRacingLineChanged OnRacingLineChanged;
+
 private:
     UPROPERTY()
     TArray<UBoxComponent*> CheckpointColliders;
 
-    UPROPERTY()
-    TMap<ARacingVehicle*, int32> VehicleCheckpoints;
+    // World transform of each checkpoint; its gate is the local X = 0 plane within the box's Y/Z extent
+    TArray<FTransform> CheckpointGates;
 
+    // Per-racer state indexed by ARacingVehicle::GetRacerSlot(); a slot is only valid for RacerVehicles[Slot]
     UPROPERTY()
-    TMap<ARacingVehicle*, float> VehicleLapStartTimes;
+    TArray<ARacingVehicle*> RacerVehicles;
 
-    UPROPERTY()
-    TMap<ARacingVehicle*, float> VehicleBestLaps;
+    TArray<int32> RacerNextCheckpoint;
+    TArray<float> RacerLapStartTime;
+    TArray<float> RacerBestLap;
+
+    TSharedPtr<const FRacingLine, ESPMode::ThreadSafe> RacingLine;
+
+    FDelegateHandle ActorSpawnedHandle;
+
+    // Optimizer solve for TrackLayout, polled in Tick; invalid when none is running
+    TFuture<FRacingLineOptimizerResult> PendingRacingLine;
+    double RacingLineRequestTime = 0.0;
 
     void CreateCheckpointColliders();
-    void HandleVehicleCheckpoint(ARacingVehicle* Vehicle, int32 CheckpointIndex);
+
+    /** Solve TrackLayout's racing line on the thread pool */
+    void StartRacingLineOptimization();
+
+    /** Race on Waypoints from now on and tell the AI */
+    void ApplyRacingLine(const TArray<FVector>& Waypoints);
+    void HandleVehicleCheckpoint(ARacingVehicle* Vehicle, int32 CheckpointIndex, double CrossingTime);
+
+    /** Vehicle's racer slot once it has reached a checkpoint here, else INDEX_NONE */
+    int32 FindRacer(const ARacingVehicle* Vehicle) const;
+
+    /** Start tracking Vehicle with its lap timer at StartTime, registering it as a racer if needed */
+    int32 AddRacer(ARacingVehicle* Vehicle, double StartTime);
+
+    /** Swept detection only sees registered racers, so register Actor if it is a car */
+    void RegisterForSweep(AActor* Actor);
+
+    /** Fraction of From..To at which the segment passes through a gate. False when it misses. */
+    bool SweepCheckpoint(int32 CheckpointIndex, const FVector& From, const FVector& To, float& OutAlpha) const;
     bool IsLapComplete(ARacingVehicle* Vehicle, int32 CheckpointIndex);
 };
@@ -0,0 +1,182 @@
+// RacelineSearchBenchmarkCommandlet.cpp
+// Microbenchmark for closest-waypoint tracking on the racing line
+// Copyright 2025. All Rights Reserved.
+
+#include "RacelineSearchBenchmarkCommandlet.h"
+#include "RacelineSpatialIndex.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+
+namespace
+{
+    /** Wavy closed loop of roughly 5 km, so spacing scales with the point count */
+    void BuildSyntheticLine(int32 NumPoints, TArray<FVector>& OutPoints)
+    {
+        OutPoints.SetNumUninitialized(NumPoints);
+        for (int32 i = 0; i < NumPoints; i++)
+        {
+            const float T = 2.0f * PI * i / NumPoints;
+            const float Radius = 80000.0f + 15000.0f * FMath::Sin(3.0f * T) + 5000.0f * FMath::Sin(7.0f * T);
+            OutPoints[i] = FVector(Radius * FMath::Cos(T), Radius * FMath::Sin(T), 500.0f * FMath::Sin(2.0f * T));
+        }
+    }
+
+    /** Point at fractional index Position, pushed sideways by Lateral (cm) */
+    FVector SampleLine(const TArray<FVector>& Points, float Position, float Lateral)
+    {
+        const int32 NumPoints = Points.Num();
+        const int32 Index = FMath::FloorToInt(Position) % NumPoints;
+        const int32 Next = (Index + 1) % NumPoints;
+        const FVector Tangent = (Points[Next] - Points[Index]).GetSafeNormal();
+        const FVector Right(-Tangent.Y, Tangent.X, 0.0f);
+        return FMath::Lerp(Points[Index], Points[Next], FMath::Frac(Position)) + Right * Lateral;
+    }
+}
+
+URacelineSearchBenchmarkCommandlet::URacelineSearchBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 URacelineSearchBenchmarkCommandlet::Main(const FString& Params)
+{
+    int32 NumPoints = 5000;
+    int32 NumCars = 40;
+    int32 NumFrames = 3600;
+    int32 Seed = 1;
+    FParse::Value(*Params, TEXT("Points="), NumPoints);
+    FParse::Value(*Params, TEXT("AI="), NumCars);
+    FParse::Value(*Params, TEXT("Frames="), NumFrames);
+    FParse::Value(*Params, TEXT("Seed="), Seed);
+    NumPoints = FMath::Max(NumPoints, 16);
+    NumCars = FMath::Max(NumCars, 1);
+    NumFrames = FMath::Max(NumFrames, 1);
+
+    // Controller defaults
+    constexpr int32 Window = 16;
+    constexpr float RecoveryDistance = 2500.0f;
+    constexpr float FrameTime = 1.0f / 60.0f;
+
+    TArray<FVector> Points;
+    BuildSyntheticLine(NumPoints, Points);
+
+    float LineLength = 0.0f;
+    for (int32 i = 0; i < NumPoints; i++)
+    {
+        LineLength += FVector::Dist(Points[i], Points[(i + 1) % NumPoints]);
+    }
+    const float Spacing = LineLength / NumPoints;
+
+    const double BuildStart = FPlatformTime::Seconds();
+    FRacelineSpatialIndex Index;
+    Index.Build(Points);
+    const double BuildSeconds = FPlatformTime::Seconds() - BuildStart;
+
+    // Precompute every car location so both methods see identical queries
+    FRandomStream Random(Seed);
+    TArray<FVector> Queries;
+    Queries.SetNumUninitialized(NumFrames * NumCars);
+
+    int32 NumRespawns = 0;
+    for (int32 Car = 0; Car < NumCars; Car++)
+    {
+        float Position = Random.FRandRange(0.0f, NumPoints);
+        const float Speed = Random.FRandRange(4000.0f, 8500.0f);   // cm/s
+        const float Phase = Random.FRandRange(0.0f, 2.0f * PI);
+
+        for (int32 Frame = 0; Frame < NumFrames; Frame++)
+        {
+            // About one respawn per car per minute
+            if (Random.FRand() < FrameTime / 60.0f)
+            {
+                Position = Random.FRandRange(0.0f, NumPoints);
+                NumRespawns++;
+            }
+
+            Position = FMath::Fmod(Position + Speed * FrameTime / Spacing, static_cast<float>(NumPoints));
+            const float Lateral = 300.0f * FMath::Sin(0.5f * Frame * FrameTime + Phase);
+            Queries[Frame * NumCars + Car] = SampleLine(Points, Position, Lateral);
+        }
+    }
+
+    const int32 NumQueries = Queries.Num();
+    TArray<int32> LinearResults;
+    TArray<int32> TrackedResults;
+    LinearResults.SetNumUninitialized(NumQueries);
+    TrackedResults.SetNumUninitialized(NumQueries);
+
+    // Full scan, the previous per-tick behaviour
+    const double LinearStart = FPlatformTime::Seconds();
+    for (int32 Query = 0; Query < NumQueries; Query++)
+    {
+        float DistanceSquared;
+        LinearResults[Query] = FRacelineSpatialIndex::FindNearestLinear(Points, Queries[Query], DistanceSquared);
+    }
+    const double LinearSeconds = FPlatformTime::Seconds() - LinearStart;
+
+    // Windowed tracking with grid fallback
+    TArray<int32> Hints;
+    Hints.Init(INDEX_NONE, NumCars);
+    int32 GridQueries = 0;
+
+    const double TrackedStart = FPlatformTime::Seconds();
+    for (int32 Frame = 0; Frame < NumFrames; Frame++)
+    {
+        for (int32 Car = 0; Car < NumCars; Car++)
+        {
+            const int32 Query = Frame * NumCars + Car;
+            float DistanceSquared;
+            bool bUsedGrid;
+            Hints[Car] = Index.FindNearestFrom(Queries[Query], Hints[Car], Window, RecoveryDistance, DistanceSquared, &bUsedGrid);
+            TrackedResults[Query] = Hints[Car];
+            GridQueries += bUsedGrid ? 1 : 0;
+        }
+    }
+    const double TrackedSeconds = FPlatformTime::Seconds() - TrackedStart;
+
+    // Grid alone, for reference
+    const double GridStart = FPlatformTime::Seconds();
+    int32 GridChecksum = 0;
+    for (int32 Query = 0; Query < NumQueries; Query++)
+    {
+        float DistanceSquared;
+        GridChecksum += Index.FindNearest(Queries[Query], DistanceSquared);
+    }
+    const double GridSeconds = FPlatformTime::Seconds() - GridStart;
+
+    // Ties between equidistant points are not mismatches
+    int32 Mismatches = 0;
+    for (int32 Query = 0; Query < NumQueries; Query++)
+    {
+        if (LinearResults[Query] != TrackedResults[Query]
+            && !FMath::IsNearlyEqual(FVector::DistSquared(Queries[Query], Points[LinearResults[Query]]),
+                FVector::DistSquared(Queries[Query], Points[TrackedResults[Query]]), 1.0f))
+        {
+            Mismatches++;
+        }
+    }
+
+    auto NanosecondsPerQuery = [NumQueries](double Seconds)
+    {
+        return Seconds * 1.0e9 / NumQueries;
+    };
+
+    UE_LOG(LogTemp, Display, TEXT("Raceline search benchmark: %d points (%.0f cm apart), %d cars, %d frames, %d respawns"),
+        NumPoints, Spacing, NumCars, NumFrames, NumRespawns);
+    UE_LOG(LogTemp, Display, TEXT("  Grid build:      %.2f ms"), BuildSeconds * 1000.0);
+    UE_LOG(LogTemp, Display, TEXT("  Linear scan:     %.1f ns/query (%.3f ms/frame)"), NanosecondsPerQuery(LinearSeconds), LinearSeconds * 1000.0 / NumFrames);
+    UE_LOG(LogTemp, Display, TEXT("  Windowed + grid: %.1f ns/query (%.3f ms/frame, %d grid fallbacks)"), NanosecondsPerQuery(TrackedSeconds),
+        TrackedSeconds * 1000.0 / NumFrames, GridQueries);
+    UE_LOG(LogTemp, Display, TEXT("  Grid only:       %.1f ns/query"), NanosecondsPerQuery(GridSeconds));
+    UE_LOG(LogTemp, Display, TEXT("  Speedup:         %.1fx"), TrackedSeconds > 0.0 ? LinearSeconds / TrackedSeconds : 0.0);
+    UE_LOG(LogTemp, Display, TEXT("  Mismatches:      %d of %d (checksum %d)"), Mismatches, NumQueries, GridChecksum);
+
+    if (Mismatches > 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Raceline search benchmark: windowed search disagreed with the linear scan %d times"), Mismatches);
+    }
+    return 0;
+}
@@ -0,0 +1,28 @@
+// RacelineSearchBenchmarkCommandlet.h
+// Microbenchmark for closest-waypoint tracking on the racing line
+// Copyright 2025. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "RacelineSearchBenchmarkCommandlet.generated.h"
+
+/**
+ * Compares the full linear scan AI controllers used to run every tick against
+ * the windowed incremental search with grid fallback (FRacelineSpatialIndex),
+ * on a synthetic closed line with cars driving around it and occasionally respawning.
+ *
+ * Usage:
+ *   UnrealEditor-Cmd CarGame.uproject -run=RacelineSearchBenchmark [-Points=5000] [-AI=40] [-Frames=3600] [-Seed=1]
+ */
+UCLASS()
+class CARGAME_API URacelineSearchBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    URacelineSearchBenchmarkCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
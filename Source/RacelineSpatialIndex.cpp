@@ -0,0 +1,213 @@
+// RacelineSpatialIndex.cpp
+// Nearest racing-line point queries
+// Copyright 2025. All Rights Reserved.
+
+#include "RacelineSpatialIndex.h"
+
+namespace
+{
+    // Keep the grid bounded for very large or degenerate lines
+    constexpr int32 MaxGridCells = 1 << 20;
+
+    // Points scanned behind the hint; cars rarely go backwards
+    constexpr int32 WindowBehind = 2;
+}
+
+void FRacelineSpatialIndex::Build(TArrayView<const FVector> InPoints, float InCellSize)
+{
+    Points = InPoints;
+    CellStart.Reset();
+    CellPoints.Reset();
+
+    if (Points.Num() == 0)
+    {
+        return;
+    }
+
+    FBox2D Bounds(ForceInit);
+    for (const FVector& Point : Points)
+    {
+        Bounds += FVector2D(Point);
+    }
+
+    CellSize = FMath::Max(InCellSize, 1.0f);
+    const FVector2D Size = Bounds.GetSize();
+    while ((FMath::FloorToInt(Size.X / CellSize) + 1) * static_cast<int64>(FMath::FloorToInt(Size.Y / CellSize) + 1) > MaxGridCells)
+    {
+        CellSize *= 2.0f;
+    }
+
+    InvCellSize = 1.0f / CellSize;
+    Origin = Bounds.Min;
+    NumCellsX = FMath::FloorToInt(Size.X * InvCellSize) + 1;
+    NumCellsY = FMath::FloorToInt(Size.Y * InvCellSize) + 1;
+
+    // Counting sort of point indices by cell
+    const int32 NumCells = NumCellsX * NumCellsY;
+    CellStart.SetNumZeroed(NumCells + 1);
+
+    TArray<int32> PointCell;
+    PointCell.SetNumUninitialized(Points.Num());
+    for (int32 i = 0; i < Points.Num(); i++)
+    {
+        const FIntPoint Cell = GetCell(Points[i]);
+        PointCell[i] = Cell.Y * NumCellsX + Cell.X;
+        CellStart[PointCell[i] + 1]++;
+    }
+
+    for (int32 Cell = 0; Cell < NumCells; Cell++)
+    {
+        CellStart[Cell + 1] += CellStart[Cell];
+    }
+
+    TArray<int32> Cursor(CellStart.GetData(), NumCells);
+    CellPoints.SetNumUninitialized(Points.Num());
+    for (int32 i = 0; i < Points.Num(); i++)
+    {
+        CellPoints[Cursor[PointCell[i]]++] = i;
+    }
+}
+
+FIntPoint FRacelineSpatialIndex::GetCell(const FVector& Location) const
+{
+    return FIntPoint(
+        FMath::Clamp(FMath::FloorToInt((Location.X - Origin.X) * InvCellSize), 0, NumCellsX - 1),
+        FMath::Clamp(FMath::FloorToInt((Location.Y - Origin.Y) * InvCellSize), 0, NumCellsY - 1));
+}
+
+int32 FRacelineSpatialIndex::FindNearest(const FVector& Location, float& OutDistanceSquared) const
+{
+    OutDistanceSquared = MAX_FLT;
+    if (!IsBuilt())
+    {
+        return INDEX_NONE;
+    }
+
+    const FIntPoint Center = GetCell(Location);
+    const int32 MaxRing = FMath::Max(NumCellsX, NumCellsY);
+    int32 Best = INDEX_NONE;
+
+    for (int32 Ring = 0; Ring <= MaxRing; Ring++)
+    {
+        for (int32 Y = Center.Y - Ring; Y <= Center.Y + Ring; Y++)
+        {
+            if (Y < 0 || Y >= NumCellsY)
+            {
+                continue;
+            }
+
+            // Interior rows of the ring only contribute their two edge cells
+            const bool bEdgeRow = (Y == Center.Y - Ring || Y == Center.Y + Ring);
+            const int32 Step = bEdgeRow ? 1 : FMath::Max(2 * Ring, 1);
+
+            for (int32 X = Center.X - Ring; X <= Center.X + Ring; X += Step)
+            {
+                if (X < 0 || X >= NumCellsX)
+                {
+                    continue;
+                }
+
+                const int32 Cell = Y * NumCellsX + X;
+                for (int32 Slot = CellStart[Cell]; Slot < CellStart[Cell + 1]; Slot++)
+                {
+                    const int32 Index = CellPoints[Slot];
+                    const float DistanceSquared = FVector::DistSquared(Location, Points[Index]);
+                    if (DistanceSquared < OutDistanceSquared)
+                    {
+                        OutDistanceSquared = DistanceSquared;
+                        Best = Index;
+                    }
+                }
+            }
+        }
+
+        // Anything in the next ring is at least Ring cells away
+        if (Best != INDEX_NONE && OutDistanceSquared <= FMath::Square(Ring * CellSize))
+        {
+            break;
+        }
+    }
+
+    return Best;
+}
+
+int32 FRacelineSpatialIndex::FindNearestFrom(const FVector& Location, int32 Hint, int32 Window, float RecoveryDistance,
+    float& OutDistanceSquared, bool* bOutUsedGrid) const
+{
+    if (bOutUsedGrid)
+    {
+        *bOutUsedGrid = false;
+    }
+
+    const int32 NumPoints = Points.Num();
+    if (NumPoints == 0)
+    {
+        OutDistanceSquared = MAX_FLT;
+        return INDEX_NONE;
+    }
+
+    if (Hint >= 0 && Hint < NumPoints)
+    {
+        auto Wrap = [NumPoints](int32 Index) { return (Index % NumPoints + NumPoints) % NumPoints; };
+
+        const int32 First = -FMath::Min(WindowBehind, NumPoints - 1);
+        const int32 Last = FMath::Min(FMath::Max(Window, 1), NumPoints - 1 + First);
+
+        int32 BestOffset = 0;
+        float BestDistanceSquared = FVector::DistSquared(Location, Points[Hint]);
+        for (int32 Offset = First; Offset <= Last; Offset++)
+        {
+            const float DistanceSquared = FVector::DistSquared(Location, Points[Wrap(Hint + Offset)]);
+            if (DistanceSquared < BestDistanceSquared)
+            {
+                BestDistanceSquared = DistanceSquared;
+                BestOffset = Offset;
+            }
+        }
+
+        // Moved further than the window in one tick: keep walking downhill
+        const int32 Direction = (BestOffset == Last) ? 1 : (BestOffset == First ? -1 : 0);
+        if (Direction != 0)
+        {
+            for (int32 Steps = 0; Steps < NumPoints; Steps++)
+            {
+                const float DistanceSquared = FVector::DistSquared(Location, Points[Wrap(Hint + BestOffset + Direction)]);
+                if (DistanceSquared >= BestDistanceSquared)
+                {
+                    break;
+                }
+                BestDistanceSquared = DistanceSquared;
+                BestOffset += Direction;
+            }
+        }
+
+        if (BestDistanceSquared <= FMath::Square(RecoveryDistance))
+        {
+            OutDistanceSquared = BestDistanceSquared;
+            return Wrap(Hint + BestOffset);
+        }
+    }
+
+    // No usable hint, or the car is far from where the window says: respawned, teleported or off track
+    if (bOutUsedGrid)
+    {
+        *bOutUsedGrid = true;
+    }
+    return FindNearest(Location, OutDistanceSquared);
+}
+
+int32 FRacelineSpatialIndex::FindNearestLinear(TArrayView<const FVector> InPoints, const FVector& Location, float& OutDistanceSquared)
+{
+    OutDistanceSquared = MAX_FLT;
+    int32 Best = INDEX_NONE;
+    for (int32 i = 0; i < InPoints.Num(); i++)
+    {
+        const float DistanceSquared = FVector::DistSquared(Location, InPoints[i]);
+        if (DistanceSquared < OutDistanceSquared)
+        {
+            OutDistanceSquared = DistanceSquared;
+            Best = i;
+        }
+    }
+    return Best;
+}
@@ -0,0 +1,57 @@
+// RacelineSpatialIndex.h
+// Nearest racing-line point queries: incremental windowed search and uniform grid fallback
+// Copyright 2025. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Closest-point lookup on a closed racing line.
+ *
+ * Cars move a few points per frame, so the common query walks a small window
+ * around the previous answer. The XY grid, built once per line, answers the
+ * rare global query after a respawn, a teleport or a long excursion off track.
+ * All comparisons use squared distance.
+ */
+class CARGAME_API FRacelineSpatialIndex
+{
+public:
+    /** Default grid cell edge (cm) */
+    static constexpr float DefaultCellSize = 2000.0f;
+
+    /** Copy Points and bucket them into the grid */
+    void Build(TArrayView<const FVector> InPoints, float CellSize = DefaultCellSize);
+
+    bool IsBuilt() const { return Points.Num() > 0; }
+    int32 Num() const { return Points.Num(); }
+
+    /** Global nearest point through the grid. INDEX_NONE when empty. */
+    int32 FindNearest(const FVector& Location, float& OutDistanceSquared) const;
+
+    /**
+     * Nearest point starting from Hint, as a car does every tick.
+     * Scans Hint - 2 .. Hint + Window on the closed line and keeps walking past
+     * either edge while points still get closer. Uses the grid instead when
+     * Hint is INDEX_NONE or the windowed answer is further than RecoveryDistance.
+     */
+    int32 FindNearestFrom(const FVector& Location, int32 Hint, int32 Window, float RecoveryDistance,
+        float& OutDistanceSquared, bool* bOutUsedGrid = nullptr) const;
+
+    /** Reference O(N) scan, kept for the benchmark */
+    static int32 FindNearestLinear(TArrayView<const FVector> Points, const FVector& Location, float& OutDistanceSquared);
+
+private:
+    TArray<FVector> Points;
+
+    // Grid over the XY bounds; point indices stored per cell in CellStart order
+    FVector2D Origin = FVector2D::ZeroVector;
+    float InvCellSize = 0.0f;
+    float CellSize = 0.0f;
+    int32 NumCellsX = 0;
+    int32 NumCellsY = 0;
+    TArray<int32> CellStart;    // NumCellsX * NumCellsY + 1 entries
+    TArray<int32> CellPoints;
+
+    FIntPoint GetCell(const FVector& Location) const;
+};
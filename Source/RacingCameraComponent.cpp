@@ -3,6 +3,8 @@
 // Copyright 2025. All Rights Reserved.
 
 #include "RacingCameraComponent.h"
+#include "RacingVehicle.h"
+#include "VehicleSimulationSubsystem.h"
 #include "GameFramework/SpringArmComponent.h"
 #include "GameFramework/Pawn.h"
 #include "Kismet/KismetMathLibrary.h"
@@ -25,6 +27,22 @@ URacingCameraComponent::URacingCameraComponent()
     InitializeCameraViews();
 }
 
+void URacingCameraComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    OwnerVehicle = Cast<ARacingVehicle>(GetOwner());
+
+    // Read the vehicle's frame state after it is published
+    if (OwnerVehicle)
+    {
+        if (UVehicleSimulationSubsystem* Simulation = GetWorld()->GetSubsystem<UVehicleSimulationSubsystem>())
+        {
+            Simulation->AddFrameStateConsumer(PrimaryComponentTick);
+        }
+    }
+}
+
 void URacingCameraComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
     Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
@@ -180,11 +198,7 @@ void URacingCameraComponent::ApplyCameraShake(float DeltaTime)
 
 void URacingCameraComponent::ApplyLookAhead(float DeltaTime)
 {
-    AActor* Owner = GetOwner();
-    if (!Owner)
-        return;
-
-    FVector Velocity = Owner->GetVelocity();
+    FVector Velocity = GetVehicleVelocity();
     float Speed = Velocity.Size();
 
     if (Speed > 100.0f)
@@ -201,10 +215,16 @@ void URacingCameraComponent::ApplyLookAhead(float DeltaTime)
 
 float URacingCameraComponent::GetVehicleSpeed() const
 {
-    AActor* Owner = GetOwner();
-    if (Owner)
+    return GetVehicleVelocity().Size();
+}
+
+FVector URacingCameraComponent::GetVehicleVelocity() const
+{
+    if (OwnerVehicle)
     {
-        return Owner->GetVelocity().Size();
+        return OwnerVehicle->GetFrameVelocity();
     }
-    return 0.0f;
+
+    AActor* Owner = GetOwner();
+    return Owner ? Owner->GetVelocity() : FVector::ZeroVector;
 }
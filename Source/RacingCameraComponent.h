@@ -63,6 +63,7 @@ class CARGAME_API URacingCameraComponent : public UCameraComponent
 public:
     URacingCameraComponent();
 
+    virtual void BeginPlay() override;
     virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
     // ============================================================
@@ -109,6 +110,9 @@ public:
 
 private:
     class USpringArmComponent* SpringArm;
+
+    /** Null when attached to something other than a racing vehicle */
+    class ARacingVehicle* OwnerVehicle = nullptr;
     
     FVector TargetLocation;
     FRotator TargetRotation;
@@ -119,4 +123,5 @@ private:
     void ApplyCameraShake(float DeltaTime);
     void ApplyLookAhead(float DeltaTime);
     float GetVehicleSpeed() const;
+    FVector GetVehicleVelocity() const;
 };
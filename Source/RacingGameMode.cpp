@@ -5,6 +5,9 @@
 #include "RacingGameMode.h"
 #include "RacingVehicle.h"
 #include "RaceTrackManager.h"
+#include "AIRacingSubsystem.h"
+#include "RaceProgressSubsystem.h"
+#include "MultiplayerGameState.h"
 #include "Kismet/GameplayStatics.h"
 
 ARacingGameMode::ARacingGameMode()
@@ -16,6 +19,7 @@ ARacingGameMode::ARacingGameMode()
     CountdownTime = 3.0f;
     bEnableAI = false;
     NumberOfAIRacers = 7;
+    RaceSeed = 0;
 
     CurrentRaceState = ERaceState::Waiting;
     RaceTimer = 0.0f;
@@ -36,6 +40,12 @@ void ARacingGameMode::BeginPlay()
         UE_LOG(LogTemp, Warning, TEXT("No RaceTrackManager found in level!"));
     }
 
+    // Replicate positions to clients in multiplayer; the game mode only exists on the server
+    if (AMultiplayerGameState* MultiplayerState = GetGameState<AMultiplayerGameState>())
+    {
+        MultiplayerState->BindToRaceStandings(this);
+    }
+
     // Find and register all racing vehicles
     TArray<AActor*> FoundVehicles;
     UGameplayStatics::GetAllActorsOfClass(GetWorld(), ARacingVehicle::StaticClass(), FoundVehicles);
@@ -49,7 +59,7 @@ void ARacingGameMode::BeginPlay()
         }
     }
 
-    UE_LOG(LogTemp, Log, TEXT("Racing Game Mode initialized with %d racers"), RacerDataList.Num());
+    UE_LOG(LogTemp, Log, TEXT("Racing Game Mode initialized with %d racers"), Standings.Num());
 }
 
 void ARacingGameMode::Tick(float DeltaTime)
@@ -86,6 +96,18 @@ void ARacingGameMode::StartRace()
     CountdownTimer = CountdownTime;
     OnRaceStateChanged.Broadcast(CurrentRaceState);
 
+    // Reseed every AI driver so the race can be replayed from the logged seed
+    if (UAIRacingSubsystem* AIRacing = GetWorld()->GetSubsystem<UAIRacingSubsystem>())
+    {
+        AIRacing->SetRaceSeed(RaceSeed != 0 ? RaceSeed : AIRacing->GetRaceSeed());
+    }
+
+    // Positions and rubber-banding count race progress from the grid
+    if (URaceProgressSubsystem* RaceProgress = GetWorld()->GetSubsystem<URaceProgressSubsystem>())
+    {
+        RaceProgress->ResetProgress();
+    }
+
     UE_LOG(LogTemp, Log, TEXT("Race countdown started"));
 }
 
@@ -95,10 +117,10 @@ void ARacingGameMode::EndRace()
     OnRaceStateChanged.Broadcast(CurrentRaceState);
 
     // Determine winner
-    if (RacerDataList.Num() > 0)
+    if (Standings.Num() > 0)
     {
         UpdateRacerPositions();
-        FRacerData WinnerData = RacerDataList[0];
+        FRacerData WinnerData = RacerDataList[Standings[0]];
         OnRaceFinished.Broadcast(WinnerData.Vehicle);
         
         UE_LOG(LogTemp, Log, TEXT("Race finished! Winner: %s"), 
@@ -136,6 +158,9 @@ void ARacingGameMode::RestartRace()
         Data.TotalRaceTime = 0.0f;
         Data.CheckpointsHit = 0;
         Data.Position = 0;
+        Data.RaceProgress = 0.0f;
+        Data.GapToLeader = 0.0f;
+        Data.IntervalToAhead = 0.0f;
     }
 
     RaceTimer = 0.0f;
@@ -154,87 +179,186 @@ void ARacingGameMode::RegisterRacer(ARacingVehicle* Racer)
     if (!Racer)
         return;
 
-    FRacerData NewData;
+    // The racer registry hands out the slot every per-racer array is indexed by
+    URaceProgressSubsystem* RaceProgress = GetWorld()->GetSubsystem<URaceProgressSubsystem>();
+    const int32 Slot = RaceProgress ? RaceProgress->RegisterVehicle(Racer) : INDEX_NONE;
+    if (Slot == INDEX_NONE)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Cannot register racer %s: no racer registry in this world"), *Racer->GetName());
+        return;
+    }
+
+    if (Slot >= RacerDataList.Num())
+    {
+        RacerDataList.SetNum(Slot + 1);
+    }
+    else if (RacerDataList[Slot].Vehicle == Racer)
+    {
+        return;
+    }
+
+    FRacerData& NewData = RacerDataList[Slot];
+    NewData = FRacerData();
     NewData.Vehicle = Racer;
-    NewData.Position = RacerDataList.Num() + 1;
+    NewData.Position = Standings.Num() + 1;
     NewData.BestLapTime = FLT_MAX;
 
-    RacerDataList.Add(NewData);
+    Standings.Add(Slot);
+    OnRacerPositionChanged.Broadcast(Racer, NewData.Position, 0);
 
     UE_LOG(LogTemp, Log, TEXT("Registered racer: %s"), *Racer->GetName());
 }
 
-void ARacingGameMode::UpdateRacerCheckpoint(ARacingVehicle* Racer, int32 CheckpointIndex)
+void ARacingGameMode::UnregisterRacer(ARacingVehicle* Racer)
 {
-    for (FRacerData& Data : RacerDataList)
+    FRacerData* Data = FindRacerData(Racer);
+    if (Data)
     {
-        if (Data.Vehicle == Racer)
+        const int32 Index = Standings.Find(Racer->GetRacerSlot());
+        Standings.RemoveAt(Index);
+        *Data = FRacerData();
+
+        // Listeners see the whole new order
+        TArray<TPair<int32, int32>, TInlineAllocator<8>> Moved; // slot, old position
+        for (int32 i = Index; i < Standings.Num(); i++)
         {
-            Data.CheckpointsHit = CheckpointIndex;
-            break;
+            FRacerData& Behind = RacerDataList[Standings[i]];
+            Moved.Emplace(Standings[i], Behind.Position);
+            Behind.Position = i + 1;
         }
+        for (const TPair<int32, int32>& Move : Moved)
+        {
+            const FRacerData& Behind = RacerDataList[Move.Key];
+            OnRacerPositionChanged.Broadcast(Behind.Vehicle, Behind.Position, Move.Value);
+        }
+
+        UE_LOG(LogTemp, Log, TEXT("Unregistered racer: %s"), *Racer->GetName());
+    }
+
+    // The slot goes back to the registry last, so it is never reused while still in the standings
+    if (URaceProgressSubsystem* RaceProgress = GetWorld()->GetSubsystem<URaceProgressSubsystem>())
+    {
+        RaceProgress->UnregisterVehicle(Racer);
     }
 }
 
-void ARacingGameMode::OnRacerCompleteLap(ARacingVehicle* Racer, float LapTime)
+void ARacingGameMode::UpdateRacerCheckpoint(ARacingVehicle* Racer, int32 CheckpointIndex)
 {
-    for (FRacerData& Data : RacerDataList)
+    if (FRacerData* Data = FindRacerData(Racer))
     {
-        if (Data.Vehicle == Racer)
-        {
-            Data.CurrentLap++;
-            Data.CurrentLapTime = 0.0f;
-            Data.CheckpointsHit = 0;
-
-            // Update best lap time
-            if (LapTime < Data.BestLapTime)
-            {
-                Data.BestLapTime = LapTime;
-            }
+        Data->CheckpointsHit = CheckpointIndex;
+    }
+}
 
-            OnLapCompleted.Broadcast(Racer, LapTime);
+void ARacingGameMode::OnRacerCompleteLap(ARacingVehicle* Racer, float LapTime)
+{
+    FRacerData* Data = FindRacerData(Racer);
+    if (!Data)
+        return;
 
-            UE_LOG(LogTemp, Log, TEXT("%s completed lap %d in %.2f seconds"), 
-                *Racer->GetName(), Data.CurrentLap, LapTime);
+    Data->CurrentLap++;
+    Data->CurrentLapTime = 0.0f;
+    Data->CheckpointsHit = 0;
 
-            break;
-        }
+    // Update best lap time
+    if (LapTime < Data->BestLapTime)
+    {
+        Data->BestLapTime = LapTime;
     }
+
+    OnLapCompleted.Broadcast(Racer, LapTime);
+
+    UE_LOG(LogTemp, Log, TEXT("%s completed lap %d in %.2f seconds"), 
+        *Racer->GetName(), Data->CurrentLap, LapTime);
 }
 
 void ARacingGameMode::UpdateRacerPositions()
 {
-    // Sort racers by lap and checkpoint progress
-    RacerDataList.Sort([](const FRacerData& A, const FRacerData& B)
+    const URaceProgressSubsystem* RaceProgress = GetWorld()->GetSubsystem<URaceProgressSubsystem>();
+
+    // Continuous progress along the track; lap and checkpoint count when a car isn't tracked
+    for (int32 Slot : Standings)
     {
-        if (A.CurrentLap != B.CurrentLap)
-            return A.CurrentLap > B.CurrentLap;
-        
-        return A.CheckpointsHit > B.CheckpointsHit;
-    });
+        FRacerData& Data = RacerDataList[Slot];
+        Data.bProgressMeasured = RaceProgress && RaceProgress->GetProgress(Data.Vehicle, Data.RaceProgress);
+        if (!Data.bProgressMeasured)
+        {
+            const int32 Checkpoints = TrackManager ? FMath::Max(TrackManager->TotalCheckpoints, 1) : 1;
+            Data.RaceProgress = Data.CurrentLap + static_cast<float>(Data.CheckpointsHit) / Checkpoints;
+        }
+    }
+
+    // The two measures don't compare, so measured racers are ranked among themselves
+    // and the rest among themselves behind them
+    auto IsAhead = [this](int32 Slot, int32 Other)
+    {
+        const FRacerData& Data = RacerDataList[Slot];
+        const FRacerData& OtherData = RacerDataList[Other];
+        if (Data.bProgressMeasured != OtherData.bProgressMeasured)
+        {
+            return Data.bProgressMeasured;
+        }
+        return Data.RaceProgress > OtherData.RaceProgress;
+    };
+
+    // Progress barely changes between frames, so the order is nearly sorted already:
+    // move each racer up past the neighbours it overtook (no moves when nobody did)
+    for (int32 i = 1; i < Standings.Num(); i++)
+    {
+        const int32 Slot = Standings[i];
+
+        int32 j = i;
+        while (j > 0 && IsAhead(Slot, Standings[j - 1]))
+        {
+            Standings[j] = Standings[j - 1];
+            j--;
+        }
+        Standings[j] = Slot;
+    }
+
+    // Update positions and timing-screen gaps, remembering who moved
+    TArray<TPair<int32, int32>, TInlineAllocator<8>> Moved; // slot, old position
+    for (int32 i = 0; i < Standings.Num(); i++)
+    {
+        FRacerData& Data = RacerDataList[Standings[i]];
+        if (Data.Position != i + 1)
+        {
+            Moved.Emplace(Standings[i], Data.Position);
+            Data.Position = i + 1;
+        }
+        Data.GapToLeader = RaceProgress && i > 0 ? RaceProgress->GetTimeGap(Data.Vehicle, RacerDataList[Standings[0]].Vehicle) : 0.0f;
+        Data.IntervalToAhead = RaceProgress && i > 0 ? RaceProgress->GetTimeGap(Data.Vehicle, RacerDataList[Standings[i - 1]].Vehicle) : 0.0f;
+    }
 
-    // Update positions
-    for (int32 i = 0; i < RacerDataList.Num(); i++)
+    // Listeners see the whole new order
+    for (const TPair<int32, int32>& Move : Moved)
     {
-        RacerDataList[i].Position = i + 1;
+        const FRacerData& Data = RacerDataList[Move.Key];
+        OnRacerPositionChanged.Broadcast(Data.Vehicle, Data.Position, Move.Value);
     }
 }
 
 FRacerData ARacingGameMode::GetRacerData(ARacingVehicle* Racer)
 {
-    for (const FRacerData& Data : RacerDataList)
+    const FRacerData* Data = FindRacerData(Racer);
+    return Data ? *Data : FRacerData();
+}
+
+TArray<FRacerData> ARacingGameMode::GetLeaderboard()
+{
+    TArray<FRacerData> Leaderboard;
+    Leaderboard.Reserve(Standings.Num());
+    for (int32 Slot : Standings)
     {
-        if (Data.Vehicle == Racer)
-        {
-            return Data;
-        }
+        Leaderboard.Add(RacerDataList[Slot]);
     }
-    return FRacerData();
+    return Leaderboard;
 }
 
-TArray<FRacerData> ARacingGameMode::GetLeaderboard()
+FRacerData* ARacingGameMode::FindRacerData(const ARacingVehicle* Racer)
 {
-    return RacerDataList;
+    const int32 Slot = Racer ? Racer->GetRacerSlot() : INDEX_NONE;
+    return RacerDataList.IsValidIndex(Slot) && RacerDataList[Slot].Vehicle == Racer ? &RacerDataList[Slot] : nullptr;
 }
 
 // ============================================================
@@ -258,18 +382,18 @@ void ARacingGameMode::UpdateRaceTimer(float DeltaTime)
     RaceTimer += DeltaTime;
 
     // Update individual racer times
-    for (FRacerData& Data : RacerDataList)
+    for (int32 Slot : Standings)
     {
-        Data.TotalRaceTime += DeltaTime;
-        Data.CurrentLapTime += DeltaTime;
+        RacerDataList[Slot].TotalRaceTime += DeltaTime;
+        RacerDataList[Slot].CurrentLapTime += DeltaTime;
     }
 }
 
 void ARacingGameMode::CheckRaceCompletion()
 {
-    for (const FRacerData& Data : RacerDataList)
+    for (int32 Slot : Standings)
     {
-        if (Data.CurrentLap >= TotalLaps)
+        if (RacerDataList[Slot].CurrentLap >= TotalLaps)
         {
             EndRace();
             break;
@@ -47,9 +47,26 @@ struct FRacerData
     UPROPERTY(BlueprintReadOnly)
     int32 CheckpointsHit;
 
+    /** Laps since the start line (lap + fraction); positions are ranked by it */
+    UPROPERTY(BlueprintReadOnly)
+    float RaceProgress;
+
+    /** RaceProgress is measured along the racing line; otherwise it counts laps and checkpoints, and the racer ranks behind every measured one */
+    UPROPERTY(BlueprintReadOnly)
+    bool bProgressMeasured;
+
+    /** Seconds behind the leader */
+    UPROPERTY(BlueprintReadOnly)
+    float GapToLeader;
+
+    /** Seconds behind the racer one position ahead */
+    UPROPERTY(BlueprintReadOnly)
+    float IntervalToAhead;
+
     FRacerData()
         : Vehicle(nullptr), Position(0), CurrentLap(0), 
-          CurrentLapTime(0.f), BestLapTime(0.f), TotalRaceTime(0.f), CheckpointsHit(0)
+          CurrentLapTime(0.f), BestLapTime(0.f), TotalRaceTime(0.f), CheckpointsHit(0),
+          RaceProgress(0.f), bProgressMeasured(false), GapToLeader(0.f), IntervalToAhead(0.f)
     {
     }
 };
@@ -84,15 +101,16 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Race Settings")
     int32 NumberOfAIRacers;
 
+    /** Seed for AI mistakes and overtakes, applied when the race starts (0 = keep the world's seed) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Race Settings")
+    int32 RaceSeed;
+
     UPROPERTY(BlueprintReadOnly, Category = "Race State")
     ERaceState CurrentRaceState;
 
     UPROPERTY(BlueprintReadOnly, Category = "Race State")
     float RaceTimer;
 
-    UPROPERTY(BlueprintReadOnly, Category = "Race State")
-    TArray<FRacerData> RacerDataList;
-
     // ============================================================
     // RACE CONTROL
     // ============================================================
@@ -119,21 +137,30 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Race Tracking")
     void RegisterRacer(ARacingVehicle* Racer);
 
+    /** Drop a racer from the standings and the racer registry; everyone behind it moves up */
+    UFUNCTION(BlueprintCallable, Category = "Race Tracking")
+    void UnregisterRacer(ARacingVehicle* Racer);
+
     UFUNCTION(BlueprintCallable, Category = "Race Tracking")
     void UpdateRacerCheckpoint(ARacingVehicle* Racer, int32 CheckpointIndex);
 
     UFUNCTION(BlueprintCallable, Category = "Race Tracking")
     void OnRacerCompleteLap(ARacingVehicle* Racer, float LapTime);
 
+    /** Refresh race progress and move racers past the neighbours they overtook; fires OnRacerPositionChanged */
     UFUNCTION(BlueprintCallable, Category = "Race Tracking")
     void UpdateRacerPositions();
 
     UFUNCTION(BlueprintCallable, Category = "Race Tracking")
     FRacerData GetRacerData(ARacingVehicle* Racer);
 
+    /** Every registered racer's data in position order */
     UFUNCTION(BlueprintCallable, Category = "Race Tracking")
     TArray<FRacerData> GetLeaderboard();
 
+    UFUNCTION(BlueprintCallable, Category = "Race Tracking")
+    int32 GetNumRacers() const { return Standings.Num(); }
+
     // ============================================================
     // EVENTS
     // ============================================================
@@ -150,10 +177,25 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "Race Events")
     FOnRaceFinished OnRaceFinished;
 
+    /** A racer's position changed; OldPosition is 0 when it has just registered */
+    DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnRacerPositionChanged, ARacingVehicle*, Racer, int32, NewPosition, int32, OldPosition);
+    UPROPERTY(BlueprintAssignable, Category = "Race Events")
+    FOnRacerPositionChanged OnRacerPositionChanged;
+
 private:
     float CountdownTimer;
     ARaceTrackManager* TrackManager;
 
+    // Every racer's data, indexed by ARacingVehicle::GetRacerSlot(); unused slots have no Vehicle
+    UPROPERTY()
+    TArray<FRacerData> RacerDataList;
+
+    // Racer slots in position order
+    TArray<int32> Standings;
+
+    /** Racer's entry in RacerDataList, null when it isn't registered */
+    FRacerData* FindRacerData(const ARacingVehicle* Racer);
+
     void UpdateCountdown(float DeltaTime);
     void UpdateRaceTimer(float DeltaTime);
     void CheckRaceCompletion();
@@ -46,21 +46,44 @@ void URacingHUDWidget::NativeConstruct()
     BestLapTimeString = TEXT("--:--.---");
     LastLapTimeString = TEXT("--:--.---");
 
-    // Cache game mode
+    // Cache game mode and follow its standings and lap events
     CachedGameMode = Cast<ARacingGameMode>(UGameplayStatics::GetGameMode(GetWorld()));
+    if (CachedGameMode)
+    {
+        CachedGameMode->OnRacerPositionChanged.AddUniqueDynamic(this, &URacingHUDWidget::HandleRacerPositionChanged);
+        CachedGameMode->OnLapCompleted.AddUniqueDynamic(this, &URacingHUDWidget::HandleLapCompleted);
+        CachedGameMode->OnRaceStateChanged.AddUniqueDynamic(this, &URacingHUDWidget::HandleRaceStateChanged);
+    }
 
     UE_LOG(LogTemp, Log, TEXT("Racing HUD Widget initialized"));
 }
 
+void URacingHUDWidget::NativeDestruct()
+{
+    if (CachedGameMode)
+    {
+        CachedGameMode->OnRacerPositionChanged.RemoveDynamic(this, &URacingHUDWidget::HandleRacerPositionChanged);
+        CachedGameMode->OnLapCompleted.RemoveDynamic(this, &URacingHUDWidget::HandleLapCompleted);
+        CachedGameMode->OnRaceStateChanged.RemoveDynamic(this, &URacingHUDWidget::HandleRaceStateChanged);
+    }
+
+    Super::NativeDestruct();
+}
+
 void URacingHUDWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
 {
     Super::NativeTick(MyGeometry, InDeltaTime);
 
-    // Get player's vehicle
+    // Get player's vehicle; race data is read once, then kept current by events
     if (!CachedVehicle)
     {
         APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(GetWorld(), 0);
         CachedVehicle = Cast<ARacingVehicle>(PlayerPawn);
+
+        if (CachedVehicle)
+        {
+            UpdateRaceData();
+        }
     }
 
     if (CachedVehicle)
@@ -68,7 +91,23 @@ void URacingHUDWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime
         UpdateVehicleData(CachedVehicle);
     }
 
-    UpdateRaceData();
+    // Lap clock runs on game time, like the game mode's; lap events zero it
+    if (CachedGameMode)
+    {
+        switch (CachedGameMode->CurrentRaceState)
+        {
+        case ERaceState::Racing:
+            CurrentLapTime += GetWorld()->GetDeltaSeconds();
+            break;
+        case ERaceState::Waiting:
+        case ERaceState::Countdown:
+            CurrentLapTime = 0.0f;
+            break;
+        default:
+            break;
+        }
+        CurrentLapTimeString = FormatTime(CurrentLapTime);
+    }
 }
 
 // ============================================================
@@ -80,11 +119,12 @@ void URacingHUDWidget::UpdateVehicleData(ARacingVehicle* Vehicle)
     if (!Vehicle)
         return;
 
-    // Get telemetry from vehicle
-    FVehicleTelemetry Telemetry = Vehicle->GetTelemetry();
+    // Published once per frame by the vehicle; no copy, no body query
+    const FVehicleFrameState& State = Vehicle->GetFrameState();
+    const FVehicleTelemetry& Telemetry = State.Telemetry;
 
     // Update speed
-    Speed = Telemetry.Speed;
+    Speed = State.Speed;
     SpeedKMH = Speed;
     SpeedMPH = Speed * 0.621371f;
 
@@ -117,7 +157,7 @@ void URacingHUDWidget::UpdateRaceData()
     CurrentLap = RacerData.CurrentLap;
     TotalLaps = CachedGameMode->TotalLaps;
     CurrentPosition = RacerData.Position;
-    TotalRacers = CachedGameMode->RacerDataList.Num();
+    TotalRacers = CachedGameMode->GetNumRacers();
 
     // Update lap times
     CurrentLapTime = RacerData.CurrentLapTime;
@@ -128,21 +168,56 @@ void URacingHUDWidget::UpdateRaceData()
         BestLapTime = RacerData.BestLapTime;
         BestLapTimeString = FormatTime(BestLapTime);
     }
-
-    // Check for lap completion
-    if (RacerData.CurrentLap > 0 && CurrentLapTime < 1.0f && LastLapTime > 0.0f)
+    else
     {
-        LastLapTimeString = FormatTime(LastLapTime);
-        OnLapCompleted(LastLapTime);
+        BestLapTime = 0.0f;
+        BestLapTimeString = TEXT("--:--.---");
+    }
+}
 
-        // Check for new best lap
-        if (LastLapTime < BestLapTime || BestLapTime == 0.0f)
-        {
-            OnNewBestLap(LastLapTime);
-        }
+void URacingHUDWidget::HandleRacerPositionChanged(ARacingVehicle* Racer, int32 NewPosition, int32 OldPosition)
+{
+    // Any racer joining or moving may change the field size
+    TotalRacers = CachedGameMode ? CachedGameMode->GetNumRacers() : TotalRacers;
+
+    if (!CachedVehicle || Racer != CachedVehicle || NewPosition == CurrentPosition)
+        return;
+
+    CurrentPosition = NewPosition;
+    OnPositionChanged(NewPosition);
+}
+
+void URacingHUDWidget::HandleLapCompleted(ARacingVehicle* Racer, float LapTime)
+{
+    if (!CachedVehicle || Racer != CachedVehicle)
+        return;
+
+    CurrentLap++;
+    CurrentLapTime = 0.0f;
+    CurrentLapTimeString = FormatTime(CurrentLapTime);
+
+    LastLapTime = LapTime;
+    LastLapTimeString = FormatTime(LastLapTime);
+    OnLapCompleted(LapTime);
+
+    // Check for new best lap
+    if (LapTime < BestLapTime || BestLapTime == 0.0f)
+    {
+        BestLapTime = LapTime;
+        BestLapTimeString = FormatTime(BestLapTime);
+        OnNewBestLap(LapTime);
     }
+}
+
+void URacingHUDWidget::HandleRaceStateChanged(ERaceState NewState)
+{
+    // A restart resets every racer without lap or position events, so read it all again
+    if (NewState != ERaceState::Waiting)
+        return;
 
-    LastLapTime = CurrentLapTime;
+    LastLapTime = 0.0f;
+    LastLapTimeString = TEXT("--:--.---");
+    UpdateRaceData();
 }
 
 FString URacingHUDWidget::FormatTime(float TimeInSeconds)
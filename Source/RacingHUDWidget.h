@@ -11,10 +11,16 @@
 class ARacingVehicle;
 class ARacingGameMode;
 struct FVehicleTelemetry;
+enum class ERaceState : uint8;
 
 /**
  * Main HUD widget for racing game
  * Shows speed, RPM, gear, lap times, position, etc.
+ *
+ * Vehicle data is read from the frame state every tick. Race data is not polled:
+ * the widget reads it once when it finds the player's car, then follows the game
+ * mode's position-change and lap events, and runs the lap clock locally in between.
+ * A restart (race state back to Waiting) makes it read the race data again.
  */
 UCLASS()
 class CARGAME_API URacingHUDWidget : public UUserWidget
@@ -23,6 +29,7 @@ class CARGAME_API URacingHUDWidget : public UUserWidget
 
 public:
     virtual void NativeConstruct() override;
+    virtual void NativeDestruct() override;
     virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
 
     // ============================================================
@@ -129,6 +136,7 @@ public:
     UFUNCTION(BlueprintCallable, Category = "HUD")
     void UpdateVehicleData(ARacingVehicle* Vehicle);
 
+    /** Read all race data for the player's car from the game mode; events keep it current afterwards */
     UFUNCTION(BlueprintCallable, Category = "HUD")
     void UpdateRaceData();
 
@@ -145,6 +153,15 @@ public:
     void OnPositionChanged(int32 NewPosition);
 
 private:
+    UFUNCTION()
+    void HandleRacerPositionChanged(ARacingVehicle* Racer, int32 NewPosition, int32 OldPosition);
+
+    UFUNCTION()
+    void HandleLapCompleted(ARacingVehicle* Racer, float LapTime);
+
+    UFUNCTION()
+    void HandleRaceStateChanged(ERaceState NewState);
+
     UPROPERTY()
     ARacingVehicle* CachedVehicle;
 
@@ -0,0 +1,191 @@
+// RacingLine.cpp
+// Shared racing line construction and sampling
+// Copyright 2025. All Rights Reserved.
+
+#include "RacingLine.h"
+#include "AIRacingController.h"
+#include "Algo/BinarySearch.h"
+#include "Misc/Crc.h"
+
+namespace
+{
+    // Lines already built, keyed by a hash of their waypoints. Entries die with their last user.
+    TMap<uint32, TWeakPtr<const FRacingLine, ESPMode::ThreadSafe>> RacingLineCache;
+}
+
+TSharedRef<const FRacingLine, ESPMode::ThreadSafe> FRacingLine::FindOrBuild(const TArray<FVector>& Waypoints)
+{
+    check(IsInGameThread());
+
+    const uint32 Key = FCrc::MemCrc32(Waypoints.GetData(), Waypoints.Num() * sizeof(FVector), Waypoints.Num());
+
+    if (const TWeakPtr<const FRacingLine, ESPMode::ThreadSafe>* Cached = RacingLineCache.Find(Key))
+    {
+        TSharedPtr<const FRacingLine, ESPMode::ThreadSafe> Existing = Cached->Pin();
+        if (Existing.IsValid() && Existing->Positions == Waypoints)
+        {
+            return Existing.ToSharedRef();
+        }
+    }
+
+    // Lines of tracks that have since been torn down; only misses pay for the sweep
+    for (auto It = RacingLineCache.CreateIterator(); It; ++It)
+    {
+        if (!It.Value().IsValid())
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    const double StartSeconds = FPlatformTime::Seconds();
+    TSharedRef<FRacingLine, ESPMode::ThreadSafe> Line = MakeShared<FRacingLine, ESPMode::ThreadSafe>(Waypoints);
+    RacingLineCache.Add(Key, Line);
+
+    UE_LOG(LogTemp, Log, TEXT("Racing line built: %d points, %.0f m, %d braking zones (%.2f ms)"), Line->Num(), Line->GetLength() * 0.01f,
+        Line->GetSpeedProfile(EAIDifficulty::Expert).BrakingPoints.Num(), (FPlatformTime::Seconds() - StartSeconds) * 1000.0);
+    return Line;
+}
+
+FRacingLine::FRacingLine(const TArray<FVector>& Waypoints)
+    : Positions(Waypoints)
+{
+    const int32 NumPoints = Positions.Num();
+
+    Tangents.SetNumUninitialized(NumPoints);
+    ArcLength.SetNumUninitialized(NumPoints + 1);
+    Curvature.SetNumUninitialized(NumPoints);
+
+    ArcLength[0] = 0.0f;
+    for (int32 i = 0; i < NumPoints; i++)
+    {
+        ArcLength[i + 1] = ArcLength[i] + FVector::Dist(Positions[i], Positions[(i + 1) % NumPoints]);
+    }
+
+    for (int32 i = 0; i < NumPoints; i++)
+    {
+        const int32 Next = (i + 1) % NumPoints;
+        const int32 Prev = (i - 1 + NumPoints) % NumPoints;
+
+        const FVector ToNext = (Positions[Next] - Positions[i]).GetSafeNormal();
+        const FVector ToPrev = (Positions[i] - Positions[Prev]).GetSafeNormal();
+
+        Tangents[i] = (ToNext + ToPrev).GetSafeNormal(KINDA_SMALL_NUMBER, ToNext);
+
+        // Turning angle over the mean length of the two segments
+        const float CornerSharpness = FVector::DotProduct(ToNext, ToPrev);
+        const float MeanSegment = 0.5f * (FVector::Dist(Positions[Prev], Positions[i]) + FVector::Dist(Positions[i], Positions[Next]));
+        Curvature[i] = MeanSegment > KINDA_SMALL_NUMBER ? FMath::Acos(FMath::Clamp(CornerSharpness, -1.0f, 1.0f)) / MeanSegment : 0.0f;
+    }
+
+    constexpr int32 NumDifficulties = static_cast<int32>(EAIDifficulty::Impossible) + 1;
+    SpeedProfiles.SetNum(NumDifficulties);
+    for (int32 Difficulty = 0; Difficulty < NumDifficulties; Difficulty++)
+    {
+        SpeedProfiles[Difficulty].Solve(ArcLength, Curvature, FSpeedProfileLimits::ForDifficulty(static_cast<EAIDifficulty>(Difficulty)));
+    }
+
+    SpatialIndex.Build(Positions);
+}
+
+float FRacingLine::WrapDistance(float Distance) const
+{
+    const float Length = GetLength();
+    if (Length <= 0.0f)
+    {
+        return 0.0f;
+    }
+
+    Distance = FMath::Fmod(Distance, Length);
+    return Distance < 0.0f ? Distance + Length : Distance;
+}
+
+int32 FRacingLine::FindSegment(float Distance) const
+{
+    // Last segment whose start is at or before Distance
+    const int32 Upper = Algo::UpperBound(ArcLength, Distance);
+    return FMath::Clamp(Upper - 1, 0, Num() - 1);
+}
+
+float FRacingLine::ProjectNear(const FVector& Location, int32 NearIndex, float* OutLateralOffset) const
+{
+    const int32 NumPoints = Num();
+    if (NumPoints < 2)
+    {
+        if (OutLateralOffset)
+        {
+            *OutLateralOffset = 0.0f;
+        }
+        return 0.0f;
+    }
+
+    const int32 Current = FMath::Clamp(NearIndex, 0, NumPoints - 1);
+
+    // The closest point is an end of the closest segment
+    float BestDistanceSquared = MAX_FLT;
+    float BestArcLength = ArcLength[Current];
+    int32 BestStart = Current;
+    FVector BestClosest = Positions[Current];
+
+    for (int32 Offset = -1; Offset <= 0; Offset++)
+    {
+        const int32 Start = (Current + Offset + NumPoints) % NumPoints;
+        const FVector& A = Positions[Start];
+        const FVector& B = Positions[(Start + 1) % NumPoints];
+
+        const FVector Closest = FMath::ClosestPointOnSegment(Location, A, B);
+        const float DistanceSquared = FVector::DistSquared(Location, Closest);
+        if (DistanceSquared < BestDistanceSquared)
+        {
+            BestDistanceSquared = DistanceSquared;
+            BestArcLength = ArcLength[Start] + FVector::Dist(A, Closest);
+            BestStart = Start;
+            BestClosest = Closest;
+        }
+    }
+
+    if (OutLateralOffset)
+    {
+        const FVector SegmentDirection = Positions[(BestStart + 1) % NumPoints] - Positions[BestStart];
+        const FVector Right = FVector::CrossProduct(FVector::UpVector, SegmentDirection).GetSafeNormal2D();
+        *OutLateralOffset = FVector::DotProduct(Location - BestClosest, Right);
+    }
+
+    return WrapDistance(BestArcLength);
+}
+
+const FRacingSpeedProfile& FRacingLine::GetSpeedProfile(EAIDifficulty Difficulty) const
+{
+    return SpeedProfiles[FMath::Clamp(static_cast<int32>(Difficulty), 0, SpeedProfiles.Num() - 1)];
+}
+
+float FRacingLine::SampleSpeed(EAIDifficulty Difficulty, float Distance) const
+{
+    if (!IsValid())
+    {
+        return 0.0f;
+    }
+
+    Distance = WrapDistance(Distance);
+    return GetSpeedProfile(Difficulty).SampleSpeed(ArcLength, FindSegment(Distance), Distance);
+}
+
+void FRacingLine::Sample(float Distance, FVector& OutLocation, FVector& OutTangent) const
+{
+    if (!IsValid())
+    {
+        OutLocation = FVector::ZeroVector;
+        OutTangent = FVector::ForwardVector;
+        return;
+    }
+
+    Distance = WrapDistance(Distance);
+
+    const int32 Segment = FindSegment(Distance);
+    const int32 Next = (Segment + 1) % Num();
+
+    const float SegmentLength = ArcLength[Segment + 1] - ArcLength[Segment];
+    const float Alpha = SegmentLength > KINDA_SMALL_NUMBER ? (Distance - ArcLength[Segment]) / SegmentLength : 0.0f;
+
+    OutLocation = FMath::Lerp(Positions[Segment], Positions[Next], Alpha);
+    OutTangent = (Positions[Next] - Positions[Segment]).GetSafeNormal(KINDA_SMALL_NUMBER, FVector::ForwardVector);
+}
@@ -0,0 +1,77 @@
+// RacingLine.h
+// Immutable racing line shared by every AI driver on a track
+// Copyright 2025. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RacelineSpatialIndex.h"
+#include "RacingSpeedProfile.h"
+
+/**
+ * A closed racing line with everything the AI derives from it, computed once:
+ * geometry, a nearest-point index and one minimum-time speed profile per AI difficulty.
+ *
+ * Per-point data lives in parallel contiguous arrays (index N in each belongs to
+ * waypoint N). The object never changes after construction, so any number of
+ * controllers and worker threads can read it through a shared reference.
+ * FindOrBuild returns the existing line for identical waypoints, so memory and
+ * setup time do not grow with the number of AI cars.
+ */
+class CARGAME_API FRacingLine
+{
+public:
+    /** Shared line for Waypoints, built on first request. Game thread only. */
+    static TSharedRef<const FRacingLine, ESPMode::ThreadSafe> FindOrBuild(const TArray<FVector>& Waypoints);
+
+    explicit FRacingLine(const TArray<FVector>& Waypoints);
+
+    int32 Num() const { return Positions.Num(); }
+    bool IsValid() const { return Positions.Num() > 2; }
+
+    /** Lap length (cm) */
+    float GetLength() const { return ArcLength.Num() > 0 ? ArcLength.Last() : 0.0f; }
+
+    const TArray<FVector>& GetPositions() const { return Positions; }
+    const TArray<FVector>& GetTangents() const { return Tangents; }
+
+    /** Cumulative distance (cm) at each point; one extra entry holds the lap length */
+    const TArray<float>& GetArcLengths() const { return ArcLength; }
+
+    /** Unsigned curvature (1/cm) at each point */
+    const TArray<float>& GetCurvatures() const { return Curvature; }
+
+    /** Minimum-time speed profile for a difficulty; target speeds in cm/s */
+    const FRacingSpeedProfile& GetSpeedProfile(EAIDifficulty Difficulty) const;
+
+    const FRacelineSpatialIndex& GetSpatialIndex() const { return SpatialIndex; }
+
+    /** Distance wrapped into [0, GetLength()) */
+    float WrapDistance(float Distance) const;
+
+    /** Point index at the start of the segment containing a wrapped Distance */
+    int32 FindSegment(float Distance) const;
+
+    /**
+     * Arc length of the closest point to Location on the two segments either side of point NearIndex.
+     * OutLateralOffset, when given, receives the signed horizontal offset from the line (cm, positive to the right).
+     */
+    float ProjectNear(const FVector& Location, int32 NearIndex, float* OutLateralOffset = nullptr) const;
+
+    /** Position and unit tangent at any arc length */
+    void Sample(float Distance, FVector& OutLocation, FVector& OutTangent) const;
+
+    /** Profile target speed (cm/s) at any arc length */
+    float SampleSpeed(EAIDifficulty Difficulty, float Distance) const;
+
+private:
+    TArray<FVector> Positions;
+    TArray<FVector> Tangents;
+    TArray<float> ArcLength;
+    TArray<float> Curvature;
+
+    // Indexed by EAIDifficulty
+    TArray<FRacingSpeedProfile> SpeedProfiles;
+
+    FRacelineSpatialIndex SpatialIndex;
+};
@@ -0,0 +1,353 @@
+// RacingLineOptimizer.cpp
+// Multilevel projected Gauss-Seidel solve of the minimum-curvature line
+// Copyright 2025. All Rights Reserved.
+
+#include "RacingLineOptimizer.h"
+#include "ProceduralTrackGenerator.h"
+#include "Async/Async.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+    // Hermite samples per layout segment before resampling by arc length
+    constexpr int32 SegmentSubsteps = 16;
+
+    // Coarsest level keeps at least this many points
+    constexpr int32 MinLevelPoints = 8;
+
+    /** Fill the points between a coarse level (2 * FineStride) and the next finer one by linear interpolation */
+    void ProlongOffsets(TArrayView<float> Offsets, TArrayView<const float> Limits, int32 FineStride, bool bClosed)
+    {
+        const int32 NumPoints = Offsets.Num();
+        for (int32 i = FineStride; i < NumPoints; i += 2 * FineStride)
+        {
+            const int32 Next = i + FineStride;
+            const float NextOffset = Next < NumPoints ? Offsets[Next] : (bClosed ? Offsets[0] : Offsets[i - FineStride]);
+            Offsets[i] = FMath::Clamp(0.5f * (Offsets[i - FineStride] + NextOffset), -Limits[i], Limits[i]);
+        }
+    }
+}
+
+// ============================================================
+// SOLVE
+// ============================================================
+
+FRacingLineOptimizerResult FRacingLineOptimizer::Optimize(const FTrackLayout& Layout, const FRacingLineOptimizerSettings& Settings)
+{
+    const double StartTime = FPlatformTime::Seconds();
+    const double Deadline = StartTime + Settings.TimeBudgetSeconds;
+
+    FRacingLineOptimizerResult Result;
+    Result.LayoutHash = HashLayout(Layout);
+
+    TArray<FVector> Centre;
+    TArray<FVector> Normals;
+    TArray<float> HalfWidths;
+    bool bClosed = false;
+    SampleCentreline(Layout, Settings.SampleSpacing, Centre, Normals, HalfWidths, bClosed);
+
+    const int32 NumPoints = Centre.Num();
+    Result.LateralOffsets.SetNumZeroed(NumPoints);
+    if (NumPoints < 3)
+    {
+        Result.Points = Centre;
+        Result.bConverged = true;
+        return Result;
+    }
+
+    TArray<float> Limits;
+    Limits.SetNumUninitialized(NumPoints);
+    for (int32 i = 0; i < NumPoints; i++)
+    {
+        Limits[i] = FMath::Max(HalfWidths[i] - Settings.EdgeMargin, 0.0f);
+    }
+
+    // Coarsest level: CoarseSpacing apart, but never fewer than MinLevelPoints
+    int32 CoarseStride = 1;
+    while (Settings.SampleSpacing * CoarseStride * 2 <= Settings.CoarseSpacing && NumPoints / (CoarseStride * 2) >= MinLevelPoints)
+    {
+        CoarseStride *= 2;
+    }
+
+    TArray<float>& Offsets = Result.LateralOffsets;
+    for (int32 Stride = CoarseStride; Stride >= 1; Stride /= 2)
+    {
+        if (Stride < CoarseStride)
+        {
+            ProlongOffsets(Offsets, Limits, Stride, bClosed);
+        }
+        if (!bClosed)
+        {
+            // Point-to-point: start and finish stay on the centreline
+            Offsets.Last() = 0.0f;
+        }
+
+        // Past the deadline each level still gets one sweep, so the line is always smooth
+        bool bLevelConverged = false;
+        Result.Iterations += SolveLevel(Centre, Normals, Limits, Offsets, Stride, bClosed,
+            Settings.MaxIterationsPerLevel, Settings.Tolerance, Deadline, bLevelConverged);
+        Result.bConverged = bLevelConverged;
+    }
+
+    Result.Points.SetNumUninitialized(NumPoints);
+    for (int32 i = 0; i < NumPoints; i++)
+    {
+        Result.Points[i] = Centre[i] + Normals[i] * Offsets[i];
+    }
+
+    Result.CentrelineMaxCurvature = GetMaxCurvature(Centre, bClosed);
+    Result.MaxCurvature = GetMaxCurvature(Result.Points, bClosed);
+    Result.SolveSeconds = FPlatformTime::Seconds() - StartTime;
+
+    UE_LOG(LogTemp, Log, TEXT("Racing line optimized: %d points, %d sweeps, peak curvature %.4f -> %.4f 1/m, %.1f ms%s"),
+        NumPoints, Result.Iterations, Result.CentrelineMaxCurvature * 100.0f, Result.MaxCurvature * 100.0f,
+        Result.SolveSeconds * 1000.0, Result.bConverged ? TEXT("") : TEXT(" (not converged)"));
+
+    return Result;
+}
+
+TFuture<FRacingLineOptimizerResult> FRacingLineOptimizer::OptimizeAsync(const FTrackLayout& Layout, const FRacingLineOptimizerSettings& Settings)
+{
+    return Async(EAsyncExecution::ThreadPool, [Layout, Settings]()
+    {
+        return Optimize(Layout, Settings);
+    });
+}
+
+int32 FRacingLineOptimizer::SolveLevel(TArrayView<const FVector> Centre, TArrayView<const FVector> Normals, TArrayView<const float> Limits,
+    TArrayView<float> Offsets, int32 Stride, bool bClosed, int32 MaxIterations, float Tolerance, double Deadline, bool& bOutConverged)
+{
+    bOutConverged = false;
+
+    const int32 NumLevelPoints = (Centre.Num() + Stride - 1) / Stride;
+    if (NumLevelPoints < (bClosed ? 5 : 3))
+    {
+        bOutConverged = true;
+        return 0;
+    }
+
+    // Level point j is fine point j * Stride
+    TArray<FVector> Positions;
+    Positions.SetNumUninitialized(NumLevelPoints);
+    for (int32 j = 0; j < NumLevelPoints; j++)
+    {
+        const int32 i = j * Stride;
+        Positions[j] = Centre[i] + Normals[i] * Offsets[i];
+    }
+
+    auto Wrap = [NumLevelPoints](int32 j)
+    {
+        return j < 0 ? j + NumLevelPoints : (j >= NumLevelPoints ? j - NumLevelPoints : j);
+    };
+    auto HasSecondDifference = [bClosed, NumLevelPoints](int32 j)
+    {
+        return bClosed || (j >= 1 && j <= NumLevelPoints - 2);
+    };
+    auto SecondDifference = [&Positions, &Wrap](int32 j)
+    {
+        return Positions[Wrap(j - 1)] - 2.0f * Positions[Wrap(j)] + Positions[Wrap(j + 1)];
+    };
+
+    int32 Sweeps = 0;
+    while (Sweeps < MaxIterations)
+    {
+        float MaxChange = 0.0f;
+
+        for (int32 j = 0; j < NumLevelPoints; j++)
+        {
+            if (!bClosed && (j == 0 || j == NumLevelPoints - 1))
+            {
+                continue;
+            }
+
+            // Point j moves three second differences with weights 1, -2, 1; take the exact
+            // minimizing step along its normal, then clamp it to the track
+            const int32 i = j * Stride;
+            const FVector& Normal = Normals[i];
+
+            float Gradient = 0.0f;
+            float Weight = 0.0f;
+            for (int32 k = -1; k <= 1; k++)
+            {
+                if (HasSecondDifference(j + k))
+                {
+                    const float Coefficient = k == 0 ? -2.0f : 1.0f;
+                    Gradient += Coefficient * FVector::DotProduct(SecondDifference(j + k), Normal);
+                    Weight += Coefficient * Coefficient;
+                }
+            }
+
+            const float NewOffset = FMath::Clamp(Offsets[i] - Gradient / Weight, -Limits[i], Limits[i]);
+            const float Change = NewOffset - Offsets[i];
+            if (Change != 0.0f)
+            {
+                Offsets[i] = NewOffset;
+                Positions[j] += Normal * Change;
+                MaxChange = FMath::Max(MaxChange, FMath::Abs(Change));
+            }
+        }
+
+        Sweeps++;
+
+        if (MaxChange < Tolerance)
+        {
+            bOutConverged = true;
+            break;
+        }
+        if (FPlatformTime::Seconds() > Deadline)
+        {
+            break;
+        }
+    }
+
+    return Sweeps;
+}
+
+float FRacingLineOptimizer::GetMaxCurvature(TArrayView<const FVector> Points, bool bClosed)
+{
+    const int32 NumPoints = Points.Num();
+    float MaxCurvature = 0.0f;
+
+    for (int32 i = bClosed ? 0 : 1; i < (bClosed ? NumPoints : NumPoints - 1); i++)
+    {
+        const FVector& Previous = Points[(i + NumPoints - 1) % NumPoints];
+        const FVector& Next = Points[(i + 1) % NumPoints];
+        const float Spacing = 0.5f * (FVector::Dist(Previous, Points[i]) + FVector::Dist(Points[i], Next));
+        if (Spacing > KINDA_SMALL_NUMBER)
+        {
+            MaxCurvature = FMath::Max(MaxCurvature, (Previous - 2.0f * Points[i] + Next).Size() / FMath::Square(Spacing));
+        }
+    }
+
+    return MaxCurvature;
+}
+
+// ============================================================
+// LAYOUT
+// ============================================================
+
+void FRacingLineOptimizer::SampleCentreline(const FTrackLayout& Layout, float Spacing, TArray<FVector>& OutPoints,
+    TArray<FVector>& OutNormals, TArray<float>& OutHalfWidths, bool& bOutClosed)
+{
+    OutPoints.Reset();
+    OutNormals.Reset();
+    OutHalfWidths.Reset();
+
+    const TArray<FTrackSegment>& Segments = Layout.Segments;
+    bOutClosed = Segments.Num() > 1
+        && FVector::DistSquared(Segments.Last().EndLocation, Segments[0].StartLocation) < FMath::Square(Spacing);
+    if (Segments.Num() == 0 || Spacing <= 0.0f)
+    {
+        return;
+    }
+
+    // Dense polyline through every segment's Hermite curve
+    TArray<FVector> Dense;
+    TArray<float> DenseHalfWidth;
+    Dense.Reserve(Segments.Num() * SegmentSubsteps + 2);
+    DenseHalfWidth.Reserve(Segments.Num() * SegmentSubsteps + 2);
+
+    for (int32 SegmentIndex = 0; SegmentIndex < Segments.Num(); SegmentIndex++)
+    {
+        const FTrackSegment& Segment = Segments[SegmentIndex];
+        const float Chord = FVector::Dist(Segment.StartLocation, Segment.EndLocation);
+        const FVector StartTangent = Segment.StartTangent.GetSafeNormal() * Chord;
+        const FVector EndTangent = Segment.EndTangent.GetSafeNormal() * Chord;
+        const float HalfWidth = Segment.TrackWidth * 50.0f; // full width in m to half width in cm
+
+        // Each segment starts where the previous one ended
+        for (int32 Step = SegmentIndex == 0 ? 0 : 1; Step <= SegmentSubsteps; Step++)
+        {
+            const float Alpha = static_cast<float>(Step) / SegmentSubsteps;
+            Dense.Add(FMath::CubicInterp(Segment.StartLocation, StartTangent, Segment.EndLocation, EndTangent, Alpha));
+            DenseHalfWidth.Add(HalfWidth);
+        }
+    }
+
+    // Close the loop back onto the first point
+    if (bOutClosed)
+    {
+        if (Dense.Num() > 1 && FVector::DistSquared(Dense.Last(), Dense[0]) < 1.0f)
+        {
+            Dense.Pop(false);
+            DenseHalfWidth.Pop(false);
+        }
+        Dense.Add(Dense[0]);
+        DenseHalfWidth.Add(DenseHalfWidth[0]);
+    }
+
+    TArray<float> DenseArc;
+    DenseArc.SetNumUninitialized(Dense.Num());
+    DenseArc[0] = 0.0f;
+    for (int32 i = 1; i < Dense.Num(); i++)
+    {
+        DenseArc[i] = DenseArc[i - 1] + FVector::Dist(Dense[i - 1], Dense[i]);
+    }
+
+    // Even spacing as close to Spacing as divides the length
+    const float TotalLength = DenseArc.Last();
+    const int32 NumIntervals = FMath::Max(FMath::RoundToInt(TotalLength / Spacing), bOutClosed ? 3 : 1);
+    const int32 NumPoints = bOutClosed ? NumIntervals : NumIntervals + 1;
+    const float Step = TotalLength / NumIntervals;
+
+    OutPoints.SetNumUninitialized(NumPoints);
+    OutHalfWidths.SetNumUninitialized(NumPoints);
+
+    int32 Cursor = 0;
+    for (int32 n = 0; n < NumPoints; n++)
+    {
+        const float Distance = n * Step;
+        while (Cursor < Dense.Num() - 2 && DenseArc[Cursor + 1] < Distance)
+        {
+            Cursor++;
+        }
+
+        const float SegmentLength = DenseArc[Cursor + 1] - DenseArc[Cursor];
+        const float Alpha = SegmentLength > 0.0f ? FMath::Clamp((Distance - DenseArc[Cursor]) / SegmentLength, 0.0f, 1.0f) : 0.0f;
+        OutPoints[n] = FMath::Lerp(Dense[Cursor], Dense[Cursor + 1], Alpha);
+        OutHalfWidths[n] = FMath::Lerp(DenseHalfWidth[Cursor], DenseHalfWidth[Cursor + 1], Alpha);
+    }
+
+    // Right-pointing normals from central differences
+    OutNormals.SetNumUninitialized(NumPoints);
+    for (int32 n = 0; n < NumPoints; n++)
+    {
+        const int32 Previous = bOutClosed ? (n + NumPoints - 1) % NumPoints : FMath::Max(n - 1, 0);
+        const int32 Next = bOutClosed ? (n + 1) % NumPoints : FMath::Min(n + 1, NumPoints - 1);
+        const FVector Tangent = OutPoints[Next] - OutPoints[Previous];
+        OutNormals[n] = FVector::CrossProduct(FVector::UpVector, Tangent).GetSafeNormal2D();
+    }
+}
+
+int32 FRacingLineOptimizer::HashLayout(const FTrackLayout& Layout)
+{
+    uint32 Hash = GetTypeHash(Layout.Segments.Num());
+    for (const FTrackSegment& Segment : Layout.Segments)
+    {
+        Hash = HashCombine(Hash, GetTypeHash(Segment.StartLocation));
+        Hash = HashCombine(Hash, GetTypeHash(Segment.EndLocation));
+        Hash = HashCombine(Hash, GetTypeHash(Segment.StartTangent));
+        Hash = HashCombine(Hash, GetTypeHash(Segment.EndTangent));
+        Hash = HashCombine(Hash, GetTypeHash(Segment.TrackWidth));
+    }
+
+    // 0 marks a layout that was never optimized
+    return Hash != 0 ? static_cast<int32>(Hash) : 1;
+}
+
+bool FRacingLineOptimizer::HasCachedRacingLine(const FTrackLayout& Layout)
+{
+    return Layout.OptimizedRacingLine.Num() > 0 && Layout.OptimizedRacingLineHash == HashLayout(Layout);
+}
+
+bool FRacingLineOptimizer::StoreInLayout(FTrackLayout& Layout, const FRacingLineOptimizerResult& Result)
+{
+    if (Result.LayoutHash != HashLayout(Layout))
+    {
+        return false;
+    }
+
+    Layout.OptimizedRacingLine = Result.Points;
+    Layout.OptimizedRacingLineHash = Result.LayoutHash;
+    return true;
+}
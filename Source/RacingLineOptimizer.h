@@ -0,0 +1,108 @@
+// RacingLineOptimizer.h
+// Offline minimum-curvature racing line for generated track layouts
+// Copyright 2025. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+
+struct FTrackLayout;
+
+/**
+ * Solver settings. Distances in cm.
+ */
+struct CARGAME_API FRacingLineOptimizerSettings
+{
+    /** Spacing of the optimized points */
+    float SampleSpacing = 500.0f;
+
+    /** Spacing of the coarsest level; each finer level halves it */
+    float CoarseSpacing = 4000.0f;
+
+    /** Kept clear of each track edge (half a car plus the kerb) */
+    float EdgeMargin = 150.0f;
+
+    /** Sweeps per level before moving on */
+    int32 MaxIterationsPerLevel = 400;
+
+    /** A level has converged once no offset moves further than this in a sweep */
+    float Tolerance = 0.05f;
+
+    /** The solve stops refining past this and returns the best line so far (s) */
+    float TimeBudgetSeconds = 0.5f;
+};
+
+/**
+ * Optimized line and how the solve went
+ */
+struct CARGAME_API FRacingLineOptimizerResult
+{
+    /** Racing line points, SampleSpacing apart */
+    TArray<FVector> Points;
+
+    /** Signed offset of each point from the centreline (cm, positive to the right) */
+    TArray<float> LateralOffsets;
+
+    /** FRacingLineOptimizer::HashLayout of the layout that was solved */
+    int32 LayoutHash = 0;
+
+    /** Peak curvature of the centreline and of the optimized line (1/cm) */
+    float CentrelineMaxCurvature = 0.0f;
+    float MaxCurvature = 0.0f;
+
+    int32 Iterations = 0;
+    double SolveSeconds = 0.0;
+    bool bConverged = false;
+};
+
+/**
+ * Minimum-curvature racing line inside the track width.
+ *
+ * The line is the centreline shifted sideways by one offset per point. The offsets
+ * minimize the sum of squared second differences (discrete curvature) subject to
+ * |offset| <= half width - EdgeMargin. Every point couples only to its two neighbours
+ * either side, so the system is a sparse banded one, solved by projected Gauss-Seidel
+ * sweeps that clamp each offset to the track as they go.
+ *
+ * Plain Gauss-Seidel converges slowly on long lines, so the solve runs coarse to fine:
+ * every 2^k-th point first, then each level starts from the interpolated coarser answer.
+ * TimeBudgetSeconds bounds the solve; every run logs its point count, sweeps and time.
+ *
+ * The result is cached in FTrackLayout::OptimizedRacingLine, keyed by a hash of the
+ * segments, so saved layouts load with their line and only edited ones are solved again.
+ * ARaceTrackManager::SetTrackLayout uses the cached line or solves one with OptimizeAsync.
+ */
+class CARGAME_API FRacingLineOptimizer
+{
+public:
+    /** Solve on the calling thread */
+    static FRacingLineOptimizerResult Optimize(const FTrackLayout& Layout, const FRacingLineOptimizerSettings& Settings = FRacingLineOptimizerSettings());
+
+    /** Solve on the thread pool; the layout is copied, so the caller may keep editing its own */
+    static TFuture<FRacingLineOptimizerResult> OptimizeAsync(const FTrackLayout& Layout, const FRacingLineOptimizerSettings& Settings = FRacingLineOptimizerSettings());
+
+    /** Store a result in the layout it was solved for. Returns false when the layout changed since. */
+    static bool StoreInLayout(FTrackLayout& Layout, const FRacingLineOptimizerResult& Result);
+
+    /** True when the layout carries a racing line solved for its current segments */
+    static bool HasCachedRacingLine(const FTrackLayout& Layout);
+
+    /** Hash of everything the solve reads from a layout; never 0 */
+    static int32 HashLayout(const FTrackLayout& Layout);
+
+    /**
+     * Centreline resampled every Spacing (cm), with right-pointing unit normals and
+     * half widths (cm). bOutClosed is true when the last segment ends where the first starts.
+     */
+    static void SampleCentreline(const FTrackLayout& Layout, float Spacing, TArray<FVector>& OutPoints,
+        TArray<FVector>& OutNormals, TArray<float>& OutHalfWidths, bool& bOutClosed);
+
+private:
+    /** Projected Gauss-Seidel over every Stride-th point. Returns the sweeps run. */
+    static int32 SolveLevel(TArrayView<const FVector> Centre, TArrayView<const FVector> Normals, TArrayView<const float> Limits,
+        TArrayView<float> Offsets, int32 Stride, bool bClosed, int32 MaxIterations, float Tolerance, double Deadline, bool& bOutConverged);
+
+    /** Largest discrete curvature (1/cm) of an evenly spaced polyline */
+    static float GetMaxCurvature(TArrayView<const FVector> Points, bool bClosed);
+};
@@ -0,0 +1,141 @@
+// RacingSpeedProfile.cpp
+// Forward/backward pass speed profile solver
+// Copyright 2025. All Rights Reserved.
+
+#include "RacingSpeedProfile.h"
+#include "AIRacingController.h"
+#include "Algo/BinarySearch.h"
+
+namespace
+{
+    /** Longitudinal acceleration left after cornering at Speed with Curvature uses some of the grip */
+    float GetRemainingAcceleration(float Speed, float Curvature, float MaxLongitudinal, float MaxLateral)
+    {
+        const float LateralUse = FMath::Min(Speed * Speed * Curvature / MaxLateral, 1.0f);
+        return MaxLongitudinal * FMath::Sqrt(1.0f - LateralUse * LateralUse);
+    }
+}
+
+FSpeedProfileLimits FSpeedProfileLimits::ForDifficulty(EAIDifficulty Difficulty)
+{
+    // Grip, power, brakes, top speed
+    float Scale[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+    switch (Difficulty)
+    {
+        case EAIDifficulty::Easy:
+            Scale[0] = 0.70f; Scale[1] = 0.75f; Scale[2] = 0.70f; Scale[3] = 0.80f;
+            break;
+        case EAIDifficulty::Medium:
+            Scale[0] = 0.82f; Scale[1] = 0.85f; Scale[2] = 0.82f; Scale[3] = 0.90f;
+            break;
+        case EAIDifficulty::Hard:
+            Scale[0] = 0.92f; Scale[1] = 0.95f; Scale[2] = 0.92f; Scale[3] = 0.96f;
+            break;
+        case EAIDifficulty::Expert:
+            break;
+        case EAIDifficulty::Impossible:
+            Scale[0] = 1.08f; Scale[1] = 1.10f; Scale[2] = 1.10f; Scale[3] = 1.05f;
+            break;
+    }
+
+    FSpeedProfileLimits Limits;
+    Limits.MaxLateralAcceleration *= Scale[0];
+    Limits.MaxAcceleration *= Scale[1];
+    Limits.MaxDeceleration *= Scale[2];
+    Limits.MaxSpeed *= Scale[3];
+    return Limits;
+}
+
+void FRacingSpeedProfile::Solve(TArrayView<const float> ArcLength, TArrayView<const float> Curvature, const FSpeedProfileLimits& Limits)
+{
+    const int32 NumPoints = Curvature.Num();
+    check(ArcLength.Num() == NumPoints + 1);
+
+    Speed.SetNumUninitialized(NumPoints);
+    Braking.SetNumZeroed(NumPoints);
+    BrakingPoints.Reset();
+    Length = NumPoints > 0 ? ArcLength[NumPoints] : 0.0f;
+    LapTime = 0.0f;
+
+    if (NumPoints == 0)
+    {
+        return;
+    }
+
+    // Cornering limit
+    int32 Slowest = 0;
+    for (int32 i = 0; i < NumPoints; i++)
+    {
+        Speed[i] = Curvature[i] > KINDA_SMALL_NUMBER
+            ? FMath::Min(Limits.MaxSpeed, FMath::Sqrt(Limits.MaxLateralAcceleration / Curvature[i]))
+            : Limits.MaxSpeed;
+        if (Speed[i] < Speed[Slowest])
+        {
+            Slowest = i;
+        }
+    }
+
+    auto SegmentLength = [&ArcLength](int32 Index) { return ArcLength[Index + 1] - ArcLength[Index]; };
+
+    // Forward: how fast the car can be after accelerating out of the previous point
+    for (int32 Step = 0; Step < NumPoints; Step++)
+    {
+        const int32 i = (Slowest + Step) % NumPoints;
+        const int32 Next = (i + 1) % NumPoints;
+        const float Acceleration = GetRemainingAcceleration(Speed[i], Curvature[i], Limits.MaxAcceleration, Limits.MaxLateralAcceleration);
+        Speed[Next] = FMath::Min(Speed[Next], FMath::Sqrt(Speed[i] * Speed[i] + 2.0f * Acceleration * SegmentLength(i)));
+    }
+
+    // Backward: how fast the car can be and still brake for the next point
+    for (int32 Step = 0; Step < NumPoints; Step++)
+    {
+        const int32 Next = (Slowest - Step + NumPoints) % NumPoints;
+        const int32 i = (Next - 1 + NumPoints) % NumPoints;
+        const float Deceleration = GetRemainingAcceleration(Speed[Next], Curvature[Next], Limits.MaxDeceleration, Limits.MaxLateralAcceleration);
+        const float BrakingSpeed = FMath::Sqrt(Speed[Next] * Speed[Next] + 2.0f * Deceleration * SegmentLength(i));
+        if (BrakingSpeed < Speed[i])
+        {
+            Speed[i] = BrakingSpeed;
+            Braking[i] = 1;
+        }
+    }
+
+    for (int32 i = 0; i < NumPoints; i++)
+    {
+        if (Braking[i] && !Braking[(i - 1 + NumPoints) % NumPoints])
+        {
+            BrakingPoints.Add(ArcLength[i]);
+        }
+
+        // Speed varies linearly between points, so each segment takes length over mean speed
+        const float MeanSpeed = 0.5f * (Speed[i] + Speed[(i + 1) % NumPoints]);
+        LapTime += SegmentLength(i) / FMath::Max(MeanSpeed, KINDA_SMALL_NUMBER);
+    }
+}
+
+float FRacingSpeedProfile::SampleSpeed(TArrayView<const float> ArcLength, int32 Segment, float Distance) const
+{
+    const int32 NumPoints = Speed.Num();
+    if (NumPoints == 0)
+    {
+        return 0.0f;
+    }
+
+    const float SegmentLength = ArcLength[Segment + 1] - ArcLength[Segment];
+    const float Alpha = SegmentLength > KINDA_SMALL_NUMBER ? FMath::Clamp((Distance - ArcLength[Segment]) / SegmentLength, 0.0f, 1.0f) : 0.0f;
+    return FMath::Lerp(Speed[Segment], Speed[(Segment + 1) % NumPoints], Alpha);
+}
+
+float FRacingSpeedProfile::GetDistanceToBrakingPoint(float Distance) const
+{
+    if (BrakingPoints.Num() == 0)
+    {
+        return MAX_FLT;
+    }
+
+    const int32 Next = Algo::LowerBound(BrakingPoints, Distance);
+    return Next < BrakingPoints.Num()
+        ? BrakingPoints[Next] - Distance
+        : BrakingPoints[0] + Length - Distance;
+}
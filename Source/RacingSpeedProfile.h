@@ -0,0 +1,61 @@
+// RacingSpeedProfile.h
+// Minimum-time speed profile over an arc-length parameterized racing line
+// Copyright 2025. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class EAIDifficulty : uint8;
+
+/**
+ * Vehicle limits the profile must respect. Accelerations in cm/s^2, speed in cm/s.
+ */
+struct CARGAME_API FSpeedProfileLimits
+{
+    float MaxLateralAcceleration = 1.4f * 980.0f;
+    float MaxAcceleration = 0.6f * 980.0f;
+    float MaxDeceleration = 1.3f * 980.0f;
+    float MaxSpeed = 300.0f / 0.036f;
+
+    /** Default limits scaled for an AI difficulty (grip, power, brakes and top speed) */
+    static FSpeedProfileLimits ForDifficulty(EAIDifficulty Difficulty);
+};
+
+/**
+ * Fastest speed at each racing line point that the limits allow.
+ *
+ * Solved once with the classic two-pass method: cap every point at its
+ * cornering speed, then a forward pass limits acceleration and a backward
+ * pass limits braking, both sharing grip with cornering (friction circle).
+ * Both passes start at the slowest corner, so one lap each is exact on a closed line.
+ *
+ * Braking zones come out of the backward pass, so drivers only look up the
+ * speed a little ahead of themselves instead of scanning for the next corner.
+ */
+struct CARGAME_API FRacingSpeedProfile
+{
+    /** Target speed at each point (cm/s) */
+    TArray<float> Speed;
+
+    /** 1 where the point lies in a braking zone */
+    TArray<uint8> Braking;
+
+    /** Arc length (cm) where each braking zone starts, ascending */
+    TArray<float> BrakingPoints;
+
+    /** Lap length the profile was solved for (cm) */
+    float Length = 0.0f;
+
+    /** Time to drive one lap at the profile speeds (s) */
+    float LapTime = 0.0f;
+
+    /** ArcLength has Curvature.Num() + 1 entries, the last being the lap length */
+    void Solve(TArrayView<const float> ArcLength, TArrayView<const float> Curvature, const FSpeedProfileLimits& Limits);
+
+    /** Interpolated target speed at a wrapped arc length, given the segment containing it */
+    float SampleSpeed(TArrayView<const float> ArcLength, int32 Segment, float Distance) const;
+
+    /** Distance (cm) from Distance to the next braking point, wrapping around the lap */
+    float GetDistanceToBrakingPoint(float Distance) const;
+};
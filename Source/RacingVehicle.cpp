@@ -3,10 +3,17 @@
 // Copyright 2025. All Rights Reserved.
 
 #include "RacingVehicle.h"
+#include "VehicleSimulationSubsystem.h"
+#include "RaceProgressSubsystem.h"
+#include "RacingGameMode.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "PhysicsEngine/BodyInstance.h"
 #include "Camera/CameraComponent.h"
 #include "GameFramework/SpringArmComponent.h"
-#include "ChaosWheeledVehicleMovementComponent.h"
+#include "RacingVehicleMovementComponent.h"
+#include "EngineTorqueTable.h"
+#include "VehicleTuningSystem.h"
+#include "TelemetryRecorder.h"
 #include "Engine/Engine.h"
 #include "Kismet/GameplayStatics.h"
 #include "Misc/FileHelper.h"
@@ -22,7 +29,7 @@ ARacingVehicle::ARacingVehicle()
     VehicleMesh->SetCollisionProfileName(FName("Vehicle"));
 
     // Create Chaos Vehicle Movement Component
-    VehicleMovement = CreateDefaultSubobject<UChaosWheeledVehicleMovementComponent>(TEXT("VehicleMovement"));
+    VehicleMovement = CreateDefaultSubobject<URacingVehicleMovementComponent>(TEXT("VehicleMovement"));
     VehicleMovement->SetIsReplicated(true);
 
     // Create Spring Arm for camera
@@ -42,7 +49,8 @@ ARacingVehicle::ARacingVehicle()
     Camera->FieldOfView = 90.0f;
 
     // Default vehicle configuration
-    TireModelType = ETireModel::Pacejka;
+    TireModelType = ETireModel::Simple;
+    bUseTireLookupTable = true;
     DrivetrainType = EDrivetrainType::RWD;
     
     MaxEngineTorque = 500.0f;
@@ -62,12 +70,21 @@ ARacingVehicle::ARacingVehicle()
     bStabilityControlEnabled = true;
     ABSThreshold = 0.95f;
     TractionControlThreshold = 0.9f;
+    StabilityControlYawTolerance = 0.15f;
 
     // Telemetry
     bEnableTelemetryLogging = false;
     TelemetryUpdateRate = 0.1f;
     TelemetryTimer = 0.0f;
 
+    // Simulation
+    bUseBatchedSimulation = true;
+    SimulationSlot = INDEX_NONE;
+    RacerSlot = INDEX_NONE;
+    bAllowPhysicsLOD = true;
+    bKinematicLOD = false;
+    KinematicVelocity = FVector::ZeroVector;
+
     // Input state
     CurrentThrottle = 0.0f;
     CurrentBrake = 0.0f;
@@ -75,6 +92,11 @@ ARacingVehicle::ARacingVehicle()
     bHandbrakeEngaged = false;
 
     PreviousVelocity = FVector::ZeroVector;
+
+    EngineTorqueScale = 1.0f;
+    EngineCurveShiftRPM = 0.0f;
+
+    ReplacedBodyQueries = 0;
 }
 
 void ARacingVehicle::BeginPlay()
@@ -88,13 +110,65 @@ void ARacingVehicle::BeginPlay()
         VehicleMesh->SetCenterOfMass(CenterOfMassOffset);
     }
 
+    // Push assist and tire settings to the physics-thread simulation
+    ApplyDrivingAssists(0.0f);
+    if (VehicleMovement)
+    {
+        VehicleMovement->SetTireModel(TireModelType, bUseTireLookupTable);
+    }
+    RebuildEngineTorqueTable();
+
+    // Hand the per-frame update to the batched simulation if it is enabled
+    if (bUseBatchedSimulation && UVehicleSimulationSubsystem::IsBatchedSimulationEnabled())
+    {
+        if (UVehicleSimulationSubsystem* Simulation = GetWorld()->GetSubsystem<UVehicleSimulationSubsystem>())
+        {
+            Simulation->RegisterVehicle(this);
+            SetActorTickEnabled(false);
+        }
+    }
+
     UE_LOG(LogTemp, Log, TEXT("Racing Vehicle Initialized: %s"), *GetName());
 }
 
+void ARacingVehicle::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    StopTelemetryRecording();
+
+    if (IsSimulatedByBatch())
+    {
+        if (UVehicleSimulationSubsystem* Simulation = GetWorld()->GetSubsystem<UVehicleSimulationSubsystem>())
+        {
+            Simulation->UnregisterVehicle(this);
+        }
+    }
+
+    // Free the racer slot; the game mode drops it from the standings first
+    if (GetRacerSlot() != INDEX_NONE)
+    {
+        if (ARacingGameMode* GameMode = GetWorld()->GetAuthGameMode<ARacingGameMode>())
+        {
+            GameMode->UnregisterRacer(this);
+        }
+        if (URaceProgressSubsystem* RaceProgress = GetWorld()->GetSubsystem<URaceProgressSubsystem>())
+        {
+            RaceProgress->UnregisterVehicle(this);
+        }
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
 void ARacingVehicle::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
 
+    // Batched vehicles are updated by UVehicleSimulationSubsystem
+    if (IsSimulatedByBatch())
+    {
+        return;
+    }
+
     // Update physics
     ApplyAerodynamicForces(DeltaTime);
     ApplyDrivingAssists(DeltaTime);
@@ -103,14 +177,129 @@ void ARacingVehicle::Tick(float DeltaTime)
     UpdateTelemetry(DeltaTime);
 
     // Log telemetry if enabled
-    if (bEnableTelemetryLogging)
+    UpdateTelemetryLogging(DeltaTime);
+
+    // Batched vehicles are published after physics by the subsystem
+    const FBodyInstance* Body = GetMesh() ? GetMesh()->GetBodyInstance() : nullptr;
+    const int32 Replaced = PublishFrameState(Body, GFrameCounter, GetWorld()->GetTimeSeconds());
+    if (UVehicleSimulationSubsystem* Simulation = GetWorld()->GetSubsystem<UVehicleSimulationSubsystem>())
     {
-        TelemetryTimer += DeltaTime;
-        if (TelemetryTimer >= TelemetryUpdateRate)
-        {
-            LogTelemetry();
-            TelemetryTimer = 0.0f;
-        }
+        Simulation->ReportFrameStatePublish(Replaced);
+    }
+}
+
+void ARacingVehicle::ApplySimulationResults(const FVehicleTelemetry& Telemetry, float DeltaTime)
+{
+    CurrentTelemetry = Telemetry;
+    PreviousVelocity = Telemetry.Velocity;
+
+    UpdateTelemetryLogging(DeltaTime);
+}
+
+bool ARacingVehicle::HasSimulatedBody() const
+{
+    const USkeletalMeshComponent* SkeletalMesh = GetMesh();
+    return SkeletalMesh && SkeletalMesh->GetSkeletalMeshAsset() && VehicleMovement && VehicleMovement->WheelSetups.Num() > 0;
+}
+
+int32 ARacingVehicle::PublishFrameState(const FBodyInstance* Body, uint64 FrameNumber, double Time)
+{
+    FrameState.FrameNumber = FrameNumber;
+    FrameState.Time = Time;
+
+    if (bKinematicLOD)
+    {
+        // A kinematic body reports no velocity; use the line follower's
+        FrameState.Transform = GetActorTransform();
+        FrameState.Velocity = KinematicVelocity;
+        FrameState.AngularVelocity = FVector::ZeroVector;
+    }
+    else if (Body && Body->IsValidBodyInstance())
+    {
+        FrameState.Transform = Body->GetUnrealWorldTransform();
+        FrameState.Velocity = Body->GetUnrealWorldVelocity();
+        FrameState.AngularVelocity = FMath::RadiansToDegrees(Body->GetUnrealWorldAngularVelocityInRadians());
+    }
+    else
+    {
+        FrameState.Transform = GetActorTransform();
+        FrameState.Velocity = FVector::ZeroVector;
+        FrameState.AngularVelocity = FVector::ZeroVector;
+    }
+
+    FrameState.Speed = FrameState.Velocity.Size() * VehicleSim::CmPerSecToKmh;
+    FrameState.Telemetry = CurrentTelemetry;
+    FrameState.EngineRPMNormalized = FMath::Clamp(CurrentTelemetry.EngineRPM / FMath::Max(MaxEngineRPM, 1.0f), 0.0f, 1.0f);
+
+    // Simplified slip estimate from G-forces
+    FrameState.TireSlip = FMath::Max(FMath::Abs(CurrentTelemetry.LateralG), FMath::Abs(CurrentTelemetry.LongitudinalG)) / 2.0f;
+
+    const int32 Replaced = ReplacedBodyQueries;
+    ReplacedBodyQueries = 0;
+    return Replaced;
+}
+
+void ARacingVehicle::EnterKinematicLOD()
+{
+    USkeletalMeshComponent* VehicleMesh = GetMesh();
+    if (bKinematicLOD || !VehicleMesh)
+    {
+        return;
+    }
+
+    KinematicVelocity = VehicleMesh->GetPhysicsLinearVelocity();
+    bKinematicLOD = true;
+
+    // Stay visible to traces (AI obstacle checks, cameras) but stop simulating
+    VehicleMesh->SetSimulatePhysics(false);
+    VehicleMesh->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+    if (VehicleMovement)
+    {
+        VehicleMovement->SetComponentTickEnabled(false);
+    }
+}
+
+void ARacingVehicle::ExitKinematicLOD(const FVector& Velocity)
+{
+    USkeletalMeshComponent* VehicleMesh = GetMesh();
+    if (!bKinematicLOD || !VehicleMesh)
+    {
+        return;
+    }
+
+    bKinematicLOD = false;
+    KinematicVelocity = FVector::ZeroVector;
+
+    VehicleMesh->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+    VehicleMesh->SetSimulatePhysics(true);
+    VehicleMesh->SetPhysicsLinearVelocity(Velocity);
+    VehicleMesh->SetPhysicsAngularVelocityInDegrees(FVector::ZeroVector);
+    if (VehicleMovement)
+    {
+        VehicleMovement->SetComponentTickEnabled(true);
+    }
+
+    PreviousVelocity = Velocity;
+}
+
+void ARacingVehicle::MoveKinematic(const FVector& Location, const FRotator& Rotation, const FVector& Velocity)
+{
+    KinematicVelocity = Velocity;
+    SetActorLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::TeleportPhysics);
+}
+
+void ARacingVehicle::UpdateTelemetryLogging(float DeltaTime)
+{
+    if (!bEnableTelemetryLogging)
+    {
+        return;
+    }
+
+    TelemetryTimer += DeltaTime;
+    if (TelemetryTimer >= TelemetryUpdateRate)
+    {
+        LogTelemetry();
+        TelemetryTimer = 0.0f;
     }
 }
 
@@ -198,52 +387,32 @@ void ARacingVehicle::ApplyAerodynamicForces(float DeltaTime)
     USkeletalMeshComponent* VehicleMesh = GetMesh();
     if (!VehicleMesh) return;
 
-    // Get current velocity
-    FVector Velocity = VehicleMesh->GetPhysicsLinearVelocity();
-    float Speed = Velocity.Size();
+    // Drag: F = 0.5 * rho * Cd * A * v^2, Downforce: F = 0.5 * rho * Cl * A * v^2
+    const float DragFactor = 0.5f * VehicleSim::AirDensity * DragCoefficient * FrontalArea;
+    const float DownforceFactor = 0.5f * VehicleSim::AirDensity * DownforceCoefficient * FrontalArea;
 
-    if (Speed > 1.0f)
+    const FVector AeroForce = VehicleSim::ComputeAerodynamicForce(VehicleMesh->GetPhysicsLinearVelocity(), DragFactor, DownforceFactor);
+    if (!AeroForce.IsZero())
     {
-        // Air density (kg/m^3)
-        float AirDensity = 1.225f;
-
-        // Calculate drag force: F = 0.5 * rho * Cd * A * v^2
-        float DragMagnitude = 0.5f * AirDensity * DragCoefficient * FrontalArea * Speed * Speed;
-        FVector DragForce = -Velocity.GetSafeNormal() * DragMagnitude;
-
-        // Calculate downforce: F = 0.5 * rho * Cl * A * v^2
-        float DownforceMagnitude = 0.5f * AirDensity * DownforceCoefficient * FrontalArea * Speed * Speed;
-        FVector DownforceForce = FVector(0.0f, 0.0f, -DownforceMagnitude);
-
-        // Apply forces
-        VehicleMesh->AddForce(DragForce);
-        VehicleMesh->AddForce(DownforceForce);
+        VehicleMesh->AddForce(AeroForce);
     }
 }
 
 void ARacingVehicle::ApplyDrivingAssists(float DeltaTime)
 {
-    // ABS implementation
-    if (bABSEnabled && CurrentBrake > ABSThreshold)
-    {
-        // Modulate brake force to prevent wheel lock
-        // This is a simplified implementation
-        // TODO: Implement per-wheel slip monitoring
-    }
-
-    // Traction control implementation
-    if (bTractionControlEnabled)
-    {
-        // Reduce throttle if wheel slip is detected
-        // TODO: Implement wheel slip detection and power reduction
-    }
+    if (!VehicleMovement) return;
 
-    // Stability control
-    if (bStabilityControlEnabled)
-    {
-        // Apply corrective steering/braking to prevent spin
-        // TODO: Implement yaw rate monitoring and correction
-    }
+    // ABS, traction control and stability control run per wheel every physics
+    // substep inside URacingVehicleMovementComponent; this forwards the settings
+    FDrivingAssistParams Params;
+    Params.bABSEnabled = bABSEnabled;
+    Params.bTractionControlEnabled = bTractionControlEnabled;
+    Params.bStabilityControlEnabled = bStabilityControlEnabled;
+    Params.ABSThreshold = ABSThreshold;
+    Params.TractionControlThreshold = TractionControlThreshold;
+    Params.YawRateTolerance = StabilityControlYawTolerance;
+
+    VehicleMovement->SetDrivingAssistParams(Params);
 }
 
 void ARacingVehicle::UpdateTelemetry(float DeltaTime)
@@ -263,17 +432,21 @@ void ARacingVehicle::UpdateTelemetry(float DeltaTime)
     CurrentTelemetry.Brake = CurrentBrake;
     CurrentTelemetry.Steering = CurrentSteering;
 
-    // Engine data (simplified - actual implementation would query engine state)
-    CurrentTelemetry.EngineRPM = FMath::Lerp(IdleRPM, MaxEngineRPM, CurrentThrottle);
-    CurrentTelemetry.CurrentGear = 1; // TODO: Get actual gear from transmission
+    // Engine, gearbox and suspension
+    UpdateMechanicalTelemetry();
 
     // Calculate G-forces
     CalculateGForces(DeltaTime);
 
-    // Update suspension telemetry
-    UpdateSuspensionTelemetry();
+    // Assist intervention counters
+    UpdateAssistTelemetry();
 
     PreviousVelocity = CurrentTelemetry.Velocity;
+
+    if (TelemetryStream.IsValid())
+    {
+        TelemetryStream->Push(GetWorld()->GetTimeSeconds(), CurrentTelemetry);
+    }
 }
 
 void ARacingVehicle::CalculateGForces(float DeltaTime)
@@ -290,14 +463,67 @@ void ARacingVehicle::CalculateGForces(float DeltaTime)
     CurrentTelemetry.LateralG = LocalAcceleration.Y / GravityConstant;
 }
 
-void ARacingVehicle::UpdateSuspensionTelemetry()
+void ARacingVehicle::UpdateMechanicalTelemetry()
 {
-    // TODO: Query actual suspension compression from vehicle movement component
-    // For now, use placeholder values
-    CurrentTelemetry.SuspensionCompressionFL = 0.5f;
-    CurrentTelemetry.SuspensionCompressionFR = 0.5f;
-    CurrentTelemetry.SuspensionCompressionRL = 0.5f;
-    CurrentTelemetry.SuspensionCompressionRR = 0.5f;
+    if (!VehicleMovement) return;
+
+    // Single read per frame; HUD, audio, VFX and replay consume the telemetry copy
+    FVehicleMechanicalState Mechanical;
+    VehicleMovement->ReadMechanicalState(Mechanical);
+
+    CurrentTelemetry.EngineRPM = Mechanical.EngineRPM;
+    CurrentTelemetry.CurrentGear = Mechanical.Gear;
+    CurrentTelemetry.SuspensionCompressionFL = Mechanical.SuspensionCompression[EVehicleWheel::FrontLeft];
+    CurrentTelemetry.SuspensionCompressionFR = Mechanical.SuspensionCompression[EVehicleWheel::FrontRight];
+    CurrentTelemetry.SuspensionCompressionRL = Mechanical.SuspensionCompression[EVehicleWheel::RearLeft];
+    CurrentTelemetry.SuspensionCompressionRR = Mechanical.SuspensionCompression[EVehicleWheel::RearRight];
+}
+
+void ARacingVehicle::ApplyEngineTuning(const FEngineTuning& Tuning)
+{
+    EngineTorqueScale = Tuning.PowerMultiplier * Tuning.TorqueMultiplier;
+    EngineCurveShiftRPM = Tuning.TorqueCurveAdjustment * FEngineTorqueTable::CurveShiftPerStep;
+    MaxEngineRPM = Tuning.RevLimit;
+
+    RebuildEngineTorqueTable();
+
+    if (UVehicleSimulationSubsystem* Simulation = GetWorld() ? GetWorld()->GetSubsystem<UVehicleSimulationSubsystem>() : nullptr)
+    {
+        Simulation->RefreshVehicleConstants(this);
+    }
+}
+
+void ARacingVehicle::RebuildEngineTorqueTable()
+{
+    FEngineTorqueBakeSettings Settings;
+    Settings.MaxTorque = MaxEngineTorque;
+    Settings.IdleRPM = IdleRPM;
+    Settings.RevLimit = MaxEngineRPM;
+    Settings.TorqueScale = EngineTorqueScale;
+    Settings.CurveShiftRPM = EngineCurveShiftRPM;
+
+    // Baked off the physics thread; the old table stays valid until the new one is published
+    TSharedRef<FEngineTorqueTable, ESPMode::ThreadSafe> Table = MakeShared<FEngineTorqueTable, ESPMode::ThreadSafe>();
+    Table->Bake(EngineTorqueCurve, Settings);
+    EngineTorqueTable = Table;
+
+    if (VehicleMovement)
+    {
+        VehicleMovement->SetEngineTorqueTable(EngineTorqueTable);
+    }
+}
+
+void ARacingVehicle::UpdateAssistTelemetry()
+{
+    if (!VehicleMovement) return;
+
+    const FDrivingAssistCounters& Counters = VehicleMovement->GetAssistCounters();
+    for (int32 Wheel = 0; Wheel < EVehicleWheel::Count; Wheel++)
+    {
+        CurrentTelemetry.ABSInterventions[Wheel] = Counters.ABS[Wheel].load(std::memory_order_relaxed);
+        CurrentTelemetry.TractionControlInterventions[Wheel] = Counters.Traction[Wheel].load(std::memory_order_relaxed);
+        CurrentTelemetry.StabilityControlInterventions[Wheel] = Counters.Stability[Wheel].load(std::memory_order_relaxed);
+    }
 }
 
 void ARacingVehicle::LogTelemetry()
@@ -321,19 +547,34 @@ FVehicleTelemetry ARacingVehicle::GetTelemetry() const
 
 void ARacingVehicle::ExportTelemetryToFile(const FString& FilePath)
 {
-    FString TelemetryData = FString::Printf(
-        TEXT("Time,Speed,RPM,Gear,Throttle,Brake,Steering,LatG,LongG\n%.2f,%.1f,%.0f,%d,%.2f,%.2f,%.2f,%.2f,%.2f\n"),
-        GetWorld()->GetTimeSeconds(),
-        CurrentTelemetry.Speed,
-        CurrentTelemetry.EngineRPM,
-        CurrentTelemetry.CurrentGear,
-        CurrentTelemetry.Throttle,
-        CurrentTelemetry.Brake,
-        CurrentTelemetry.Steering,
-        CurrentTelemetry.LateralG,
-        CurrentTelemetry.LongitudinalG
-    );
-
-    FFileHelper::SaveStringToFile(TelemetryData, *FilePath, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append);
-    UE_LOG(LogTemp, Log, TEXT("Telemetry exported to: %s"), *FilePath);
+    // Formatting and file writes happen on the telemetry writer thread
+    if (!TelemetryStream.IsValid() || TelemetryStream->GetFilePath() != FilePath)
+    {
+        StartTelemetryRecording(FilePath);
+    }
+}
+
+void ARacingVehicle::StartTelemetryRecording(const FString& FilePath, bool bCompress)
+{
+    StopTelemetryRecording();
+    TelemetryStream = FTelemetryWriter::Get().OpenStream(FilePath, bCompress);
+}
+
+void ARacingVehicle::StopTelemetryRecording()
+{
+    if (TelemetryStream.IsValid())
+    {
+        TelemetryStream->Close();
+        TelemetryStream.Reset();
+    }
+}
+
+bool ARacingVehicle::IsRecordingTelemetry() const
+{
+    return TelemetryStream.IsValid();
+}
+
+int32 ARacingVehicle::GetTelemetryOverrunCount() const
+{
+    return TelemetryStream.IsValid() ? static_cast<int32>(TelemetryStream->GetOverrunCount()) : 0;
 }
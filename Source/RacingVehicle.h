@@ -10,9 +10,14 @@
 
 // Forward declarations
 class UChaosWheeledVehicleMovementComponent;
+class URacingVehicleMovementComponent;
 class USkeletalMeshComponent;
 class UCameraComponent;
 class USpringArmComponent;
+class FEngineTorqueTable;
+class FTelemetryStream;
+struct FBodyInstance;
+struct FEngineTuning;
 
 /**
  * Tire Model Type
@@ -87,17 +92,54 @@ struct FVehicleTelemetry
     UPROPERTY(BlueprintReadOnly, Category = "Telemetry")
     float LongitudinalG;
 
+    /** Cumulative ABS interventions per wheel (X=FL, Y=FR, Z=RL, W=RR) */
+    UPROPERTY(BlueprintReadOnly, Category = "Telemetry")
+    FIntVector4 ABSInterventions;
+
+    /** Cumulative traction control interventions per wheel (X=FL, Y=FR, Z=RL, W=RR) */
+    UPROPERTY(BlueprintReadOnly, Category = "Telemetry")
+    FIntVector4 TractionControlInterventions;
+
+    /** Cumulative stability control brake interventions per wheel (X=FL, Y=FR, Z=RL, W=RR) */
+    UPROPERTY(BlueprintReadOnly, Category = "Telemetry")
+    FIntVector4 StabilityControlInterventions;
+
     FVehicleTelemetry()
         : Speed(0.f), EngineRPM(0.f), Throttle(0.f), Brake(0.f), 
           Steering(0.f), CurrentGear(1), 
           SuspensionCompressionFL(0.f), SuspensionCompressionFR(0.f),
           SuspensionCompressionRL(0.f), SuspensionCompressionRR(0.f),
           Velocity(FVector::ZeroVector), AngularVelocity(FVector::ZeroVector),
-          LateralG(0.f), LongitudinalG(0.f)
+          LateralG(0.f), LongitudinalG(0.f),
+          ABSInterventions(0), TractionControlInterventions(0), StabilityControlInterventions(0)
     {
     }
 };
 
+/**
+ * Immutable state of one vehicle for one frame, published once after physics.
+ * HUD, audio, VFX, camera and replay read it by const reference instead of
+ * querying the physics body or copying the telemetry themselves.
+ */
+struct FVehicleFrameState
+{
+    uint64 FrameNumber = 0;
+    double Time = 0.0;
+
+    // Physics body state after this frame's step
+    FTransform Transform = FTransform::Identity;
+    FVector Velocity = FVector::ZeroVector;         // cm/s
+    FVector AngularVelocity = FVector::ZeroVector;  // deg/s
+    float Speed = 0.0f;                             // km/h
+
+    // Derived values shared by several consumers
+    float EngineRPMNormalized = 0.0f;
+    float TireSlip = 0.0f;
+
+    /** Telemetry from the most recent simulation pass */
+    FVehicleTelemetry Telemetry;
+};
+
 /**
  * Advanced Racing Vehicle with high-fidelity physics
  */
@@ -111,6 +153,7 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
     virtual void Tick(float DeltaTime) override;
@@ -121,7 +164,7 @@ public:
     // ============================================================
 
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
-    UChaosWheeledVehicleMovementComponent* VehicleMovement;
+    URacingVehicleMovementComponent* VehicleMovement;
 
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
     USpringArmComponent* SpringArm;
@@ -133,9 +176,14 @@ public:
     // VEHICLE CONFIGURATION
     // ============================================================
 
+    /** Simple = stock Chaos friction (default). Pacejka is opt-in until it has been tuned in PIE. */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vehicle|Configuration")
     ETireModel TireModelType;
 
+    /** Pacejka only: sample baked tables instead of evaluating the full Magic Formula */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vehicle|Configuration")
+    bool bUseTireLookupTable;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vehicle|Configuration")
     EDrivetrainType DrivetrainType;
 
@@ -179,12 +227,18 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vehicle|Assists")
     bool bStabilityControlEnabled;
 
+    /** ABS releases brake pressure once wheel speed drops below this fraction of ground speed */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vehicle|Assists")
     float ABSThreshold;
 
+    /** Traction control cuts drive once ground speed drops below this fraction of wheel speed */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vehicle|Assists")
     float TractionControlThreshold;
 
+    /** Allowed difference between measured and bicycle-model yaw rate (rad/s) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vehicle|Assists")
+    float StabilityControlYawTolerance;
+
     // ============================================================
     // TELEMETRY
     // ============================================================
@@ -198,6 +252,35 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vehicle|Telemetry")
     float TelemetryUpdateRate;
 
+    // ============================================================
+    // SIMULATION
+    // ============================================================
+
+    /** Let UVehicleSimulationSubsystem update this vehicle instead of its own Tick */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vehicle|Simulation")
+    bool bUseBatchedSimulation;
+
+    /** True while this vehicle is being updated by the simulation subsystem */
+    UFUNCTION(BlueprintCallable, Category = "Vehicle|Simulation")
+    bool IsSimulatedByBatch() const { return SimulationSlot != INDEX_NONE; }
+
+    /** Stable index of this car in the race's racer registry (URaceProgressSubsystem), INDEX_NONE when not racing */
+    int32 GetRacerSlot() const { return RacerSlot; }
+
+    /** Let the simulation subsystem replace full physics with kinematic racing-line following while this AI car is far from everyone */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Vehicle|Simulation")
+    bool bAllowPhysicsLOD;
+
+    /** True while physics is off and the car is moved along its racing line by the simulation subsystem */
+    UFUNCTION(BlueprintCallable, Category = "Vehicle|Simulation")
+    bool IsKinematicLOD() const { return bKinematicLOD; }
+
+    /**
+     * True when there is a skeletal mesh and wheels for Chaos to simulate. Native ARacingVehicle
+     * has neither; headless harnesses check a class's default object before spawning it.
+     */
+    bool HasSimulatedBody() const;
+
     // ============================================================
     // INPUT
     // ============================================================
@@ -227,9 +310,45 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Vehicle|Telemetry")
     FVehicleTelemetry GetTelemetry() const;
 
+    /**
+     * This frame's published state. Consumers ticking after physics should add
+     * themselves with UVehicleSimulationSubsystem::AddFrameStateConsumer.
+     */
+    const FVehicleFrameState& GetFrameState() const { return FrameState; }
+
+    /**
+     * This frame's published velocity, for callers that used to query the physics body
+     * (GetVelocity / GetPhysicsLinearVelocity). Each call counts as a body query removed.
+     */
+    const FVector& GetFrameVelocity() const
+    {
+        ReplacedBodyQueries++;
+        return FrameState.Velocity;
+    }
+
+    /** Start streaming telemetry to FilePath (see StartTelemetryRecording) */
     UFUNCTION(BlueprintCallable, Category = "Vehicle|Telemetry")
     void ExportTelemetryToFile(const FString& FilePath);
 
+    /**
+     * Record every simulation step to a chunked columnar file. Samples go through a
+     * lock-free ring buffer; a background thread does all encoding and file I/O.
+     * bCompress additionally zlib-compresses each column.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Vehicle|Telemetry")
+    void StartTelemetryRecording(const FString& FilePath, bool bCompress = true);
+
+    /** Flush and close the current recording on the writer thread */
+    UFUNCTION(BlueprintCallable, Category = "Vehicle|Telemetry")
+    void StopTelemetryRecording();
+
+    UFUNCTION(BlueprintCallable, Category = "Vehicle|Telemetry")
+    bool IsRecordingTelemetry() const;
+
+    /** Samples dropped because the writer thread fell behind */
+    UFUNCTION(BlueprintCallable, Category = "Vehicle|Telemetry")
+    int32 GetTelemetryOverrunCount() const;
+
     // ============================================================
     // PHYSICS
     // ============================================================
@@ -243,7 +362,26 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Vehicle|Physics")
     void ApplyDrivingAssists(float DeltaTime);
 
+    /** Reshape the torque curve from a tuning setup and rebake the torque table */
+    void ApplyEngineTuning(const FEngineTuning& Tuning);
+
+    /** Bake EngineTorqueCurve and the current tuning into the physics-thread torque table */
+    void RebuildEngineTorqueTable();
+
 private:
+    friend class UVehicleSimulationSubsystem;
+    friend class URaceProgressSubsystem;
+
+    // Slot in UVehicleSimulationSubsystem, INDEX_NONE when ticking on its own
+    int32 SimulationSlot;
+
+    // Slot in URaceProgressSubsystem; kept for as long as the car is registered
+    int32 RacerSlot;
+
+    // Physics LOD: set while the body is kinematic, with the velocity the line follower is moving it at
+    bool bKinematicLOD;
+    FVector KinematicVelocity;
+
     // Internal state
     float CurrentThrottle;
     float CurrentBrake;
@@ -253,8 +391,33 @@ private:
     float TelemetryTimer;
     FVector PreviousVelocity;
 
+    // Engine tuning modifiers, applied when the torque table is baked
+    float EngineTorqueScale;
+    float EngineCurveShiftRPM;
+    TSharedPtr<const FEngineTorqueTable, ESPMode::ThreadSafe> EngineTorqueTable;
+
+    // Active telemetry recording, filled from the simulation step
+    TSharedPtr<FTelemetryStream, ESPMode::ThreadSafe> TelemetryStream;
+
+    // Per-frame blackboard and the body queries it stood in for since it was last published
+    FVehicleFrameState FrameState;
+    mutable int32 ReplacedBodyQueries;
+
     // Helper functions
     void CalculateGForces(float DeltaTime);
-    void UpdateSuspensionTelemetry();
+    void UpdateMechanicalTelemetry();
+    void UpdateAssistTelemetry();
     void LogTelemetry();
+    void UpdateTelemetryLogging(float DeltaTime);
+
+    /** Called by the simulation subsystem after its batched pass */
+    void ApplySimulationResults(const FVehicleTelemetry& Telemetry, float DeltaTime);
+
+    /** Rebuild FrameState from a single body read. Returns the body queries the previous state replaced. */
+    int32 PublishFrameState(const FBodyInstance* Body, uint64 FrameNumber, double Time);
+
+    /** Physics LOD transitions, driven by the simulation subsystem */
+    void EnterKinematicLOD();
+    void ExitKinematicLOD(const FVector& Velocity);
+    void MoveKinematic(const FVector& Location, const FRotator& Rotation, const FVector& Velocity);
 };
@@ -0,0 +1,315 @@
+// RacingVehicleMovementComponent.cpp
+// Physics-rate driving assists, tire forces and engine torque
+// Copyright 2025. All Rights Reserved.
+
+#include "RacingVehicleMovementComponent.h"
+#include "VehicleSimulationSubsystem.h"
+#include "RacingVehicle.h"
+#include "SimpleVehicle.h"
+
+DECLARE_CYCLE_STAT(TEXT("Vehicle Sim Assists"), STAT_VehicleSim_Assists, STATGROUP_VehicleSim);
+DECLARE_CYCLE_STAT(TEXT("Vehicle Sim Tire Forces"), STAT_VehicleSim_TireForces, STATGROUP_VehicleSim);
+
+// ============================================================
+// PHYSICS THREAD SIMULATION
+// ============================================================
+
+FRacingWheeledVehicleSimulation::FRacingWheeledVehicleSimulation(
+    TSharedPtr<FDrivingAssistShared, ESPMode::ThreadSafe> InAssistShared,
+    TSharedPtr<FTireModelShared, ESPMode::ThreadSafe> InTireShared,
+    TSharedPtr<FEngineTorqueShared, ESPMode::ThreadSafe> InEngineShared)
+    : AssistShared(MoveTemp(InAssistShared))
+    , TireShared(MoveTemp(InTireShared))
+    , EngineShared(MoveTemp(InEngineShared))
+{
+}
+
+void FRacingWheeledVehicleSimulation::ApplyInput(const FControlInputs& ControlInputs, float DeltaTime)
+{
+    // Stock input step sets drive and brake torque from throttle/brake
+    UChaosWheeledVehicleSimulation::ApplyInput(ControlInputs, DeltaTime);
+
+    Throttle = ControlInputs.ThrottleInput;
+    for (int32 Wheel = 0; Wheel < EVehicleWheel::Count; Wheel++)
+    {
+        DriveScale[Wheel] = 1.0f;
+    }
+
+    if (!AssistShared.IsValid() || !PVehicle.IsValid() || PVehicle->Wheels.Num() < EVehicleWheel::Count)
+    {
+        return;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_VehicleSim_Assists);
+    VehicleSim::FScopedStage Stage(VehicleSim::EStage::Assists);
+
+    FDrivingAssistParams Params;
+    {
+        FScopeLock Lock(&AssistShared->ParamsLock);
+        Params = AssistShared->Params;
+    }
+
+    FWheelAssistBatch Batch;
+    GatherWheelState(ControlInputs, Batch);
+
+    RunDrivingAssists(Params, MakeArrayView(&Batch, 1));
+
+    ApplyWheelTorques(Batch);
+    AssistShared->Counters.Accumulate(Batch);
+
+    // Drive torque is set by the drivetrain step, so traction control is applied there
+    for (int32 Wheel = 0; Wheel < EVehicleWheel::Count; Wheel++)
+    {
+        DriveScale[Wheel] = Batch.DriveScale[Wheel];
+    }
+}
+
+void FRacingWheeledVehicleSimulation::GatherWheelState(const FControlInputs& ControlInputs, FWheelAssistBatch& OutBatch) const
+{
+    for (int32 Wheel = 0; Wheel < EVehicleWheel::Count; Wheel++)
+    {
+        const Chaos::FSimpleWheelSim& PWheel = PVehicle->Wheels[Wheel];
+
+        OutBatch.WheelSpeed[Wheel] = Chaos::CmToM(PWheel.GetAngularVelocity() * PWheel.GetEffectiveRadius());
+        OutBatch.GroundSpeed[Wheel] = Chaos::CmToM(PWheel.GetWheelGroundSpeed());
+        OutBatch.SlipAngle[Wheel] = PWheel.GetSlipAngle();
+        OutBatch.DriveMask[Wheel] = PWheel.EngineEnabled ? 1.0f : 0.0f;
+    }
+
+    OutBatch.ForwardSpeed = Chaos::CmToM(VehicleState.ForwardSpeed);
+    OutBatch.SteeringAngle = FMath::DegreesToRadians(PVehicle->Wheels[EVehicleWheel::FrontLeft].GetSteeringAngle());
+    OutBatch.YawRate = FVector::DotProduct(VehicleState.VehicleWorldAngularVelocity, VehicleState.VehicleUpAxis);
+    OutBatch.Brake = ControlInputs.BrakeInput;
+    OutBatch.Throttle = ControlInputs.ThrottleInput;
+}
+
+void FRacingWheeledVehicleSimulation::ApplyWheelTorques(const FWheelAssistBatch& Batch)
+{
+    if (!Batch.ABSMask && !Batch.StabilityMask)
+    {
+        return;
+    }
+
+    for (int32 Wheel = 0; Wheel < EVehicleWheel::Count; Wheel++)
+    {
+        Chaos::FSimpleWheelSim& PWheel = PVehicle->Wheels[Wheel];
+
+        const float BrakeTorque = PWheel.GetBrakeTorque() * Batch.BrakeScale[Wheel]
+            + Chaos::TorqueMToCm(Batch.StabilityBrakeTorque[Wheel]);
+
+        PWheel.SetBrakeTorque(BrakeTorque);
+    }
+}
+
+void FRacingWheeledVehicleSimulation::ProcessMechanicalSimulation(float DeltaTime)
+{
+    UChaosWheeledVehicleSimulation::ProcessMechanicalSimulation(DeltaTime);
+
+    if (!PVehicle.IsValid() || PVehicle->Wheels.Num() < EVehicleWheel::Count)
+    {
+        return;
+    }
+
+    TSharedPtr<const FEngineTorqueTable, ESPMode::ThreadSafe> Table;
+    if (EngineShared.IsValid())
+    {
+        FScopeLock Lock(&EngineShared->TableLock);
+        Table = EngineShared->Table;
+    }
+
+    if (Table.IsValid() && PVehicle->HasTransmission() && PVehicle->HasEngine())
+    {
+        // Baked torque replaces the stock curve lookup
+        const float EngineTorque = Table->GetTorque(PVehicle->GetEngine().GetEngineRPM()) * Throttle;
+        const float TransmissionTorque = Chaos::TorqueMToCm(PVehicle->GetTransmission().GetTransmissionTorque(EngineTorque));
+
+        for (int32 Wheel = 0; Wheel < EVehicleWheel::Count; Wheel++)
+        {
+            Chaos::FSimpleWheelSim& PWheel = PVehicle->Wheels[Wheel];
+            if (PWheel.EngineEnabled)
+            {
+                PWheel.SetDriveTorque(TransmissionTorque * PWheel.TorqueRatio * DriveScale[Wheel]);
+            }
+        }
+        return;
+    }
+
+    for (int32 Wheel = 0; Wheel < EVehicleWheel::Count; Wheel++)
+    {
+        if (DriveScale[Wheel] < 1.0f)
+        {
+            Chaos::FSimpleWheelSim& PWheel = PVehicle->Wheels[Wheel];
+            PWheel.SetDriveTorque(PWheel.GetDriveTorque() * DriveScale[Wheel]);
+        }
+    }
+}
+
+void FRacingWheeledVehicleSimulation::ApplyWheelFrictionForces(float DeltaTime)
+{
+    if (!TireShared.IsValid() || !TireShared->bUsePacejka.load(std::memory_order_acquire) || !TireShared->Pacejka.IsValid()
+        || !PVehicle.IsValid() || PVehicle->Wheels.Num() < EVehicleWheel::Count)
+    {
+        UChaosWheeledVehicleSimulation::ApplyWheelFrictionForces(DeltaTime);
+        return;
+    }
+
+    const ETireForceEvaluation Evaluation = TireShared->bUseLookupTable.load(std::memory_order_relaxed)
+        ? ETireForceEvaluation::LookupTable
+        : ETireForceEvaluation::Exact;
+
+    ApplyPacejkaForces(*TireShared->Pacejka, Evaluation, DeltaTime);
+}
+
+void FRacingWheeledVehicleSimulation::ApplyPacejkaForces(const FPacejkaTireModel& Model, ETireForceEvaluation Evaluation, float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_VehicleSim_TireForces);
+    VehicleSim::FScopedStage Stage(VehicleSim::EStage::TireForces);
+
+    const float MinGroundSpeed = 1.0f; // m/s
+    FTireForceBatch Batch;
+    FVector WheelForward[EVehicleWheel::Count];
+
+    // Slip and load from the state the suspension step left, before the wheels are stepped
+    for (int32 Wheel = 0; Wheel < EVehicleWheel::Count; Wheel++)
+    {
+        const Chaos::FSimpleWheelSim& PWheel = PVehicle->Wheels[Wheel];
+
+        // Contact patch velocity in the steered wheel frame (m/s)
+        const FRotator Steer(0.0f, PWheel.GetSteeringAngle(), 0.0f);
+        const FVector LocalVelocity = Steer.UnrotateVector(WheelState.LocalWheelVelocity[Wheel]) * Chaos::CmToM(1.0f);
+        const float GroundSpeed = LocalVelocity.X;
+        const float WheelSpeed = Chaos::CmToM(PWheel.GetAngularVelocity() * PWheel.GetEffectiveRadius());
+        const float Reference = FMath::Max(FMath::Abs(GroundSpeed), MinGroundSpeed);
+
+        Batch.NormalLoad[Wheel] = PWheel.InContact() ? Chaos::CmToM(PWheel.GetWheelLoadForce()) : 0.0f;
+        Batch.SlipRatio[Wheel] = (WheelSpeed - GroundSpeed) / Reference;
+        Batch.SlipAngle[Wheel] = FMath::Atan2(-LocalVelocity.Y, Reference);
+        Batch.GripScale[Wheel] = 1.0f;
+
+        WheelForward[Wheel] = Steer.Vector();
+    }
+
+    Model.Evaluate(Evaluation, MakeArrayView(&Batch, 1));
+
+    for (int32 Wheel = 0; Wheel < EVehicleWheel::Count; Wheel++)
+    {
+        Chaos::FSimpleWheelSim& PWheel = PVehicle->Wheels[Wheel];
+        const FVector Forward = WheelForward[Wheel];
+
+        // Same wheel inputs as the stock friction step, so the wheel still integrates
+        // drive and brake torque, angular position and its slip state
+        if (PWheel.InContact())
+        {
+            const FRotator Steer(0.0f, PWheel.GetSteeringAngle(), 0.0f);
+            PWheel.SetVehicleGroundSpeed(Steer.UnrotateVector(WheelState.LocalWheelVelocity[Wheel]));
+        }
+        else
+        {
+            PWheel.SetVehicleGroundSpeed(FVector::ZeroVector);
+            PWheel.SetWheelLoadForce(0.0f);
+        }
+        PWheel.Simulate(DeltaTime);
+
+        if (Batch.NormalLoad[Wheel] <= 0.0f)
+        {
+            continue;
+        }
+
+        // The stock step reacted the wheel against its own friction force; swap that
+        // reaction for the Magic Formula force (cm units), without crossing free rolling
+        const float Radius = PWheel.GetEffectiveRadius();
+        const float Inertia = 0.5f * PWheel.Setup().WheelMass * Radius * Radius;
+        if (Inertia > KINDA_SMALL_NUMBER && Radius > KINDA_SMALL_NUMBER)
+        {
+            const float StockForce = PWheel.GetForceFromFriction().X;
+            const float TireForce = Chaos::MToCm(Batch.LongitudinalForce[Wheel]);
+            const float RollingSpeed = PWheel.GetWheelGroundSpeed() / Radius;
+
+            const float Stepped = PWheel.GetAngularVelocity();
+            float Corrected = Stepped + (StockForce - TireForce) * Radius / Inertia * DeltaTime;
+            if ((Stepped - RollingSpeed) * (Corrected - RollingSpeed) < 0.0f)
+            {
+                Corrected = RollingSpeed;
+            }
+            PWheel.SetAngularVelocity(Corrected);
+        }
+
+        // Wheel frame: X along the steered wheel, Y to its right
+        const FVector Right(-Forward.Y, Forward.X, 0.0f);
+        const FVector LocalForce = Forward * Batch.LongitudinalForce[Wheel] + Right * Batch.LateralForce[Wheel];
+
+        const FVector WorldForce = VehicleState.VehicleWorldTransform.TransformVector(LocalForce) * Chaos::MToCm(1.0f);
+        AddForceAtPosition(WorldForce, WheelState.WheelWorldLocation[Wheel]);
+    }
+}
+
+// ============================================================
+// COMPONENT
+// ============================================================
+
+URacingVehicleMovementComponent::URacingVehicleMovementComponent()
+{
+    AssistShared = MakeShared<FDrivingAssistShared, ESPMode::ThreadSafe>();
+    TireShared = MakeShared<FTireModelShared, ESPMode::ThreadSafe>();
+    EngineShared = MakeShared<FEngineTorqueShared, ESPMode::ThreadSafe>();
+}
+
+void URacingVehicleMovementComponent::SetDrivingAssistParams(const FDrivingAssistParams& Params)
+{
+    // Uncontended except for the single read per physics substep
+    FScopeLock Lock(&AssistShared->ParamsLock);
+    AssistShared->Params = Params;
+}
+
+void URacingVehicleMovementComponent::ResetAssistCounters()
+{
+    AssistShared->Counters.Reset();
+}
+
+void URacingVehicleMovementComponent::SetTireModel(ETireModel Model, bool bUseLookupTable)
+{
+    const bool bUsePacejka = (Model == ETireModel::Pacejka);
+    if (bUsePacejka && !TireShared->Pacejka.IsValid())
+    {
+        // Published before the flag below, so the physics thread never sees the flag without the model
+        TireShared->Pacejka = FPacejkaTireModel::GetDefault();
+    }
+
+    TireShared->bUseLookupTable.store(bUseLookupTable, std::memory_order_relaxed);
+    TireShared->bUsePacejka.store(bUsePacejka, std::memory_order_release);
+}
+
+void URacingVehicleMovementComponent::SetEngineTorqueTable(TSharedPtr<const FEngineTorqueTable, ESPMode::ThreadSafe> Table)
+{
+    FScopeLock Lock(&EngineShared->TableLock);
+    EngineShared->Table = MoveTemp(Table);
+}
+
+void URacingVehicleMovementComponent::ReadMechanicalState(FVehicleMechanicalState& OutState) const
+{
+    // Both values come from the game-thread copy of the physics output, no simulation lock is taken
+    OutState.EngineRPM = GetEngineRotationSpeed();
+    OutState.Gear = GetCurrentGear();
+
+    for (int32 Wheel = 0; Wheel < EVehicleWheel::Count; Wheel++)
+    {
+        if (Wheel < GetNumWheels())
+        {
+            const FWheelStatus& Status = GetWheelState(Wheel);
+            OutState.SuspensionCompression[Wheel] = Status.bIsValid
+                ? FMath::Clamp(1.0f - Status.NormalizedSuspensionLength, 0.0f, 1.0f)
+                : 0.0f;
+        }
+        else
+        {
+            OutState.SuspensionCompression[Wheel] = 0.0f;
+        }
+    }
+}
+
+TUniquePtr<Chaos::FSimpleWheeledVehicle> URacingVehicleMovementComponent::CreatePhysicsVehicle()
+{
+    // Same as UChaosWheeledVehicleMovementComponent, with the racing simulation
+    VehicleSimulationPT = MakeUnique<FRacingWheeledVehicleSimulation>(AssistShared, TireShared, EngineShared);
+    return UChaosVehicleMovementComponent::CreatePhysicsVehicle();
+}
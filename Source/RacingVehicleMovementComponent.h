@@ -0,0 +1,149 @@
+// RacingVehicleMovementComponent.h
+// Chaos wheeled movement with physics-rate assists, tire model and engine torque table
+// Copyright 2025. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ChaosWheeledVehicleMovementComponent.h"
+#include "DrivingAssistKernel.h"
+#include "TireForceKernel.h"
+#include "EngineTorqueTable.h"
+#include "RacingVehicleMovementComponent.generated.h"
+
+/**
+ * Assist state shared between the component (game thread)
+ * and its vehicle simulation (physics thread)
+ */
+struct FDrivingAssistShared
+{
+    FCriticalSection ParamsLock;
+    FDrivingAssistParams Params;
+    FDrivingAssistCounters Counters;
+};
+
+enum class ETireModel : uint8;
+
+/**
+ * Transmission and suspension state of one frame, taken from the
+ * simulation output the physics thread hands back to the game thread
+ */
+struct FVehicleMechanicalState
+{
+    float EngineRPM = 0.0f;
+
+    /** -1 reverse, 0 neutral, 1+ forward */
+    int32 Gear = 0;
+
+    /** 0 = fully extended, 1 = fully compressed, per EVehicleWheel */
+    float SuspensionCompression[EVehicleWheel::Count] = { 0.0f, 0.0f, 0.0f, 0.0f };
+};
+
+/**
+ * Tire model selection shared with the vehicle simulation
+ */
+struct FTireModelShared
+{
+    std::atomic<bool> bUsePacejka{false};
+    std::atomic<bool> bUseLookupTable{true};
+
+    /** Immutable and shared by every vehicle using the default coefficients */
+    TSharedPtr<const FPacejkaTireModel, ESPMode::ThreadSafe> Pacejka;
+};
+
+/**
+ * Baked engine torque table shared with the vehicle simulation.
+ * Replaced wholesale when a new setup is applied.
+ */
+struct FEngineTorqueShared
+{
+    FCriticalSection TableLock;
+    TSharedPtr<const FEngineTorqueTable, ESPMode::ThreadSafe> Table;
+};
+
+/**
+ * Wheeled vehicle simulation that runs ABS, traction control and
+ * stability control after the stock input step of every physics substep.
+ * With ETireModel::Pacejka selected, tire forces come from the Magic Formula
+ * kernel instead of the stock Chaos friction model; wheel spin still integrates
+ * drive and brake torque and reacts to those forces. Engine torque is read from
+ * the baked FEngineTorqueTable when one has been published.
+ */
+class FRacingWheeledVehicleSimulation : public UChaosWheeledVehicleSimulation
+{
+public:
+    FRacingWheeledVehicleSimulation(
+        TSharedPtr<FDrivingAssistShared, ESPMode::ThreadSafe> InAssistShared,
+        TSharedPtr<FTireModelShared, ESPMode::ThreadSafe> InTireShared,
+        TSharedPtr<FEngineTorqueShared, ESPMode::ThreadSafe> InEngineShared);
+
+    virtual void ApplyInput(const FControlInputs& ControlInputs, float DeltaTime) override;
+    virtual void ProcessMechanicalSimulation(float DeltaTime) override;
+    virtual void ApplyWheelFrictionForces(float DeltaTime) override;
+
+private:
+    TSharedPtr<FDrivingAssistShared, ESPMode::ThreadSafe> AssistShared;
+    TSharedPtr<FTireModelShared, ESPMode::ThreadSafe> TireShared;
+    TSharedPtr<FEngineTorqueShared, ESPMode::ThreadSafe> EngineShared;
+
+    /** Traction control output and throttle of the current substep, consumed by the drivetrain step */
+    float DriveScale[EVehicleWheel::Count] = { 1.0f, 1.0f, 1.0f, 1.0f };
+    float Throttle = 0.0f;
+
+    /**
+     * Replaces only the force part of the stock friction step: wheels are still stepped,
+     * then their spin reacts to the Magic Formula longitudinal force instead of the stock one
+     */
+    void ApplyPacejkaForces(const FPacejkaTireModel& Model, ETireForceEvaluation Evaluation, float DeltaTime);
+
+    void GatherWheelState(const FControlInputs& ControlInputs, FWheelAssistBatch& OutBatch) const;
+    void ApplyWheelTorques(const FWheelAssistBatch& Batch);
+};
+
+/**
+ * Movement component used by ARacingVehicle.
+ * Identical to UChaosWheeledVehicleMovementComponent apart from the
+ * physics-thread driving assist controller and selectable tire model.
+ *
+ * Once a torque table is published (ARacingVehicle does so in BeginPlay), drive torque
+ * comes from the table alone: EngineSetup's TorqueCurve and MaxTorque are no longer read.
+ * Edit the vehicle's Engine properties (MaxEngineTorque, EngineTorqueCurve) instead.
+ * EngineSetup still drives engine RPM, inertia and braking.
+ */
+UCLASS(ClassGroup=(Vehicle), meta=(BlueprintSpawnableComponent))
+class CARGAME_API URacingVehicleMovementComponent : public UChaosWheeledVehicleMovementComponent
+{
+    GENERATED_BODY()
+
+public:
+    URacingVehicleMovementComponent();
+
+    /** Forward assist settings to the physics thread */
+    void SetDrivingAssistParams(const FDrivingAssistParams& Params);
+
+    /** Per-wheel intervention counters, updated every physics substep */
+    const FDrivingAssistCounters& GetAssistCounters() const { return AssistShared->Counters; }
+
+    UFUNCTION(BlueprintCallable, Category = "Vehicle|Assists")
+    void ResetAssistCounters();
+
+    /** Select the tire force model used from the next physics substep */
+    void SetTireModel(ETireModel Model, bool bUseLookupTable);
+
+    /** Publish a newly baked torque table; the physics thread picks it up next substep and stops reading EngineSetup's torque curve */
+    void SetEngineTorqueTable(TSharedPtr<const FEngineTorqueTable, ESPMode::ThreadSafe> Table);
+
+    /**
+     * Read engine, gearbox and suspension state from the latest simulation output.
+     * Called once per frame by the telemetry update; everything else reads the telemetry.
+     */
+    void ReadMechanicalState(FVehicleMechanicalState& OutState) const;
+
+protected:
+    virtual TUniquePtr<Chaos::FSimpleWheeledVehicle> CreatePhysicsVehicle() override;
+
+private:
+    TSharedPtr<FDrivingAssistShared, ESPMode::ThreadSafe> AssistShared;
+    TSharedPtr<FTireModelShared, ESPMode::ThreadSafe> TireShared;
+    TSharedPtr<FEngineTorqueShared, ESPMode::ThreadSafe> EngineShared;
+};
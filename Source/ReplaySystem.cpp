@@ -0,0 +1,40 @@
+// ReplaySystem.cpp
+// Replay recording from published vehicle frame state
+// Copyright 2025. All Rights Reserved.
+
+#include "ReplaySystem.h"
+#include "RacingVehicle.h"
+
+// ============================================================
+// RECORDING
+// ============================================================
+
+void AReplaySystem::RecordVehicleSnapshot(ARacingVehicle* Vehicle, int32 VehicleID)
+{
+    if (!bIsRecording || !Vehicle)
+    {
+        return;
+    }
+
+    CurrentRecording.VehicleSnapshots.FindOrAdd(VehicleID).Add(CreateVehicleSnapshot(Vehicle));
+}
+
+FVehicleSnapshot AReplaySystem::CreateVehicleSnapshot(ARacingVehicle* Vehicle)
+{
+    // Sampled from the vehicle's published frame state rather than its physics body
+    const FVehicleFrameState& State = Vehicle->GetFrameState();
+    const FVehicleTelemetry& Telemetry = State.Telemetry;
+
+    FVehicleSnapshot Snapshot;
+    Snapshot.Timestamp = static_cast<float>(State.Time) - RecordingStartTime;
+    Snapshot.Transform = State.Transform;
+    Snapshot.Velocity = State.Velocity;
+    Snapshot.AngularVelocity = State.AngularVelocity;
+    Snapshot.SteeringInput = Telemetry.Steering;
+    Snapshot.ThrottleInput = Telemetry.Throttle;
+    Snapshot.BrakeInput = Telemetry.Brake;
+    Snapshot.CurrentSpeed = State.Speed;
+    Snapshot.CurrentRPM = Telemetry.EngineRPM;
+    Snapshot.CurrentGear = Telemetry.CurrentGear;
+    return Snapshot;
+}
@@ -0,0 +1,178 @@
+// TelemetryConvertCommandlet.cpp
+// Converts telemetry recordings between the binary format and CSV
+// Copyright 2025. All Rights Reserved.
+
+#include "TelemetryConvertCommandlet.h"
+#include "TelemetryFileFormat.h"
+#include "TelemetryRecorder.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+UTelemetryConvertCommandlet::UTelemetryConvertCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 UTelemetryConvertCommandlet::Main(const FString& Params)
+{
+    FString InPath;
+    FString OutPath;
+    if (!FParse::Value(*Params, TEXT("In="), InPath) || !FParse::Value(*Params, TEXT("Out="), OutPath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("TelemetryConvert: usage -In=<file> -Out=<file> [-NoCompress]"));
+        return 1;
+    }
+
+    if (FPaths::GetExtension(InPath).Equals(TEXT("csv"), ESearchCase::IgnoreCase))
+    {
+        return CsvToBinary(InPath, OutPath, !FParse::Param(*Params, TEXT("NoCompress")));
+    }
+    return BinaryToCsv(InPath, OutPath);
+}
+
+int32 UTelemetryConvertCommandlet::BinaryToCsv(const FString& InPath, const FString& OutPath)
+{
+    FTelemetryFileReader Reader;
+    if (!Reader.Open(InPath))
+    {
+        return 1;
+    }
+
+    TArray<double> Times;
+    TArray<float> Values;
+    if (!Reader.ReadAll(Times, Values))
+    {
+        UE_LOG(LogTemp, Error, TEXT("TelemetryConvert: %s is corrupt"), *InPath);
+        return 1;
+    }
+
+    const TArray<FTelemetryChannelDesc>& Channels = Reader.GetChannels();
+    const int32 NumSamples = Times.Num();
+
+    TArray<FString> Lines;
+    Lines.Reserve(NumSamples + 1);
+
+    FString Header = TEXT("Time");
+    for (const FTelemetryChannelDesc& Channel : Channels)
+    {
+        Header += TEXT(",") + Channel.Name;
+    }
+    Lines.Add(MoveTemp(Header));
+
+    for (int32 Sample = 0; Sample < NumSamples; Sample++)
+    {
+        FString Line = FString::Printf(TEXT("%.6f"), Times[Sample]);
+        for (int32 Channel = 0; Channel < Channels.Num(); Channel++)
+        {
+            Line += FString::Printf(TEXT(",%g"), Values[Channel * NumSamples + Sample]);
+        }
+        Lines.Add(MoveTemp(Line));
+    }
+
+    if (!FFileHelper::SaveStringArrayToFile(Lines, *OutPath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("TelemetryConvert: could not write %s"), *OutPath);
+        return 1;
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("TelemetryConvert: %d samples, %d channels, %d chunks -> %s"),
+        NumSamples, Channels.Num(), Reader.GetChunks().Num(), *OutPath);
+    return 0;
+}
+
+int32 UTelemetryConvertCommandlet::CsvToBinary(const FString& InPath, const FString& OutPath, bool bCompress)
+{
+    TArray<FString> Lines;
+    if (!FFileHelper::LoadFileToStringArray(Lines, *InPath) || Lines.Num() == 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("TelemetryConvert: could not read %s"), *InPath);
+        return 1;
+    }
+
+    // First column is time, the rest are channels; known names keep their recorder resolution
+    TArray<FString> Names;
+    Lines[0].ParseIntoArray(Names, TEXT(","));
+    if (Names.Num() < 2)
+    {
+        UE_LOG(LogTemp, Error, TEXT("TelemetryConvert: %s has no channel columns"), *InPath);
+        return 1;
+    }
+
+    TArray<FTelemetryChannelDesc> Channels;
+    for (int32 Column = 1; Column < Names.Num(); Column++)
+    {
+        FTelemetryChannelDesc& Desc = Channels.AddDefaulted_GetRef();
+        Desc.Name = Names[Column].TrimStartAndEnd();
+        for (int32 Channel = 0; Channel < TelemetryChannels::Count; Channel++)
+        {
+            if (Desc.Name.Equals(TelemetryChannels::GetName(Channel), ESearchCase::IgnoreCase))
+            {
+                Desc.Resolution = TelemetryChannels::GetResolution(Channel);
+                break;
+            }
+        }
+    }
+
+    FTelemetryFileWriter Writer;
+    if (!Writer.Open(OutPath, Channels, bCompress))
+    {
+        UE_LOG(LogTemp, Error, TEXT("TelemetryConvert: could not write %s"), *OutPath);
+        return 1;
+    }
+
+    const int32 ChunkSize = FTelemetryWriter::BlockSize;
+    TArray<double> Times;
+    TArray<float> Rows;     // sample-major while parsing
+    TArray<float> Values;   // channel-major for the writer
+    TArray<FString> Fields;
+    int32 TotalSamples = 0;
+
+    auto Flush = [&]()
+    {
+        const int32 Count = Times.Num();
+        Values.SetNumUninitialized(Count * Channels.Num());
+        for (int32 Sample = 0; Sample < Count; Sample++)
+        {
+            for (int32 Channel = 0; Channel < Channels.Num(); Channel++)
+            {
+                Values[Channel * Count + Sample] = Rows[Sample * Channels.Num() + Channel];
+            }
+        }
+        Writer.WriteChunk(Times, Values);
+        TotalSamples += Count;
+        Times.Reset();
+        Rows.Reset();
+    };
+
+    for (int32 LineIndex = 1; LineIndex < Lines.Num(); LineIndex++)
+    {
+        Lines[LineIndex].ParseIntoArray(Fields, TEXT(","), false);
+        if (Fields.Num() != Names.Num())
+        {
+            continue;
+        }
+
+        Times.Add(FCString::Atod(*Fields[0]));
+        for (int32 Column = 1; Column < Fields.Num(); Column++)
+        {
+            Rows.Add(FCString::Atof(*Fields[Column]));
+        }
+
+        if (Times.Num() == ChunkSize)
+        {
+            Flush();
+        }
+    }
+
+    if (Times.Num() > 0)
+    {
+        Flush();
+    }
+    Writer.Close();
+
+    UE_LOG(LogTemp, Display, TEXT("TelemetryConvert: %d samples, %d channels -> %s"), TotalSamples, Channels.Num(), *OutPath);
+    return 0;
+}
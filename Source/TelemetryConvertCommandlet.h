@@ -0,0 +1,32 @@
+// TelemetryConvertCommandlet.h
+// Converts telemetry recordings between the binary format and CSV
+// Copyright 2025. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "TelemetryConvertCommandlet.generated.h"
+
+/**
+ * Offline converter for telemetry files (see TelemetryFileFormat.h).
+ * The direction is chosen from the input extension: a .csv input is encoded
+ * to the binary format, anything else is decoded to CSV.
+ *
+ * Usage:
+ *   UnrealEditor-Cmd CarGame.uproject -run=TelemetryConvert -In=<file> -Out=<file> [-NoCompress]
+ */
+UCLASS()
+class CARGAME_API UTelemetryConvertCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UTelemetryConvertCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+
+private:
+    int32 BinaryToCsv(const FString& InPath, const FString& OutPath);
+    int32 CsvToBinary(const FString& InPath, const FString& OutPath, bool bCompress);
+};
@@ -0,0 +1,481 @@
+// TelemetryFileFormat.cpp
+// Delta/quantized column encoding, chunk index and mapped reader
+// Copyright 2025. All Rights Reserved.
+
+#include "TelemetryFileFormat.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/Compression.h"
+#include "Serialization/MemoryReader.h"
+#include "Algo/BinarySearch.h"
+
+namespace
+{
+    // ============================================================
+    // ENCODING
+    // ============================================================
+
+    FORCEINLINE uint64 ZigZagEncode(int64 Value)
+    {
+        return (static_cast<uint64>(Value) << 1) ^ static_cast<uint64>(Value >> 63);
+    }
+
+    FORCEINLINE int64 ZigZagDecode(uint64 Value)
+    {
+        return static_cast<int64>(Value >> 1) ^ -static_cast<int64>(Value & 1);
+    }
+
+    /** Delta + zigzag + LEB128: slowly changing channels cost about one byte per sample */
+    void EncodeDeltas(TArrayView<const int64> Values, TArray<uint8>& Out)
+    {
+        Out.Reset();
+        int64 Previous = 0;
+        for (const int64 Value : Values)
+        {
+            uint64 Bits = ZigZagEncode(Value - Previous);
+            Previous = Value;
+
+            do
+            {
+                uint8 Byte = Bits & 0x7F;
+                Bits >>= 7;
+                if (Bits)
+                {
+                    Byte |= 0x80;
+                }
+                Out.Add(Byte);
+            }
+            while (Bits);
+        }
+    }
+
+    bool DecodeDeltas(const uint8* Bytes, int32 NumBytes, uint32 NumValues, TArray<int64>& Out)
+    {
+        Out.SetNumUninitialized(NumValues);
+
+        const uint8* Cursor = Bytes;
+        const uint8* End = Bytes + NumBytes;
+        int64 Previous = 0;
+
+        for (uint32 i = 0; i < NumValues; i++)
+        {
+            uint64 Bits = 0;
+            int32 Shift = 0;
+            uint8 Byte;
+            do
+            {
+                if (Cursor >= End || Shift > 63)
+                {
+                    return false;
+                }
+                Byte = *Cursor++;
+                Bits |= static_cast<uint64>(Byte & 0x7F) << Shift;
+                Shift += 7;
+            }
+            while (Byte & 0x80);
+
+            Previous += ZigZagDecode(Bits);
+            Out[i] = Previous;
+        }
+        return true;
+    }
+}
+
+// ============================================================
+// WRITER
+// ============================================================
+
+FTelemetryFileWriter::FTelemetryFileWriter()
+{
+}
+
+FTelemetryFileWriter::~FTelemetryFileWriter()
+{
+    Close();
+}
+
+bool FTelemetryFileWriter::Open(const FString& FilePath, const TArray<FTelemetryChannelDesc>& InChannels, bool bInCompress)
+{
+    Close();
+
+    Archive.Reset(IFileManager::Get().CreateFileWriter(*FilePath));
+    if (!Archive.IsValid())
+    {
+        return false;
+    }
+
+    Channels = InChannels;
+    bCompress = bInCompress;
+    Index.Reset();
+
+    uint32 Magic = TelemetryFile::Magic;
+    uint16 Version = TelemetryFile::Version;
+    uint16 Flags = bCompress ? TelemetryFile::Compressed : TelemetryFile::None;
+    uint16 ChannelCount = static_cast<uint16>(Channels.Num());
+    *Archive << Magic << Version << Flags << ChannelCount;
+
+    for (FTelemetryChannelDesc& Channel : Channels)
+    {
+        FTCHARToUTF8 Name(*Channel.Name);
+        uint8 Length = static_cast<uint8>(FMath::Min(Name.Length(), 255));
+        *Archive << Length;
+        Archive->Serialize(const_cast<ANSICHAR*>(Name.Get()), Length);
+        *Archive << Channel.Resolution;
+    }
+
+    return true;
+}
+
+void FTelemetryFileWriter::WriteChunk(TArrayView<const double> Times, TArrayView<const float> Values)
+{
+    const int32 Count = Times.Num();
+    if (!Archive.IsValid() || Count == 0)
+    {
+        return;
+    }
+    check(Values.Num() == Count * Channels.Num());
+
+    FTelemetryChunkIndex& Chunk = Index.AddDefaulted_GetRef();
+    Chunk.StartTime = Times[0];
+    Chunk.EndTime = Times[Count - 1];
+    Chunk.NumSamples = Count;
+    Chunk.Columns.SetNum(Channels.Num() + 1);
+
+    Quantized.SetNumUninitialized(Count);
+
+    for (int32 i = 0; i < Count; i++)
+    {
+        Quantized[i] = FMath::RoundToInt64(Times[i] / TelemetryFile::TimeResolution);
+    }
+    WriteColumn(Quantized, Chunk.Columns[0]);
+
+    for (int32 Channel = 0; Channel < Channels.Num(); Channel++)
+    {
+        const float* Column = Values.GetData() + Channel * Count;
+        const double InvResolution = 1.0 / Channels[Channel].Resolution;
+        for (int32 i = 0; i < Count; i++)
+        {
+            Quantized[i] = FMath::RoundToInt64(Column[i] * InvResolution);
+        }
+        WriteColumn(Quantized, Chunk.Columns[Channel + 1]);
+    }
+}
+
+void FTelemetryFileWriter::WriteColumn(TArrayView<const int64> Values, FTelemetryColumnLocation& OutLocation)
+{
+    EncodeDeltas(Values, Encoded);
+
+    OutLocation.Offset = Archive->Tell();
+    OutLocation.RawSize = Encoded.Num();
+    OutLocation.StoredSize = Encoded.Num();
+
+    if (bCompress && Encoded.Num() > 64)
+    {
+        int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, Encoded.Num());
+        Compressed.SetNumUninitialized(CompressedSize);
+
+        // Keep the raw bytes when compression does not pay off
+        if (FCompression::CompressMemory(NAME_Zlib, Compressed.GetData(), CompressedSize, Encoded.GetData(), Encoded.Num())
+            && CompressedSize < Encoded.Num())
+        {
+            OutLocation.StoredSize = CompressedSize;
+            Archive->Serialize(Compressed.GetData(), CompressedSize);
+            return;
+        }
+    }
+
+    Archive->Serialize(Encoded.GetData(), Encoded.Num());
+}
+
+void FTelemetryFileWriter::Close()
+{
+    if (!Archive.IsValid())
+    {
+        return;
+    }
+
+    uint64 IndexOffset = Archive->Tell();
+    uint32 ChunkCount = Index.Num();
+    *Archive << ChunkCount;
+
+    for (FTelemetryChunkIndex& Chunk : Index)
+    {
+        *Archive << Chunk.StartTime << Chunk.EndTime << Chunk.NumSamples;
+        for (FTelemetryColumnLocation& Column : Chunk.Columns)
+        {
+            *Archive << Column.Offset << Column.StoredSize << Column.RawSize;
+        }
+    }
+
+    uint32 IndexMagic = TelemetryFile::IndexMagic;
+    uint32 Reserved = 0;
+    *Archive << IndexOffset << IndexMagic << Reserved;
+
+    Archive->Close();
+    Archive.Reset();
+    Index.Reset();
+}
+
+// ============================================================
+// READER
+// ============================================================
+
+FTelemetryFileReader::FTelemetryFileReader()
+{
+}
+
+FTelemetryFileReader::~FTelemetryFileReader()
+{
+    Close();
+}
+
+bool FTelemetryFileReader::Open(const FString& FilePath)
+{
+    Close();
+
+    MappedFile.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*FilePath));
+    if (!MappedFile.IsValid())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Telemetry: could not map %s"), *FilePath);
+        return false;
+    }
+
+    MappedRegion.Reset(MappedFile->MapRegion());
+    if (!MappedRegion.IsValid())
+    {
+        Close();
+        return false;
+    }
+
+    Data = MappedRegion->GetMappedPtr();
+    Size = MappedRegion->GetMappedSize();
+
+    if (!ParseHeaderAndIndex())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Telemetry: %s is not a valid telemetry file"), *FilePath);
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void FTelemetryFileReader::Close()
+{
+    MappedRegion.Reset();
+    MappedFile.Reset();
+    Data = nullptr;
+    Size = 0;
+    Flags = 0;
+    Channels.Reset();
+    Chunks.Reset();
+}
+
+int32 FTelemetryFileReader::FindChannel(const FString& Name) const
+{
+    return Channels.IndexOfByPredicate([&Name](const FTelemetryChannelDesc& Channel)
+    {
+        return Channel.Name.Equals(Name, ESearchCase::IgnoreCase);
+    });
+}
+
+bool FTelemetryFileReader::ParseHeaderAndIndex()
+{
+    if (Size < TelemetryFile::FooterSize + 10)
+    {
+        return false;
+    }
+
+    FMemoryReaderView Reader(MakeArrayView(Data, Size));
+
+    uint32 Magic = 0;
+    uint16 Version = 0;
+    uint16 ChannelCount = 0;
+    Reader << Magic << Version << Flags << ChannelCount;
+    if (Magic != TelemetryFile::Magic || Version != TelemetryFile::Version)
+    {
+        return false;
+    }
+
+    Channels.SetNum(ChannelCount);
+    for (FTelemetryChannelDesc& Channel : Channels)
+    {
+        uint8 Length = 0;
+        Reader << Length;
+
+        TArray<ANSICHAR> Name;
+        Name.SetNumZeroed(Length + 1);
+        Reader.Serialize(Name.GetData(), Length);
+        Channel.Name = UTF8_TO_TCHAR(Name.GetData());
+
+        Reader << Channel.Resolution;
+        if (Reader.IsError() || Channel.Resolution <= 0.0f)
+        {
+            return false;
+        }
+    }
+
+    // Footer points back at the index
+    Reader.Seek(Size - TelemetryFile::FooterSize);
+    uint64 IndexOffset = 0;
+    uint32 IndexMagic = 0;
+    uint32 Reserved = 0;
+    Reader << IndexOffset << IndexMagic << Reserved;
+    if (IndexMagic != TelemetryFile::IndexMagic || IndexOffset >= static_cast<uint64>(Size))
+    {
+        return false;
+    }
+
+    Reader.Seek(IndexOffset);
+    uint32 ChunkCount = 0;
+    Reader << ChunkCount;
+
+    Chunks.SetNum(ChunkCount);
+    for (FTelemetryChunkIndex& Chunk : Chunks)
+    {
+        Reader << Chunk.StartTime << Chunk.EndTime << Chunk.NumSamples;
+
+        Chunk.Columns.SetNum(ChannelCount + 1);
+        for (FTelemetryColumnLocation& Column : Chunk.Columns)
+        {
+            Reader << Column.Offset << Column.StoredSize << Column.RawSize;
+            if (Column.Offset + Column.StoredSize > IndexOffset)
+            {
+                return false;
+            }
+        }
+    }
+
+    return !Reader.IsError();
+}
+
+bool FTelemetryFileReader::DecodeColumn(const FTelemetryColumnLocation& Location, uint32 NumSamples, TArray<int64>& OutQuantized) const
+{
+    const uint8* Stored = Data + Location.Offset;
+
+    if (Location.StoredSize == Location.RawSize)
+    {
+        return DecodeDeltas(Stored, Location.StoredSize, NumSamples, OutQuantized);
+    }
+
+    TArray<uint8> Raw;
+    Raw.SetNumUninitialized(Location.RawSize);
+    if (!FCompression::UncompressMemory(NAME_Zlib, Raw.GetData(), Location.RawSize, Stored, Location.StoredSize))
+    {
+        return false;
+    }
+    return DecodeDeltas(Raw.GetData(), Raw.Num(), NumSamples, OutQuantized);
+}
+
+bool FTelemetryFileReader::DecodeTimes(const FTelemetryChunkIndex& Chunk, TArray<double>& OutTimes) const
+{
+    TArray<int64> Quantized;
+    if (!DecodeColumn(Chunk.Columns[0], Chunk.NumSamples, Quantized))
+    {
+        return false;
+    }
+
+    OutTimes.SetNumUninitialized(Quantized.Num());
+    for (int32 i = 0; i < Quantized.Num(); i++)
+    {
+        OutTimes[i] = Quantized[i] * TelemetryFile::TimeResolution;
+    }
+    return true;
+}
+
+bool FTelemetryFileReader::DecodeValues(const FTelemetryChunkIndex& Chunk, int32 Channel, TArray<float>& OutValues) const
+{
+    TArray<int64> Quantized;
+    if (!DecodeColumn(Chunk.Columns[Channel + 1], Chunk.NumSamples, Quantized))
+    {
+        return false;
+    }
+
+    const double Resolution = Channels[Channel].Resolution;
+    OutValues.SetNumUninitialized(Quantized.Num());
+    for (int32 i = 0; i < Quantized.Num(); i++)
+    {
+        OutValues[i] = static_cast<float>(Quantized[i] * Resolution);
+    }
+    return true;
+}
+
+bool FTelemetryFileReader::ReadChannel(int32 Channel, double StartTime, double EndTime, TArray<double>& OutTimes, TArray<float>& OutValues) const
+{
+    OutTimes.Reset();
+    OutValues.Reset();
+
+    if (!Data || !Channels.IsValidIndex(Channel))
+    {
+        return false;
+    }
+
+    // Chunks are written in time order: skip straight to the first one that can overlap
+    int32 First = Algo::LowerBoundBy(Chunks, StartTime, [](const FTelemetryChunkIndex& Chunk) { return Chunk.EndTime; });
+
+    TArray<double> ChunkTimes;
+    TArray<float> ChunkValues;
+
+    for (int32 ChunkIndex = First; ChunkIndex < Chunks.Num() && Chunks[ChunkIndex].StartTime <= EndTime; ChunkIndex++)
+    {
+        const FTelemetryChunkIndex& Chunk = Chunks[ChunkIndex];
+        if (!DecodeTimes(Chunk, ChunkTimes) || !DecodeValues(Chunk, Channel, ChunkValues))
+        {
+            return false;
+        }
+
+        for (int32 i = 0; i < ChunkTimes.Num(); i++)
+        {
+            if (ChunkTimes[i] >= StartTime && ChunkTimes[i] <= EndTime)
+            {
+                OutTimes.Add(ChunkTimes[i]);
+                OutValues.Add(ChunkValues[i]);
+            }
+        }
+    }
+    return true;
+}
+
+bool FTelemetryFileReader::ReadAll(TArray<double>& OutTimes, TArray<float>& OutValues) const
+{
+    OutTimes.Reset();
+    OutValues.Reset();
+
+    if (!Data)
+    {
+        return false;
+    }
+
+    int32 TotalSamples = 0;
+    for (const FTelemetryChunkIndex& Chunk : Chunks)
+    {
+        TotalSamples += Chunk.NumSamples;
+    }
+
+    OutTimes.Reserve(TotalSamples);
+    OutValues.SetNumUninitialized(TotalSamples * Channels.Num());
+
+    TArray<double> ChunkTimes;
+    TArray<float> ChunkValues;
+    int32 SampleOffset = 0;
+
+    for (const FTelemetryChunkIndex& Chunk : Chunks)
+    {
+        if (!DecodeTimes(Chunk, ChunkTimes))
+        {
+            return false;
+        }
+        OutTimes.Append(ChunkTimes);
+
+        for (int32 Channel = 0; Channel < Channels.Num(); Channel++)
+        {
+            if (!DecodeValues(Chunk, Channel, ChunkValues))
+            {
+                return false;
+            }
+            FMemory::Memcpy(OutValues.GetData() + Channel * TotalSamples + SampleOffset, ChunkValues.GetData(), ChunkValues.Num() * sizeof(float));
+        }
+        SampleOffset += Chunk.NumSamples;
+    }
+    return true;
+}
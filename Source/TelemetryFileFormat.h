@@ -0,0 +1,150 @@
+// TelemetryFileFormat.h
+// Chunked columnar telemetry files: writer and memory-mapped reader
+// Copyright 2025. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FArchive;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * File layout (little endian):
+ *
+ *   Header   uint32 Magic 'CGTL' | uint16 Version | uint16 Flags | uint16 ChannelCount
+ *            per channel: uint8 NameLength | UTF-8 name | float Resolution
+ *   Chunks   per chunk, per column (Time first, then every channel):
+ *            zigzag varint deltas of the quantized values, optionally zlib-compressed
+ *   Index    uint32 ChunkCount
+ *            per chunk: double StartTime | double EndTime | uint32 SampleCount
+ *                       per column: uint64 Offset | uint32 StoredSize | uint32 RawSize
+ *   Footer   uint64 IndexOffset | uint32 'CGTI' | uint32 Reserved
+ *
+ * Every column of every chunk is independently addressable through the index,
+ * so one channel over a time range decodes only the chunks and columns it needs.
+ */
+namespace TelemetryFile
+{
+    constexpr uint32 Magic = 0x4C544743;        // 'CGTL'
+    constexpr uint32 IndexMagic = 0x49544743;   // 'CGTI'
+    constexpr uint16 Version = 2;
+    constexpr int32 FooterSize = 16;
+
+    /** Time is quantized to microseconds */
+    constexpr double TimeResolution = 1.0e-6;
+
+    enum EFlags : uint16
+    {
+        None        = 0,
+        Compressed  = 1 << 0
+    };
+}
+
+struct FTelemetryChannelDesc
+{
+    FString Name;
+
+    /** Quantization step; decoded values are within Resolution / 2 of the originals */
+    float Resolution = 0.001f;
+};
+
+struct FTelemetryColumnLocation
+{
+    uint64 Offset = 0;
+    uint32 StoredSize = 0;  // bytes on disk
+    uint32 RawSize = 0;     // bytes after decompression (== StoredSize when stored raw)
+};
+
+struct FTelemetryChunkIndex
+{
+    double StartTime = 0.0;
+    double EndTime = 0.0;
+    uint32 NumSamples = 0;
+
+    /** [0] is the time column, [1 + N] is channel N */
+    TArray<FTelemetryColumnLocation> Columns;
+};
+
+/**
+ * Streams chunks to disk and writes the index on Close().
+ * Used from the telemetry writer thread and the converter.
+ */
+class CARGAME_API FTelemetryFileWriter
+{
+public:
+    FTelemetryFileWriter();
+    ~FTelemetryFileWriter();
+
+    bool Open(const FString& FilePath, const TArray<FTelemetryChannelDesc>& InChannels, bool bInCompress);
+
+    /**
+     * Append one chunk. Values is channel-major: Values[Channel * Times.Num() + Sample].
+     */
+    void WriteChunk(TArrayView<const double> Times, TArrayView<const float> Values);
+
+    /** Write index and footer, then close the file */
+    void Close();
+
+    bool IsOpen() const { return Archive.IsValid(); }
+
+private:
+    TUniquePtr<FArchive> Archive;
+    TArray<FTelemetryChannelDesc> Channels;
+    TArray<FTelemetryChunkIndex> Index;
+    bool bCompress = false;
+
+    // Reused between chunks
+    TArray<int64> Quantized;
+    TArray<uint8> Encoded;
+    TArray<uint8> Compressed;
+
+    void WriteColumn(TArrayView<const int64> Values, FTelemetryColumnLocation& OutLocation);
+};
+
+/**
+ * Read-only view of a telemetry file through a memory mapping.
+ * Opening parses only the header and index.
+ */
+class CARGAME_API FTelemetryFileReader
+{
+public:
+    FTelemetryFileReader();
+    ~FTelemetryFileReader();
+
+    bool Open(const FString& FilePath);
+    void Close();
+
+    const TArray<FTelemetryChannelDesc>& GetChannels() const { return Channels; }
+    const TArray<FTelemetryChunkIndex>& GetChunks() const { return Chunks; }
+
+    /** INDEX_NONE when the file has no such channel */
+    int32 FindChannel(const FString& Name) const;
+
+    bool IsCompressed() const { return (Flags & TelemetryFile::Compressed) != 0; }
+
+    /**
+     * Decode one channel between StartTime and EndTime (inclusive).
+     * Only chunks overlapping the range are touched, and only their time column and this channel.
+     */
+    bool ReadChannel(int32 Channel, double StartTime, double EndTime, TArray<double>& OutTimes, TArray<float>& OutValues) const;
+
+    /** Decode everything; OutValues is channel-major like FTelemetryFileWriter::WriteChunk */
+    bool ReadAll(TArray<double>& OutTimes, TArray<float>& OutValues) const;
+
+private:
+    TUniquePtr<IMappedFileHandle> MappedFile;
+    TUniquePtr<IMappedFileRegion> MappedRegion;
+    const uint8* Data = nullptr;
+    int64 Size = 0;
+
+    uint16 Flags = 0;
+    TArray<FTelemetryChannelDesc> Channels;
+    TArray<FTelemetryChunkIndex> Chunks;
+
+    bool ParseHeaderAndIndex();
+    bool DecodeTimes(const FTelemetryChunkIndex& Chunk, TArray<double>& OutTimes) const;
+    bool DecodeValues(const FTelemetryChunkIndex& Chunk, int32 Channel, TArray<float>& OutValues) const;
+    bool DecodeColumn(const FTelemetryColumnLocation& Location, uint32 NumSamples, TArray<int64>& OutQuantized) const;
+};
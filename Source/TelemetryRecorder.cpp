@@ -0,0 +1,329 @@
+// TelemetryRecorder.cpp
+// Telemetry ring buffer and writer thread
+// Copyright 2025. All Rights Reserved.
+
+#include "TelemetryRecorder.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "Misc/ScopeLock.h"
+
+// ============================================================
+// CHANNELS
+// ============================================================
+
+namespace TelemetryChannels
+{
+    const TCHAR* GetName(int32 Channel)
+    {
+        static const TCHAR* Names[Count] =
+        {
+            TEXT("Speed"),
+            TEXT("RPM"),
+            TEXT("Gear"),
+            TEXT("Throttle"),
+            TEXT("Brake"),
+            TEXT("Steering"),
+            TEXT("LatG"),
+            TEXT("LongG"),
+            TEXT("SuspFL"),
+            TEXT("SuspFR"),
+            TEXT("SuspRL"),
+            TEXT("SuspRR"),
+            TEXT("VelX"),
+            TEXT("VelY"),
+            TEXT("VelZ"),
+            TEXT("YawRate")
+        };
+        return (Channel >= 0 && Channel < Count) ? Names[Channel] : TEXT("");
+    }
+
+    float GetResolution(int32 Channel)
+    {
+        static const float Resolutions[Count] =
+        {
+            0.01f,  // Speed (km/h)
+            1.0f,   // RPM
+            1.0f,   // Gear
+            0.001f, // Throttle
+            0.001f, // Brake
+            0.001f, // Steering
+            0.001f, // LatG
+            0.001f, // LongG
+            0.001f, // SuspFL
+            0.001f, // SuspFR
+            0.001f, // SuspRL
+            0.001f, // SuspRR
+            0.1f,   // VelX (cm/s)
+            0.1f,   // VelY
+            0.1f,   // VelZ
+            0.01f   // YawRate (deg/s)
+        };
+        return (Channel >= 0 && Channel < Count) ? Resolutions[Channel] : 0.001f;
+    }
+
+    TArray<FTelemetryChannelDesc> MakeDescriptors()
+    {
+        TArray<FTelemetryChannelDesc> Descriptors;
+        Descriptors.SetNum(Count);
+        for (int32 Channel = 0; Channel < Count; Channel++)
+        {
+            Descriptors[Channel].Name = GetName(Channel);
+            Descriptors[Channel].Resolution = GetResolution(Channel);
+        }
+        return Descriptors;
+    }
+
+    float Read(const FVehicleTelemetry& Telemetry, int32 Channel)
+    {
+        switch (Channel)
+        {
+        case Speed:         return Telemetry.Speed;
+        case EngineRPM:     return Telemetry.EngineRPM;
+        case Gear:          return static_cast<float>(Telemetry.CurrentGear);
+        case Throttle:      return Telemetry.Throttle;
+        case Brake:         return Telemetry.Brake;
+        case Steering:      return Telemetry.Steering;
+        case LateralG:      return Telemetry.LateralG;
+        case LongitudinalG: return Telemetry.LongitudinalG;
+        case SuspensionFL:  return Telemetry.SuspensionCompressionFL;
+        case SuspensionFR:  return Telemetry.SuspensionCompressionFR;
+        case SuspensionRL:  return Telemetry.SuspensionCompressionRL;
+        case SuspensionRR:  return Telemetry.SuspensionCompressionRR;
+        case VelocityX:     return Telemetry.Velocity.X;
+        case VelocityY:     return Telemetry.Velocity.Y;
+        case VelocityZ:     return Telemetry.Velocity.Z;
+        case YawRate:       return Telemetry.AngularVelocity.Z;
+        default:            return 0.0f;
+        }
+    }
+}
+
+// ============================================================
+// RING BUFFER
+// ============================================================
+
+FTelemetryRingBuffer::FTelemetryRingBuffer(uint32 InCapacity)
+{
+    const uint32 Capacity = FMath::RoundUpToPowerOfTwo(FMath::Max<uint32>(InCapacity, 2));
+    Samples.SetNum(Capacity);
+    Mask = Capacity - 1;
+}
+
+bool FTelemetryRingBuffer::Push(const FTelemetrySample& Sample)
+{
+    const uint32 CurrentHead = Head.load(std::memory_order_relaxed);
+    const uint32 CurrentTail = Tail.load(std::memory_order_acquire);
+
+    if (CurrentHead - CurrentTail > Mask)
+    {
+        Overruns.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    Samples[CurrentHead & Mask] = Sample;
+    Head.store(CurrentHead + 1, std::memory_order_release);
+    return true;
+}
+
+int32 FTelemetryRingBuffer::Pop(FTelemetrySample* Out, int32 MaxSamples)
+{
+    const uint32 CurrentTail = Tail.load(std::memory_order_relaxed);
+    const uint32 CurrentHead = Head.load(std::memory_order_acquire);
+
+    const int32 Count = FMath::Min<int32>(static_cast<int32>(CurrentHead - CurrentTail), MaxSamples);
+    for (int32 i = 0; i < Count; i++)
+    {
+        Out[i] = Samples[(CurrentTail + i) & Mask];
+    }
+
+    Tail.store(CurrentTail + Count, std::memory_order_release);
+    return Count;
+}
+
+// ============================================================
+// STREAM
+// ============================================================
+
+FTelemetryStream::FTelemetryStream(const FString& InFilePath, uint32 Capacity, bool bInCompress)
+    : FilePath(InFilePath)
+    , bCompress(bInCompress)
+    , Buffer(Capacity)
+{
+}
+
+// ============================================================
+// WRITER
+// ============================================================
+
+TUniquePtr<FTelemetryWriter> FTelemetryWriter::Instance;
+
+FTelemetryWriter& FTelemetryWriter::Get()
+{
+    check(IsInGameThread());
+
+    if (!Instance.IsValid())
+    {
+        Instance = TUniquePtr<FTelemetryWriter>(new FTelemetryWriter());
+    }
+    return *Instance;
+}
+
+void FTelemetryWriter::Shutdown()
+{
+    Instance.Reset();
+}
+
+FTelemetryWriter::FTelemetryWriter()
+{
+    WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+    Thread = FRunnableThread::Create(this, TEXT("TelemetryWriter"), 0, TPri_BelowNormal);
+}
+
+FTelemetryWriter::~FTelemetryWriter()
+{
+    if (Thread)
+    {
+        Thread->Kill(true);
+        delete Thread;
+        Thread = nullptr;
+    }
+
+    FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+    WakeEvent = nullptr;
+}
+
+TSharedRef<FTelemetryStream, ESPMode::ThreadSafe> FTelemetryWriter::OpenStream(const FString& FilePath, bool bCompress, uint32 Capacity)
+{
+    TSharedRef<FTelemetryStream, ESPMode::ThreadSafe> Stream = MakeShared<FTelemetryStream, ESPMode::ThreadSafe>(FilePath, Capacity, bCompress);
+    {
+        FScopeLock Lock(&StreamsLock);
+        Streams.Add(Stream);
+    }
+    return Stream;
+}
+
+uint32 FTelemetryWriter::Run()
+{
+    const uint32 WaitMs = static_cast<uint32>(DrainIntervalSeconds * 1000.0f);
+
+    while (!bStopRequested.load(std::memory_order_acquire))
+    {
+        WakeEvent->Wait(WaitMs);
+        DrainAll(false);
+    }
+
+    DrainAll(true);
+    return 0;
+}
+
+void FTelemetryWriter::Stop()
+{
+    bStopRequested.store(true, std::memory_order_release);
+    WakeEvent->Trigger();
+}
+
+void FTelemetryWriter::DrainAll(bool bFinal)
+{
+    // Snapshot so the game thread can open streams while files are being written
+    TArray<TSharedRef<FTelemetryStream, ESPMode::ThreadSafe>> Snapshot;
+    {
+        FScopeLock Lock(&StreamsLock);
+        Snapshot = Streams;
+    }
+
+    TArray<FTelemetryStream*> Finished;
+    for (const TSharedRef<FTelemetryStream, ESPMode::ThreadSafe>& Stream : Snapshot)
+    {
+        if (DrainStream(*Stream, bFinal))
+        {
+            Finished.Add(&Stream.Get());
+        }
+    }
+
+    if (Finished.Num() > 0)
+    {
+        FScopeLock Lock(&StreamsLock);
+        Streams.RemoveAll([&Finished](const TSharedRef<FTelemetryStream, ESPMode::ThreadSafe>& Stream)
+        {
+            return Finished.Contains(&Stream.Get());
+        });
+    }
+}
+
+bool FTelemetryWriter::DrainStream(FTelemetryStream& Stream, bool bFinal)
+{
+    // Read the flag before draining so nothing pushed before Close() is lost
+    const bool bClosing = bFinal || Stream.IsCloseRequested();
+
+    if (!Stream.File.IsValid())
+    {
+        Stream.File = MakeUnique<FTelemetryFileWriter>();
+        if (!Stream.File->Open(Stream.FilePath, TelemetryChannels::MakeDescriptors(), Stream.bCompress))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Telemetry: could not open %s"), *Stream.FilePath);
+            return true;
+        }
+        Stream.Pending.Reserve(BlockSize);
+    }
+
+    for (;;)
+    {
+        const int32 Offset = Stream.Pending.Num();
+        Stream.Pending.AddUninitialized(BlockSize - Offset);
+        const int32 Popped = Stream.Buffer.Pop(Stream.Pending.GetData() + Offset, BlockSize - Offset);
+        Stream.Pending.SetNum(Offset + Popped, false);
+
+        if (Stream.Pending.Num() < BlockSize)
+        {
+            break;
+        }
+        WriteChunk(Stream);
+    }
+
+    if (!bClosing)
+    {
+        return false;
+    }
+
+    if (Stream.Pending.Num() > 0)
+    {
+        WriteChunk(Stream);
+    }
+
+    Stream.File->Close();
+    Stream.File.Reset();
+
+    if (Stream.GetOverrunCount() > 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Telemetry: %s dropped %u samples"), *Stream.FilePath, Stream.GetOverrunCount());
+    }
+    return true;
+}
+
+void FTelemetryWriter::WriteChunk(FTelemetryStream& Stream)
+{
+    const int32 Count = Stream.Pending.Num();
+
+    // Transpose to channel-major columns for the encoder
+    Stream.ChunkTimes.SetNumUninitialized(Count);
+    Stream.ChunkValues.SetNumUninitialized(Count * TelemetryChannels::Count);
+
+    for (int32 i = 0; i < Count; i++)
+    {
+        Stream.ChunkTimes[i] = Stream.Pending[i].Time;
+    }
+
+    for (int32 Channel = 0; Channel < TelemetryChannels::Count; Channel++)
+    {
+        float* Column = Stream.ChunkValues.GetData() + Channel * Count;
+        for (int32 i = 0; i < Count; i++)
+        {
+            Column[i] = TelemetryChannels::Read(Stream.Pending[i].Telemetry, Channel);
+        }
+    }
+
+    Stream.File->WriteChunk(Stream.ChunkTimes, Stream.ChunkValues);
+
+    Stream.WrittenSamples.fetch_add(Count, std::memory_order_relaxed);
+    Stream.Pending.Reset();
+}
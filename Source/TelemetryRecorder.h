@@ -0,0 +1,177 @@
+// TelemetryRecorder.h
+// Lock-free per-vehicle telemetry capture with a background binary writer
+// Copyright 2025. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "RacingVehicle.h"
+#include "TelemetryFileFormat.h"
+#include <atomic>
+
+class FRunnableThread;
+class FEvent;
+
+/**
+ * One telemetry record as captured by the simulation step
+ */
+struct FTelemetrySample
+{
+    double Time = 0.0;
+    FVehicleTelemetry Telemetry;
+};
+
+/**
+ * Scalar channels written to telemetry files, in file order.
+ * Time is stored separately as the first (double) column.
+ */
+namespace TelemetryChannels
+{
+    enum Type : int32
+    {
+        Speed,
+        EngineRPM,
+        Gear,
+        Throttle,
+        Brake,
+        Steering,
+        LateralG,
+        LongitudinalG,
+        SuspensionFL,
+        SuspensionFR,
+        SuspensionRL,
+        SuspensionRR,
+        VelocityX,
+        VelocityY,
+        VelocityZ,
+        YawRate,
+        Count
+    };
+
+    CARGAME_API const TCHAR* GetName(int32 Channel);
+
+    /** Quantization step used when the channel is written to file */
+    CARGAME_API float GetResolution(int32 Channel);
+
+    CARGAME_API float Read(const FVehicleTelemetry& Telemetry, int32 Channel);
+
+    /** Name and resolution of every channel, in file order */
+    CARGAME_API TArray<FTelemetryChannelDesc> MakeDescriptors();
+}
+
+/**
+ * Single-producer single-consumer ring of telemetry samples.
+ * The simulation step pushes, the writer thread pops. Neither side locks;
+ * when the writer falls behind, new samples are dropped and counted.
+ */
+class CARGAME_API FTelemetryRingBuffer
+{
+public:
+    /** Capacity is rounded up to a power of two */
+    explicit FTelemetryRingBuffer(uint32 InCapacity);
+
+    /** Producer side. Returns false and counts an overrun when full. */
+    bool Push(const FTelemetrySample& Sample);
+
+    /** Consumer side. Copies up to MaxSamples into Out, returns the number copied. */
+    int32 Pop(FTelemetrySample* Out, int32 MaxSamples);
+
+    uint32 GetCapacity() const { return Mask + 1; }
+    uint32 GetOverrunCount() const { return Overruns.load(std::memory_order_relaxed); }
+
+private:
+    TArray<FTelemetrySample> Samples;
+    uint32 Mask;
+
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> Head{0};  // next write, owned by producer
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> Tail{0};  // next read, owned by consumer
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> Overruns{0};
+};
+
+/**
+ * A recording in progress: one vehicle's ring buffer and its output file.
+ * The file is opened, written and closed on the writer thread only.
+ */
+class CARGAME_API FTelemetryStream
+{
+public:
+    FTelemetryStream(const FString& InFilePath, uint32 Capacity, bool bInCompress);
+
+    /** Producer side, called from the simulation step */
+    FORCEINLINE void Push(double Time, const FVehicleTelemetry& Telemetry)
+    {
+        FTelemetrySample Sample;
+        Sample.Time = Time;
+        Sample.Telemetry = Telemetry;
+        Buffer.Push(Sample);
+    }
+
+    /** Ask the writer to flush what is left and close the file */
+    void Close() { bCloseRequested.store(true, std::memory_order_release); }
+
+    bool IsCloseRequested() const { return bCloseRequested.load(std::memory_order_acquire); }
+
+    const FString& GetFilePath() const { return FilePath; }
+    uint32 GetOverrunCount() const { return Buffer.GetOverrunCount(); }
+    uint64 GetWrittenSampleCount() const { return WrittenSamples.load(std::memory_order_relaxed); }
+
+private:
+    friend class FTelemetryWriter;
+
+    FString FilePath;
+    bool bCompress;
+    FTelemetryRingBuffer Buffer;
+    std::atomic<bool> bCloseRequested{false};
+    std::atomic<uint64> WrittenSamples{0};
+
+    // Writer thread only
+    TUniquePtr<FTelemetryFileWriter> File;
+    TArray<FTelemetrySample> Pending;
+    TArray<double> ChunkTimes;
+    TArray<float> ChunkValues;
+};
+
+/**
+ * Background thread that drains every open FTelemetryStream into
+ * a chunked columnar file (see TelemetryFileFormat.h), one chunk per BlockSize samples.
+ */
+class CARGAME_API FTelemetryWriter : public FRunnable
+{
+public:
+    /** Samples gathered per stream before a chunk is written */
+    static constexpr int32 BlockSize = 512;
+
+    /** Writer wake-up interval */
+    static constexpr float DrainIntervalSeconds = 0.05f;
+
+    static FTelemetryWriter& Get();
+
+    /** Stop the thread and flush every stream; called on module shutdown */
+    static void Shutdown();
+
+    /** Start draining Stream. Cheap; the file is opened on the writer thread. */
+    TSharedRef<FTelemetryStream, ESPMode::ThreadSafe> OpenStream(const FString& FilePath, bool bCompress = true, uint32 Capacity = 4096);
+
+    // FRunnable
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+
+    virtual ~FTelemetryWriter();
+
+private:
+    FTelemetryWriter();
+
+    FCriticalSection StreamsLock;
+    TArray<TSharedRef<FTelemetryStream, ESPMode::ThreadSafe>> Streams;
+
+    FRunnableThread* Thread = nullptr;
+    FEvent* WakeEvent = nullptr;
+    std::atomic<bool> bStopRequested{false};
+
+    void DrainAll(bool bFinal);
+    bool DrainStream(FTelemetryStream& Stream, bool bFinal);
+    void WriteChunk(FTelemetryStream& Stream);
+
+    static TUniquePtr<FTelemetryWriter> Instance;
+};
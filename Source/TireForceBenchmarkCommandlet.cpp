@@ -0,0 +1,113 @@
+// TireForceBenchmarkCommandlet.cpp
+// Microbenchmark for the Pacejka tire force kernel
+// Copyright 2025. All Rights Reserved.
+
+#include "TireForceBenchmarkCommandlet.h"
+#include "TireForceKernel.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+
+UTireForceBenchmarkCommandlet::UTireForceBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 UTireForceBenchmarkCommandlet::Main(const FString& Params)
+{
+    int32 NumCars = 64;
+    int32 Iterations = 20000;
+    int32 Seed = 1;
+    FParse::Value(*Params, TEXT("Cars="), NumCars);
+    FParse::Value(*Params, TEXT("Iterations="), Iterations);
+    FParse::Value(*Params, TEXT("Seed="), Seed);
+    NumCars = FMath::Max(NumCars, 1);
+    Iterations = FMath::Max(Iterations, 1);
+
+    const double BuildStart = FPlatformTime::Seconds();
+    FPacejkaTireModel Model;
+    Model.BuildLookupTables();
+    const double BuildSeconds = FPlatformTime::Seconds() - BuildStart;
+
+    // One batch per car, realistic operating range
+    FRandomStream Random(Seed);
+    TArray<FTireForceBatch> Batches;
+    Batches.SetNum(NumCars);
+    for (FTireForceBatch& Batch : Batches)
+    {
+        for (int32 Lane = 0; Lane < 4; Lane++)
+        {
+            Batch.NormalLoad[Lane] = Random.FRandRange(1000.0f, 9000.0f);
+            Batch.SlipRatio[Lane] = Random.FRandRange(-0.3f, 0.3f);
+            Batch.SlipAngle[Lane] = Random.FRandRange(-0.25f, 0.25f);
+            Batch.GripScale[Lane] = Random.FRandRange(0.8f, 1.0f);
+        }
+    }
+
+    const int64 ForcesPerPass = static_cast<int64>(NumCars) * 4;
+    const int64 TotalForces = ForcesPerPass * Iterations;
+    float Checksum = 0.0f;
+
+    // Scalar reference
+    const double ScalarStart = FPlatformTime::Seconds();
+    for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+    {
+        for (FTireForceBatch& Batch : Batches)
+        {
+            for (int32 Lane = 0; Lane < 4; Lane++)
+            {
+                Model.EvaluateScalar(Batch.NormalLoad[Lane], Batch.SlipRatio[Lane], Batch.SlipAngle[Lane], Batch.GripScale[Lane],
+                    Batch.LongitudinalForce[Lane], Batch.LateralForce[Lane]);
+            }
+        }
+        Checksum += Batches[Iteration % NumCars].LateralForce[0];
+    }
+    const double ScalarSeconds = FPlatformTime::Seconds() - ScalarStart;
+
+    // Exact SIMD
+    const double ExactStart = FPlatformTime::Seconds();
+    for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+    {
+        Model.Evaluate(ETireForceEvaluation::Exact, Batches);
+        Checksum += Batches[Iteration % NumCars].LateralForce[0];
+    }
+    const double ExactSeconds = FPlatformTime::Seconds() - ExactStart;
+
+    TArray<FTireForceBatch> Reference = Batches;
+
+    // Lookup table
+    const double LookupStart = FPlatformTime::Seconds();
+    for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+    {
+        Model.Evaluate(ETireForceEvaluation::LookupTable, Batches);
+        Checksum += Batches[Iteration % NumCars].LateralForce[0];
+    }
+    const double LookupSeconds = FPlatformTime::Seconds() - LookupStart;
+
+    // Lookup error relative to the exact path
+    float MaxError = 0.0f;
+    for (int32 i = 0; i < NumCars; i++)
+    {
+        for (int32 Lane = 0; Lane < 4; Lane++)
+        {
+            MaxError = FMath::Max(MaxError, FMath::Abs(Batches[i].LongitudinalForce[Lane] - Reference[i].LongitudinalForce[Lane]));
+            MaxError = FMath::Max(MaxError, FMath::Abs(Batches[i].LateralForce[Lane] - Reference[i].LateralForce[Lane]));
+        }
+    }
+
+    auto ForcesPerSecond = [TotalForces](double Seconds)
+    {
+        return Seconds > 0.0 ? TotalForces / Seconds : 0.0;
+    };
+
+    UE_LOG(LogTemp, Display, TEXT("Tire force benchmark: %d cars, %d iterations, %lld wheel evaluations per mode"), NumCars, Iterations, TotalForces);
+    UE_LOG(LogTemp, Display, TEXT("  Table build:  %.2f ms"), BuildSeconds * 1000.0);
+    UE_LOG(LogTemp, Display, TEXT("  Scalar:       %.1f M forces/s"), ForcesPerSecond(ScalarSeconds) / 1.0e6);
+    UE_LOG(LogTemp, Display, TEXT("  Exact SIMD:   %.1f M forces/s"), ForcesPerSecond(ExactSeconds) / 1.0e6);
+    UE_LOG(LogTemp, Display, TEXT("  Lookup table: %.1f M forces/s (max error %.1f N)"), ForcesPerSecond(LookupSeconds) / 1.0e6, MaxError);
+    UE_LOG(LogTemp, Display, TEXT("  Checksum:     %f"), Checksum);
+
+    return 0;
+}
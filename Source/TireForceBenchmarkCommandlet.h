@@ -0,0 +1,27 @@
+// TireForceBenchmarkCommandlet.h
+// Microbenchmark for the Pacejka tire force kernel
+// Copyright 2025. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "TireForceBenchmarkCommandlet.generated.h"
+
+/**
+ * Measures tire forces evaluated per second for the scalar reference,
+ * exact SIMD and lookup table paths of FPacejkaTireModel.
+ *
+ * Usage:
+ *   UnrealEditor-Cmd CarGame.uproject -run=TireForceBenchmark [-Cars=64] [-Iterations=20000] [-Seed=1]
+ */
+UCLASS()
+class CARGAME_API UTireForceBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UTireForceBenchmarkCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
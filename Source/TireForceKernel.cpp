@@ -0,0 +1,319 @@
+// TireForceKernel.cpp
+// Magic Formula evaluation and lookup table baking
+// Copyright 2025. All Rights Reserved.
+
+#include "TireForceKernel.h"
+#include "Math/VectorRegister.h"
+
+FTireForceBatch::FTireForceBatch()
+{
+    for (int32 Lane = 0; Lane < 4; Lane++)
+    {
+        NormalLoad[Lane] = 0.0f;
+        SlipRatio[Lane] = 0.0f;
+        SlipAngle[Lane] = 0.0f;
+        GripScale[Lane] = 1.0f;
+        LongitudinalForce[Lane] = 0.0f;
+        LateralForce[Lane] = 0.0f;
+    }
+}
+
+namespace
+{
+    constexpr float ShapeEpsilon = 1.0e-3f;
+
+    // ============================================================
+    // SCALAR
+    // ============================================================
+
+    /** C * atan(B*x - E*(B*x - atan(B*x))) */
+    FORCEINLINE float MagicAngle(float B, float C, float E, float X)
+    {
+        const float BX = B * X;
+        return C * FMath::Atan(BX - E * (BX - FMath::Atan(BX)));
+    }
+
+    /** cos(atan(x)) without the trig */
+    FORCEINLINE float CosAtan(float X)
+    {
+        return FMath::InvSqrt(1.0f + X * X);
+    }
+
+    float PureLongitudinalForce(const FPacejkaCoefficients& P, float Fz, float Kappa, float Grip)
+    {
+        const float DFz = (Fz - P.FNomin) / P.FNomin;
+        const float Kx = Kappa + P.PHX1 + P.PHX2 * DFz;
+
+        const float Cx = P.PCX1;
+        const float Dx = (P.PDX1 + P.PDX2 * DFz) * P.LambdaMuX * Grip * Fz;
+        const float Ex = FMath::Min((P.PEX1 + P.PEX2 * DFz + P.PEX3 * DFz * DFz) * (1.0f - P.PEX4 * FMath::Sign(Kx)), 1.0f);
+        const float Kxk = Fz * (P.PKX1 + P.PKX2 * DFz) * FMath::Exp(P.PKX3 * DFz);
+        const float Bx = Kxk / (Cx * Dx + ShapeEpsilon);
+        const float SVx = Fz * (P.PVX1 + P.PVX2 * DFz) * P.LambdaMuX * Grip;
+
+        return Dx * FMath::Sin(MagicAngle(Bx, Cx, Ex, Kx)) + SVx;
+    }
+
+    float PureLateralForce(const FPacejkaCoefficients& P, float Fz, float Alpha, float Grip)
+    {
+        const float DFz = (Fz - P.FNomin) / P.FNomin;
+        const float Ay = Alpha + P.PHY1 + P.PHY2 * DFz;
+
+        const float Cy = P.PCY1;
+        const float Dy = (P.PDY1 + P.PDY2 * DFz) * P.LambdaMuY * Grip * Fz;
+        const float Ey = FMath::Min((P.PEY1 + P.PEY2 * DFz) * (1.0f - P.PEY3 * FMath::Sign(Ay)), 1.0f);
+        const float Kya = P.PKY1 * P.FNomin * FMath::Sin(P.PKY4 * FMath::Atan(Fz / (P.PKY2 * P.FNomin)));
+        const float By = Kya / (Cy * Dy + ShapeEpsilon);
+        const float SVy = Fz * (P.PVY1 + P.PVY2 * DFz) * P.LambdaMuY * Grip;
+
+        return Dy * FMath::Sin(MagicAngle(By, Cy, Ey, Ay)) + SVy;
+    }
+
+    /** Gxa: how much longitudinal force survives at slip angle Alpha */
+    float CombinedWeightLongitudinal(const FPacejkaCoefficients& P, float Fz, float Kappa, float Alpha)
+    {
+        const float DFz = (Fz - P.FNomin) / P.FNomin;
+        const float Bxa = P.RBX1 * CosAtan(P.RBX2 * Kappa);
+        const float Exa = FMath::Min(P.REX1 + P.REX2 * DFz, 1.0f);
+
+        return FMath::Cos(MagicAngle(Bxa, P.RCX1, Exa, Alpha + P.RHX1))
+            / FMath::Cos(MagicAngle(Bxa, P.RCX1, Exa, P.RHX1));
+    }
+
+    /** Gyk: how much lateral force survives at slip ratio Kappa */
+    float CombinedWeightLateral(const FPacejkaCoefficients& P, float Fz, float Kappa, float Alpha)
+    {
+        const float DFz = (Fz - P.FNomin) / P.FNomin;
+        const float Byk = P.RBY1 * CosAtan(P.RBY2 * (Alpha - P.RBY3));
+        const float Eyk = FMath::Min(P.REY1 + P.REY2 * DFz, 1.0f);
+        const float SHyk = P.RHY1 + P.RHY2 * DFz;
+
+        return FMath::Cos(MagicAngle(Byk, P.RCY1, Eyk, Kappa + SHyk))
+            / FMath::Cos(MagicAngle(Byk, P.RCY1, Eyk, SHyk));
+    }
+
+    // ============================================================
+    // SIMD
+    // ============================================================
+
+    FORCEINLINE VectorRegister4Float VectorMagicAngle(const VectorRegister4Float& B, const VectorRegister4Float& C, const VectorRegister4Float& E, const VectorRegister4Float& X)
+    {
+        const VectorRegister4Float BX = VectorMultiply(B, X);
+        const VectorRegister4Float Inner = VectorSubtract(BX, VectorMultiply(E, VectorSubtract(BX, VectorATan(BX))));
+        return VectorMultiply(C, VectorATan(Inner));
+    }
+
+    FORCEINLINE VectorRegister4Float VectorCosAtan(const VectorRegister4Float& X)
+    {
+        return VectorReciprocalSqrt(VectorMultiplyAdd(X, X, VectorOneFloat()));
+    }
+
+    FORCEINLINE VectorRegister4Float VectorSignNonZero(const VectorRegister4Float& X)
+    {
+        return VectorSelect(VectorCompareGE(X, VectorZeroFloat()), VectorOneFloat(), VectorSetFloat1(-1.0f));
+    }
+
+    FORCEINLINE VectorRegister4Float VectorPoly(float A, float B, const VectorRegister4Float& X)
+    {
+        return VectorMultiplyAdd(VectorSetFloat1(B), X, VectorSetFloat1(A));
+    }
+
+    // ============================================================
+    // LOOKUP
+    // ============================================================
+
+    /** Map Value in [-Range, Range] onto [0, Samples - 1] */
+    FORCEINLINE float ToSymmetricIndex(float Value, float Range, int32 Samples)
+    {
+        const float T = (FMath::Clamp(Value, -Range, Range) + Range) / (2.0f * Range);
+        return T * (Samples - 1);
+    }
+
+    FORCEINLINE float SampleBilinear(const TArray<float>& Table, int32 Columns, int32 Rows, float Column, float Row)
+    {
+        const int32 C0 = FMath::Min(FMath::FloorToInt(Column), Columns - 2);
+        const int32 R0 = FMath::Min(FMath::FloorToInt(Row), Rows - 2);
+        const float TC = Column - C0;
+        const float TR = Row - R0;
+
+        const float* Row0 = Table.GetData() + R0 * Columns + C0;
+        const float* Row1 = Row0 + Columns;
+
+        const float Top = FMath::Lerp(Row0[0], Row0[1], TC);
+        const float Bottom = FMath::Lerp(Row1[0], Row1[1], TC);
+        return FMath::Lerp(Top, Bottom, TR);
+    }
+}
+
+// ============================================================
+// MODEL
+// ============================================================
+
+FPacejkaTireModel::FPacejkaTireModel(const FPacejkaCoefficients& InCoefficients)
+    : Coefficients(InCoefficients)
+{
+}
+
+TSharedRef<const FPacejkaTireModel, ESPMode::ThreadSafe> FPacejkaTireModel::GetDefault()
+{
+    static const TSharedRef<const FPacejkaTireModel, ESPMode::ThreadSafe> DefaultModel = []()
+    {
+        TSharedRef<FPacejkaTireModel, ESPMode::ThreadSafe> Model = MakeShared<FPacejkaTireModel, ESPMode::ThreadSafe>();
+        Model->BuildLookupTables();
+        return Model;
+    }();
+    return DefaultModel;
+}
+
+void FPacejkaTireModel::BuildLookupTables()
+{
+    const FPacejkaCoefficients& P = Coefficients;
+
+    PureLongitudinal.SetNumUninitialized(LoadSamples * SlipRatioSamples);
+    PureLateral.SetNumUninitialized(LoadSamples * SlipAngleSamples);
+    CombinedWeightX.SetNumUninitialized(SlipAngleSamples * SlipRatioSamples);
+    CombinedWeightY.SetNumUninitialized(SlipAngleSamples * SlipRatioSamples);
+
+    for (int32 LoadIndex = 0; LoadIndex < LoadSamples; LoadIndex++)
+    {
+        const float Fz = P.FNomin * MaxLoadFactor * LoadIndex / (LoadSamples - 1);
+
+        for (int32 i = 0; i < SlipRatioSamples; i++)
+        {
+            const float Kappa = -MaxSlipRatio + 2.0f * MaxSlipRatio * i / (SlipRatioSamples - 1);
+            PureLongitudinal[LoadIndex * SlipRatioSamples + i] = PureLongitudinalForce(P, Fz, Kappa, 1.0f);
+        }
+
+        for (int32 i = 0; i < SlipAngleSamples; i++)
+        {
+            const float Alpha = -MaxSlipAngle + 2.0f * MaxSlipAngle * i / (SlipAngleSamples - 1);
+            PureLateral[LoadIndex * SlipAngleSamples + i] = PureLateralForce(P, Fz, Alpha, 1.0f);
+        }
+    }
+
+    // Combined weights barely move with load, so they are baked at nominal load
+    for (int32 AlphaIndex = 0; AlphaIndex < SlipAngleSamples; AlphaIndex++)
+    {
+        const float Alpha = -MaxSlipAngle + 2.0f * MaxSlipAngle * AlphaIndex / (SlipAngleSamples - 1);
+
+        for (int32 KappaIndex = 0; KappaIndex < SlipRatioSamples; KappaIndex++)
+        {
+            const float Kappa = -MaxSlipRatio + 2.0f * MaxSlipRatio * KappaIndex / (SlipRatioSamples - 1);
+            const int32 Index = AlphaIndex * SlipRatioSamples + KappaIndex;
+
+            CombinedWeightX[Index] = CombinedWeightLongitudinal(P, P.FNomin, Kappa, Alpha);
+            CombinedWeightY[Index] = CombinedWeightLateral(P, P.FNomin, Kappa, Alpha);
+        }
+    }
+}
+
+void FPacejkaTireModel::Evaluate(ETireForceEvaluation Mode, TArrayView<FTireForceBatch> Batches) const
+{
+    if (Mode == ETireForceEvaluation::LookupTable && HasLookupTables())
+    {
+        for (FTireForceBatch& Batch : Batches)
+        {
+            EvaluateLookup(Batch);
+        }
+    }
+    else
+    {
+        for (FTireForceBatch& Batch : Batches)
+        {
+            EvaluateExact(Batch);
+        }
+    }
+}
+
+void FPacejkaTireModel::EvaluateScalar(float NormalLoad, float SlipRatio, float SlipAngle, float GripScale, float& OutFx, float& OutFy) const
+{
+    const float Fz = FMath::Max(NormalLoad, 0.0f);
+    const FPacejkaCoefficients& P = Coefficients;
+
+    OutFx = PureLongitudinalForce(P, Fz, SlipRatio, GripScale) * CombinedWeightLongitudinal(P, Fz, SlipRatio, SlipAngle);
+    OutFy = PureLateralForce(P, Fz, SlipAngle, GripScale) * CombinedWeightLateral(P, Fz, SlipRatio, SlipAngle);
+}
+
+void FPacejkaTireModel::EvaluateExact(FTireForceBatch& Batch) const
+{
+    const FPacejkaCoefficients& P = Coefficients;
+
+    const VectorRegister4Float Zero = VectorZeroFloat();
+    const VectorRegister4Float One = VectorOneFloat();
+    const VectorRegister4Float Epsilon = VectorSetFloat1(ShapeEpsilon);
+
+    const VectorRegister4Float Fz = VectorMax(VectorLoadAligned(Batch.NormalLoad), Zero);
+    const VectorRegister4Float Kappa = VectorLoadAligned(Batch.SlipRatio);
+    const VectorRegister4Float Alpha = VectorLoadAligned(Batch.SlipAngle);
+    const VectorRegister4Float Grip = VectorLoadAligned(Batch.GripScale);
+
+    const VectorRegister4Float DFz = VectorMultiply(VectorSubtract(Fz, VectorSetFloat1(P.FNomin)), VectorSetFloat1(1.0f / P.FNomin));
+
+    // Longitudinal, pure slip
+    const VectorRegister4Float Kx = VectorAdd(Kappa, VectorPoly(P.PHX1, P.PHX2, DFz));
+    const VectorRegister4Float Cx = VectorSetFloat1(P.PCX1);
+    const VectorRegister4Float MuX = VectorMultiply(VectorPoly(P.PDX1, P.PDX2, DFz), VectorMultiply(VectorSetFloat1(P.LambdaMuX), Grip));
+    const VectorRegister4Float Dx = VectorMultiply(MuX, Fz);
+    const VectorRegister4Float ExPoly = VectorMultiplyAdd(VectorMultiply(DFz, DFz), VectorSetFloat1(P.PEX3), VectorPoly(P.PEX1, P.PEX2, DFz));
+    const VectorRegister4Float Ex = VectorMin(VectorMultiply(ExPoly, VectorSubtract(One, VectorMultiply(VectorSetFloat1(P.PEX4), VectorSignNonZero(Kx)))), One);
+    const VectorRegister4Float Kxk = VectorMultiply(VectorMultiply(Fz, VectorPoly(P.PKX1, P.PKX2, DFz)), VectorExp(VectorMultiply(VectorSetFloat1(P.PKX3), DFz)));
+    const VectorRegister4Float Bx = VectorDivide(Kxk, VectorMultiplyAdd(Cx, Dx, Epsilon));
+    const VectorRegister4Float SVx = VectorMultiply(VectorMultiply(Fz, VectorPoly(P.PVX1, P.PVX2, DFz)), VectorMultiply(VectorSetFloat1(P.LambdaMuX), Grip));
+    const VectorRegister4Float Fx0 = VectorMultiplyAdd(Dx, VectorSin(VectorMagicAngle(Bx, Cx, Ex, Kx)), SVx);
+
+    // Lateral, pure slip
+    const VectorRegister4Float Ay = VectorAdd(Alpha, VectorPoly(P.PHY1, P.PHY2, DFz));
+    const VectorRegister4Float Cy = VectorSetFloat1(P.PCY1);
+    const VectorRegister4Float MuY = VectorMultiply(VectorPoly(P.PDY1, P.PDY2, DFz), VectorMultiply(VectorSetFloat1(P.LambdaMuY), Grip));
+    const VectorRegister4Float Dy = VectorMultiply(MuY, Fz);
+    const VectorRegister4Float Ey = VectorMin(VectorMultiply(VectorPoly(P.PEY1, P.PEY2, DFz), VectorSubtract(One, VectorMultiply(VectorSetFloat1(P.PEY3), VectorSignNonZero(Ay)))), One);
+    const VectorRegister4Float LoadAngle = VectorATan(VectorMultiply(Fz, VectorSetFloat1(1.0f / (P.PKY2 * P.FNomin))));
+    const VectorRegister4Float Kya = VectorMultiply(VectorSetFloat1(P.PKY1 * P.FNomin), VectorSin(VectorMultiply(VectorSetFloat1(P.PKY4), LoadAngle)));
+    const VectorRegister4Float By = VectorDivide(Kya, VectorMultiplyAdd(Cy, Dy, Epsilon));
+    const VectorRegister4Float SVy = VectorMultiply(VectorMultiply(Fz, VectorPoly(P.PVY1, P.PVY2, DFz)), VectorMultiply(VectorSetFloat1(P.LambdaMuY), Grip));
+    const VectorRegister4Float Fy0 = VectorMultiplyAdd(Dy, VectorSin(VectorMagicAngle(By, Cy, Ey, Ay)), SVy);
+
+    // Combined slip weights
+    const VectorRegister4Float Bxa = VectorMultiply(VectorSetFloat1(P.RBX1), VectorCosAtan(VectorMultiply(VectorSetFloat1(P.RBX2), Kappa)));
+    const VectorRegister4Float Cxa = VectorSetFloat1(P.RCX1);
+    const VectorRegister4Float Exa = VectorMin(VectorPoly(P.REX1, P.REX2, DFz), One);
+    const VectorRegister4Float SHxa = VectorSetFloat1(P.RHX1);
+    const VectorRegister4Float Gxa = VectorDivide(
+        VectorCos(VectorMagicAngle(Bxa, Cxa, Exa, VectorAdd(Alpha, SHxa))),
+        VectorCos(VectorMagicAngle(Bxa, Cxa, Exa, SHxa)));
+
+    const VectorRegister4Float Byk = VectorMultiply(VectorSetFloat1(P.RBY1), VectorCosAtan(VectorMultiply(VectorSetFloat1(P.RBY2), VectorSubtract(Alpha, VectorSetFloat1(P.RBY3)))));
+    const VectorRegister4Float Cyk = VectorSetFloat1(P.RCY1);
+    const VectorRegister4Float Eyk = VectorMin(VectorPoly(P.REY1, P.REY2, DFz), One);
+    const VectorRegister4Float SHyk = VectorPoly(P.RHY1, P.RHY2, DFz);
+    const VectorRegister4Float Gyk = VectorDivide(
+        VectorCos(VectorMagicAngle(Byk, Cyk, Eyk, VectorAdd(Kappa, SHyk))),
+        VectorCos(VectorMagicAngle(Byk, Cyk, Eyk, SHyk)));
+
+    VectorStoreAligned(VectorMultiply(Fx0, Gxa), Batch.LongitudinalForce);
+    VectorStoreAligned(VectorMultiply(Fy0, Gyk), Batch.LateralForce);
+}
+
+void FPacejkaTireModel::EvaluateLookup(FTireForceBatch& Batch) const
+{
+    const float LoadScale = (LoadSamples - 1) / (Coefficients.FNomin * MaxLoadFactor);
+
+    for (int32 Lane = 0; Lane < 4; Lane++)
+    {
+        const float Fz = FMath::Max(Batch.NormalLoad[Lane], 0.0f);
+        const float LoadRow = FMath::Min(Fz * LoadScale, static_cast<float>(LoadSamples - 1));
+        const float KappaColumn = ToSymmetricIndex(Batch.SlipRatio[Lane], MaxSlipRatio, SlipRatioSamples);
+        const float AlphaColumn = ToSymmetricIndex(Batch.SlipAngle[Lane], MaxSlipAngle, SlipAngleSamples);
+
+        // Tables are baked at unit grip; peak force scales linearly with it
+        const float Grip = Batch.GripScale[Lane];
+        const float Fx0 = SampleBilinear(PureLongitudinal, SlipRatioSamples, LoadSamples, KappaColumn, LoadRow) * Grip;
+        const float Fy0 = SampleBilinear(PureLateral, SlipAngleSamples, LoadSamples, AlphaColumn, LoadRow) * Grip;
+
+        const float Gxa = SampleBilinear(CombinedWeightX, SlipRatioSamples, SlipAngleSamples, KappaColumn, AlphaColumn);
+        const float Gyk = SampleBilinear(CombinedWeightY, SlipRatioSamples, SlipAngleSamples, KappaColumn, AlphaColumn);
+
+        Batch.LongitudinalForce[Lane] = Fx0 * Gxa;
+        Batch.LateralForce[Lane] = Fy0 * Gyk;
+    }
+}
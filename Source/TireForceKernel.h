@@ -0,0 +1,148 @@
+// TireForceKernel.h
+// Pacejka Magic Formula (MF6.1) tire forces, exact SIMD and table-driven
+// Copyright 2025. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * How FPacejkaTireModel evaluates forces
+ */
+enum class ETireForceEvaluation : uint8
+{
+    /** Full Magic Formula, four wheels per SIMD register */
+    Exact,
+
+    /** Bilinear lookup into tables baked by BuildLookupTables() */
+    LookupTable
+};
+
+/**
+ * MF6.1 coefficients for steady-state pure and combined slip.
+ * Camber, inflation pressure and turn slip terms are omitted.
+ * Defaults describe a generic 205/60R15 road tire.
+ */
+struct FPacejkaCoefficients
+{
+    /** Nominal wheel load (N) */
+    float FNomin = 4000.0f;
+
+    // Longitudinal, pure slip
+    float PCX1 = 1.65f;
+    float PDX1 = 1.21f;
+    float PDX2 = -0.037f;
+    float PEX1 = 0.344f;
+    float PEX2 = 0.095f;
+    float PEX3 = -0.020f;
+    float PEX4 = 0.0f;
+    float PKX1 = 21.51f;
+    float PKX2 = -0.163f;
+    float PKX3 = 0.245f;
+    float PHX1 = 0.0f;
+    float PHX2 = 0.0f;
+    float PVX1 = 0.0f;
+    float PVX2 = 0.0f;
+
+    // Lateral, pure slip
+    float PCY1 = 1.30f;
+    float PDY1 = 1.05f;
+    float PDY2 = -0.15f;
+    float PEY1 = -0.80f;
+    float PEY2 = -0.60f;
+    float PEY3 = 0.0f;
+    float PKY1 = 15.3f;
+    float PKY2 = 1.72f;
+    float PKY4 = 2.0f;
+    float PHY1 = 0.0f;
+    float PHY2 = 0.0f;
+    float PVY1 = 0.0f;
+    float PVY2 = 0.0f;
+
+    // Combined slip weighting
+    float RBX1 = 12.35f;
+    float RBX2 = -10.77f;
+    float RCX1 = 1.09f;
+    float REX1 = 0.0f;
+    float REX2 = 0.0f;
+    float RHX1 = 0.0f;
+    float RBY1 = 6.46f;
+    float RBY2 = 4.20f;
+    float RBY3 = -0.015f;
+    float RCY1 = 1.08f;
+    float REY1 = 0.0f;
+    float REY2 = 0.0f;
+    float RHY1 = 0.0f;
+    float RHY2 = 0.0f;
+
+    /** Friction scaling (lambda mu) */
+    float LambdaMuX = 1.0f;
+    float LambdaMuY = 1.0f;
+};
+
+/**
+ * Four wheels laid out as SIMD lanes. Any number of batches can be
+ * evaluated in one call, so a full grid is a single contiguous pass.
+ * Sign convention: positive slip ratio drives, positive slip angle produces positive Fy.
+ */
+struct alignas(16) FTireForceBatch
+{
+    // Inputs
+    float NormalLoad[4];    // Fz (N)
+    float SlipRatio[4];     // kappa
+    float SlipAngle[4];     // alpha (rad)
+    float GripScale[4];     // surface friction multiplier
+
+    // Outputs
+    float LongitudinalForce[4]; // Fx (N)
+    float LateralForce[4];      // Fy (N)
+
+    FTireForceBatch();
+};
+
+/**
+ * Immutable once built; safe to share between vehicles and threads.
+ */
+class CARGAME_API FPacejkaTireModel
+{
+public:
+    explicit FPacejkaTireModel(const FPacejkaCoefficients& InCoefficients = FPacejkaCoefficients());
+
+    /** Default-coefficient model with baked tables, shared by every vehicle */
+    static TSharedRef<const FPacejkaTireModel, ESPMode::ThreadSafe> GetDefault();
+
+    /** Table extents; inputs outside the range are clamped to the edge */
+    static constexpr int32 SlipRatioSamples = 257;
+    static constexpr int32 SlipAngleSamples = 257;
+    static constexpr int32 LoadSamples = 17;
+    static constexpr float MaxSlipRatio = 1.0f;
+    static constexpr float MaxSlipAngle = 0.6f;     // rad
+    static constexpr float MaxLoadFactor = 3.0f;    // multiple of FNomin
+
+    /** Bake the pure-slip and combined-slip tables used by ETireForceEvaluation::LookupTable */
+    void BuildLookupTables();
+
+    bool HasLookupTables() const { return PureLongitudinal.Num() > 0; }
+
+    const FPacejkaCoefficients& GetCoefficients() const { return Coefficients; }
+
+    /** Evaluate every batch. LookupTable falls back to Exact when tables are not built. */
+    void Evaluate(ETireForceEvaluation Mode, TArrayView<FTireForceBatch> Batches) const;
+
+    /** Single wheel reference implementation */
+    void EvaluateScalar(float NormalLoad, float SlipRatio, float SlipAngle, float GripScale, float& OutFx, float& OutFy) const;
+
+private:
+    FPacejkaCoefficients Coefficients;
+
+    // [Load][SlipRatio] pure Fx0 and [Load][SlipAngle] pure Fy0
+    TArray<float> PureLongitudinal;
+    TArray<float> PureLateral;
+
+    // [SlipAngle][SlipRatio] combined-slip weights at nominal load
+    TArray<float> CombinedWeightX;
+    TArray<float> CombinedWeightY;
+
+    void EvaluateExact(FTireForceBatch& Batch) const;
+    void EvaluateLookup(FTireForceBatch& Batch) const;
+};
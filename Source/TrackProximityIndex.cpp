@@ -0,0 +1,110 @@
+// TrackProximityIndex.cpp
+// Sorted racing-line proximity queries
+// Copyright 2025. All Rights Reserved.
+
+#include "TrackProximityIndex.h"
+#include "Algo/BinarySearch.h"
+
+void FTrackProximityIndex::Reset(float InLapLength)
+{
+    Entries.Reset();
+    LapLength = InLapLength;
+}
+
+void FTrackProximityIndex::Add(float Distance, float Lateral, int32 Id)
+{
+    FTrackProximityEntry& Entry = Entries.AddDefaulted_GetRef();
+    Entry.Distance = Distance;
+    Entry.Lateral = Lateral;
+    Entry.Id = Id;
+}
+
+void FTrackProximityIndex::Build()
+{
+    // Ties broken on lateral offset then id so the order never depends on registration order
+    Entries.Sort([](const FTrackProximityEntry& A, const FTrackProximityEntry& B)
+    {
+        if (A.Distance != B.Distance)
+        {
+            return A.Distance < B.Distance;
+        }
+        if (A.Lateral != B.Lateral)
+        {
+            return A.Lateral < B.Lateral;
+        }
+        return A.Id < B.Id;
+    });
+}
+
+int32 FTrackProximityIndex::LowerBound(float Distance) const
+{
+    return Algo::LowerBoundBy(Entries, Distance, [](const FTrackProximityEntry& Entry) { return Entry.Distance; });
+}
+
+float FTrackProximityIndex::GapAhead(float Distance, float Other) const
+{
+    const float Gap = Other - Distance;
+    return Gap < 0.0f ? Gap + LapLength : Gap;
+}
+
+int32 FTrackProximityIndex::FindAhead(float Distance, float Lateral, float MaxGap, float HalfWidth, int32 IgnoreId, float& OutGap) const
+{
+    OutGap = MAX_FLT;
+
+    const int32 NumEntries = Entries.Num();
+    const int32 First = LowerBound(Distance);
+
+    // Walk forward around the lap until the gap exceeds MaxGap
+    for (int32 Step = 0; Step < NumEntries; Step++)
+    {
+        const FTrackProximityEntry& Entry = Entries[(First + Step) % NumEntries];
+        const float Gap = GapAhead(Distance, Entry.Distance);
+        if (Gap > MaxGap)
+        {
+            break;
+        }
+
+        if (Entry.Id != IgnoreId && FMath::Abs(Entry.Lateral - Lateral) <= HalfWidth)
+        {
+            OutGap = Gap;
+            return (First + Step) % NumEntries;
+        }
+    }
+
+    return INDEX_NONE;
+}
+
+int32 FTrackProximityIndex::FindInWindow(float Distance, float Behind, float Ahead, float MinLateral, float MaxLateral, int32 IgnoreId) const
+{
+    const int32 NumEntries = Entries.Num();
+    if (NumEntries == 0)
+    {
+        return INDEX_NONE;
+    }
+
+    // Start at the back of the window and walk forward through it
+    float WindowStart = Distance - Behind;
+    if (WindowStart < 0.0f)
+    {
+        WindowStart += LapLength;
+    }
+    const float WindowLength = FMath::Min(Behind + Ahead, LapLength);
+    const int32 First = LowerBound(WindowStart);
+
+    for (int32 Step = 0; Step < NumEntries; Step++)
+    {
+        const int32 Index = (First + Step) % NumEntries;
+        const FTrackProximityEntry& Entry = Entries[Index];
+        if (GapAhead(WindowStart, Entry.Distance) > WindowLength)
+        {
+            break;
+        }
+
+        if (Entry.Id != IgnoreId && Entry.Lateral >= MinLateral && Entry.Lateral <= MaxLateral)
+        {
+            return Index;
+        }
+    }
+
+    return INDEX_NONE;
+}
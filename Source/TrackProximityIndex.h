@@ -0,0 +1,65 @@
+// TrackProximityIndex.h
+// Cars sorted by racing-line distance for ahead/alongside queries without physics traces
+// Copyright 2025. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * One car projected onto the racing line
+ */
+struct FTrackProximityEntry
+{
+    float Distance = 0.0f;  // arc length along the line (cm)
+    float Lateral = 0.0f;   // signed offset from the line (cm, positive to the right)
+    int32 Id = INDEX_NONE;
+};
+
+/**
+ * Every car on a closed racing line, sorted by arc length then lateral offset.
+ *
+ * Rebuilt once per frame from positions the AI already projects onto the line.
+ * "Who is ahead of me" and "is this lane free" become a binary search plus a
+ * short walk over neighbours instead of a physics trace per car. Queries wrap
+ * across the start/finish line. Read-only after Build, so worker threads may
+ * query it concurrently.
+ */
+class CARGAME_API FTrackProximityIndex
+{
+public:
+    /** Clear all entries for a lap of LapLength (cm) */
+    void Reset(float InLapLength);
+
+    void Add(float Distance, float Lateral, int32 Id);
+
+    /** Sort the entries. Call once after the last Add. */
+    void Build();
+
+    int32 Num() const { return Entries.Num(); }
+    float GetLapLength() const { return LapLength; }
+    const TArray<FTrackProximityEntry>& GetEntries() const { return Entries; }
+
+    /**
+     * Closest car at most MaxGap (cm) ahead of Distance whose lateral offset is within
+     * HalfWidth of Lateral, skipping IgnoreId. Returns its entry index or INDEX_NONE;
+     * OutGap receives the arc-length gap (cm).
+     */
+    int32 FindAhead(float Distance, float Lateral, float MaxGap, float HalfWidth, int32 IgnoreId, float& OutGap) const;
+
+    /**
+     * First car between Behind (cm) behind and Ahead (cm) ahead of Distance with a lateral
+     * offset in [MinLateral, MaxLateral], skipping IgnoreId. INDEX_NONE when the lane is free.
+     */
+    int32 FindInWindow(float Distance, float Behind, float Ahead, float MinLateral, float MaxLateral, int32 IgnoreId) const;
+
+private:
+    TArray<FTrackProximityEntry> Entries;
+    float LapLength = 0.0f;
+
+    /** First entry at or past Distance (may be Num()) */
+    int32 LowerBound(float Distance) const;
+
+    /** Arc length from Distance forward to Other, wrapped into [0, LapLength) */
+    float GapAhead(float Distance, float Other) const;
+};
@@ -0,0 +1,47 @@
+// VehicleAsyncPhysicsCallback.cpp
+// Physics-thread aerodynamics
+// Copyright 2025. All Rights Reserved.
+
+#include "VehicleAsyncPhysicsCallback.h"
+#include "VehicleSimulationSubsystem.h"
+#include "PhysicsProxy/SingleParticlePhysicsProxy.h"
+
+DECLARE_CYCLE_STAT(TEXT("Vehicle Sim Async Substep"), STAT_VehicleSim_AsyncSubstep, STATGROUP_VehicleSim);
+
+void FVehicleAsyncPhysicsCallback::OnPreSimulate_Internal()
+{
+    SCOPE_CYCLE_COUNTER(STAT_VehicleSim_AsyncSubstep);
+    VehicleSim::FScopedStage Stage(VehicleSim::EStage::Aerodynamics);
+
+    const FVehicleAsyncPhysicsInput* Input = GetConsumerInput_Internal();
+    if (!Input)
+    {
+        return;
+    }
+
+    FVehicleAsyncPhysicsOutput& Output = GetProducerOutputData_Internal();
+    Output.SubstepDeltaTime = GetDeltaTime_Internal();
+
+    for (int32 i = 0; i < Input->Vehicles.Num(); i++)
+    {
+        const FVehicleAsyncBodyInput& Vehicle = Input->Vehicles[i];
+        if (!Vehicle.Proxy)
+        {
+            continue;
+        }
+
+        Chaos::FRigidBodyHandle_Internal* Handle = Vehicle.Proxy->GetPhysicsThreadAPI();
+        if (!Handle || !Handle->IsDynamic())
+        {
+            continue;
+        }
+
+        // Velocity is read at this substep, so drag and downforce track the body
+        // instead of being held constant across a long game frame
+        const FVector AeroForce = VehicleSim::ComputeAerodynamicForce(Handle->V(), Vehicle.DragFactor, Vehicle.DownforceFactor);
+        if (!AeroForce.IsZero())
+        {
+            Handle->AddForce(AeroForce);
+        }
+    }
+}
@@ -0,0 +1,74 @@
+// VehicleAsyncPhysicsCallback.h
+// Chaos sim callback that applies aerodynamics on the physics thread
+// Copyright 2025. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Chaos/SimCallbackObject.h"
+#include "Chaos/SimCallbackInput.h"
+
+namespace Chaos
+{
+    class FSingleParticlePhysicsProxy;
+}
+
+/**
+ * Per-vehicle data marshalled from the game thread every frame
+ */
+struct FVehicleAsyncBodyInput
+{
+    Chaos::FSingleParticlePhysicsProxy* Proxy = nullptr;
+
+    /** Slot in UVehicleSimulationSubsystem */
+    int32 Slot = INDEX_NONE;
+
+    float DragFactor = 0.0f;
+    float DownforceFactor = 0.0f;
+};
+
+struct FVehicleAsyncPhysicsInput : public Chaos::FSimCallbackInput
+{
+    TArray<FVehicleAsyncBodyInput> Vehicles;
+
+    void Reset()
+    {
+        Vehicles.Reset();
+    }
+};
+
+/**
+ * Results produced by the last physics substep
+ */
+struct FVehicleAsyncPhysicsOutput : public Chaos::FSimCallbackOutput
+{
+    /** Fixed substep used for this output */
+    float SubstepDeltaTime = 0.0f;
+
+    void Reset()
+    {
+        SubstepDeltaTime = 0.0f;
+    }
+};
+
+/**
+ * Runs once per physics substep on the physics thread.
+ * With async physics enabled (project setting or CarGame.VehicleSim.AsyncPhysicsTick)
+ * the solver steps at a fixed rate (AsyncFixedTimeStepSize, 240 Hz in DefaultEngine.ini)
+ * independent of frame rate.
+ */
+class CARGAME_API FVehicleAsyncPhysicsCallback : public Chaos::TSimCallbackObject<
+    FVehicleAsyncPhysicsInput,
+    FVehicleAsyncPhysicsOutput,
+    Chaos::ESimCallbackOptions::Presimulate>
+{
+public:
+    virtual FName GetFNameForStatId() const override
+    {
+        const static FLazyName StaticName("FVehicleAsyncPhysicsCallback");
+        return StaticName;
+    }
+
+private:
+    virtual void OnPreSimulate_Internal() override;
+};
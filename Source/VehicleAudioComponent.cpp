@@ -4,6 +4,7 @@
 
 #include "VehicleAudioComponent.h"
 #include "RacingVehicle.h"
+#include "VehicleSimulationSubsystem.h"
 #include "Components/AudioComponent.h"
 #include "Sound/SoundBase.h"
 #include "Kismet/GameplayStatics.h"
@@ -35,6 +36,12 @@ void UVehicleAudioComponent::BeginPlay()
 
     OwnerVehicle = Cast<ARacingVehicle>(GetOwner());
 
+    // Read the vehicle's frame state after it is published
+    if (UVehicleSimulationSubsystem* Simulation = GetWorld()->GetSubsystem<UVehicleSimulationSubsystem>())
+    {
+        Simulation->AddFrameStateConsumer(PrimaryComponentTick);
+    }
+
     // Create audio components
     if (EngineMidRPMSound)
     {
@@ -188,11 +195,8 @@ float UVehicleAudioComponent::GetEngineRPMNormalized()
     if (!OwnerVehicle)
         return 0.0f;
 
-    FVehicleTelemetry Telemetry = OwnerVehicle->GetTelemetry();
-    float RPM = Telemetry.EngineRPM;
-    float MaxRPM = OwnerVehicle->MaxEngineRPM;
-
-    return FMath::Clamp(RPM / MaxRPM, 0.0f, 1.0f);
+    // Real engine speed, read from the simulation once per frame by the vehicle
+    return OwnerVehicle->GetFrameState().EngineRPMNormalized;
 }
 
 float UVehicleAudioComponent::GetTireSlipAmount()
@@ -200,13 +204,8 @@ float UVehicleAudioComponent::GetTireSlipAmount()
     if (!OwnerVehicle)
         return 0.0f;
 
-    FVehicleTelemetry Telemetry = OwnerVehicle->GetTelemetry();
-    
-    // Simplified slip calculation based on lateral G-force
-    float LateralSlip = FMath::Abs(Telemetry.LateralG) / 2.0f;
-    float LongitudinalSlip = FMath::Abs(Telemetry.LongitudinalG) / 2.0f;
-    
-    return FMath::Max(LateralSlip, LongitudinalSlip);
+    // Simplified slip calculation based on G-forces
+    return OwnerVehicle->GetFrameState().TireSlip;
 }
 
 float UVehicleAudioComponent::GetVehicleSpeed()
@@ -214,5 +213,5 @@ float UVehicleAudioComponent::GetVehicleSpeed()
     if (!OwnerVehicle)
         return 0.0f;
 
-    return OwnerVehicle->GetTelemetry().Speed;
+    return OwnerVehicle->GetFrameState().Speed;
 }
@@ -0,0 +1,377 @@
+// VehicleSimBenchmarkCommandlet.cpp
+// Headless fixed-step vehicle simulation throughput and determinism harness
+// Copyright 2025. All Rights Reserved.
+
+#include "VehicleSimBenchmarkCommandlet.h"
+#include "RacingVehicle.h"
+#include "VehicleSimulationSubsystem.h"
+#include "ProceduralTrackGenerator.h"
+#include "HeadlessCircuit.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Components/StaticMeshComponent.h"
+#include "GameFramework/WorldSettings.h"
+#include "Physics/Experimental/PhysScene_Chaos.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/App.h"
+#include "Misc/Crc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+
+namespace
+{
+    constexpr int32 NumStages = static_cast<int32>(VehicleSim::EStage::Count);
+
+    struct FBenchmarkSettings
+    {
+        int32 NumVehicles = 32;
+        float Seconds = 60.0f;
+        float StepSeconds = 1.0f / 60.0f;
+        int32 Seed = 1;
+        bool bCircuit = false;
+        UClass* VehicleClass = nullptr;
+    };
+
+    struct FBenchmarkResult
+    {
+        int32 NumVehicles = 0;
+        int32 Steps = 0;
+        double WallSeconds = 0.0;
+        double ChaosSeconds = 0.0;
+        double StageSeconds[NumStages] = {};
+        uint32 Checksum = 0;
+    };
+
+    /** Per-vehicle scripted driver: smooth throttle and steering sweeps with periodic braking */
+    struct FScriptedDriver
+    {
+        float Phase = 0.0f;
+
+        void Apply(ARacingVehicle* Vehicle, float Time) const
+        {
+            const bool bBraking = FMath::Fmod(Time + Phase, 10.0f) > 8.5f;
+            Vehicle->SetThrottle(bBraking ? 0.0f : 0.75f + 0.25f * FMath::Sin(0.4f * Time + Phase));
+            Vehicle->SetBrake(bBraking ? 0.6f : 0.0f);
+            Vehicle->SetSteering(0.3f * FMath::Sin(0.25f * Time + Phase));
+        }
+    };
+
+    void SpawnGround(UWorld* World, float Z)
+    {
+        UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+        AStaticMeshActor* Ground = World->SpawnActor<AStaticMeshActor>(FVector(0.0f, 0.0f, Z), FRotator::ZeroRotator);
+        if (!Ground || !Cube)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("VehicleSimBenchmark: could not create the ground plane"));
+            return;
+        }
+
+        // 2 km square, 1 m thick
+        UStaticMeshComponent* Mesh = Ground->GetStaticMeshComponent();
+        Mesh->SetMobility(EComponentMobility::Movable);
+        Mesh->SetStaticMesh(Cube);
+        Mesh->SetWorldScale3D(FVector(2000.0f, 2000.0f, 1.0f));
+        Mesh->SetCollisionProfileName(TEXT("BlockAll"));
+    }
+
+    /** Four cars per row, rows stacked behind the origin */
+    FTransform GetGridTransform(int32 Index, const FVector& Origin, const FRotator& Rotation)
+    {
+        const int32 Row = Index / 4;
+        const int32 Column = Index % 4;
+        const FVector Offset(-Row * 1000.0f, (Column - 1.5f) * 500.0f, 100.0f);
+        return FTransform(Rotation, Origin + Rotation.RotateVector(Offset));
+    }
+
+    uint32 FoldVehicleState(const FVehicleFrameState& State, uint32 Crc)
+    {
+        const FVector Location = State.Transform.GetLocation();
+        const FQuat Rotation = State.Transform.GetRotation();
+        Crc = FCrc::MemCrc32(&Location, sizeof(Location), Crc);
+        Crc = FCrc::MemCrc32(&Rotation, sizeof(Rotation), Crc);
+        Crc = FCrc::MemCrc32(&State.Velocity, sizeof(State.Velocity), Crc);
+        return FCrc::MemCrc32(&State.AngularVelocity, sizeof(State.AngularVelocity), Crc);
+    }
+
+    bool RunScenario(const FBenchmarkSettings& Settings, FBenchmarkResult& OutResult)
+    {
+        UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("VehicleSimBenchmark"));
+        FWorldContext& Context = GEngine->CreateNewWorldContext(EWorldType::Game);
+        Context.SetCurrentWorld(World);
+
+        World->InitializeActorsForPlay(FURL());
+        World->BeginPlay();
+        if (!World->HasBegunPlay())
+        {
+            // No game mode in this world; start actors directly
+            World->GetWorldSettings()->NotifyBeginPlay();
+        }
+
+        FVector GridOrigin = FVector::ZeroVector;
+        FRotator GridRotation = FRotator::ZeroRotator;
+
+        if (Settings.bCircuit)
+        {
+            const FTrackLayout Layout = FHeadlessCircuit::MakeLayout(Settings.Seed);
+            FHeadlessCircuit::SpawnSurface(World, Layout);
+            GridOrigin = Layout.StartLineLocation;
+            GridRotation = Layout.StartLineRotation;
+        }
+
+        // Catch cars that leave the circuit
+        SpawnGround(World, GridOrigin.Z - 60.0f);
+
+        FRandomStream Random(Settings.Seed);
+        TArray<ARacingVehicle*> Vehicles;
+        TArray<FScriptedDriver> Drivers;
+
+        for (int32 i = 0; i < Settings.NumVehicles; i++)
+        {
+            FActorSpawnParameters SpawnParams;
+            SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+            const FTransform Transform = GetGridTransform(i, GridOrigin, GridRotation);
+            ARacingVehicle* Vehicle = World->SpawnActor<ARacingVehicle>(Settings.VehicleClass, Transform, SpawnParams);
+            if (Vehicle)
+            {
+                Vehicles.Add(Vehicle);
+                Drivers.AddDefaulted_GetRef().Phase = Random.FRandRange(0.0f, 2.0f * PI);
+            }
+        }
+
+        if (Vehicles.Num() == 0)
+        {
+            UE_LOG(LogTemp, Error, TEXT("VehicleSimBenchmark: no vehicles could be spawned"));
+            GEngine->DestroyWorldContext(World);
+            World->DestroyWorld(false);
+            return false;
+        }
+
+        // Samples must see the step they follow. With async physics World->Tick returns before
+        // the solver has produced that step's results, so this world steps synchronously.
+        FPhysScene_Chaos* PhysScene = World->GetPhysicsScene();
+        if (PhysScene && PhysScene->GetSolver() && PhysScene->GetSolver()->IsUsingAsyncResults())
+        {
+            PhysScene->GetSolver()->DisableAsyncMode();
+            UE_LOG(LogTemp, Display, TEXT("VehicleSimBenchmark: async physics stepped synchronously for the run"));
+        }
+
+        // Chaos step time from the scene's own pre/post tick notifications
+        uint64 ChaosStartCycles = 0;
+        uint64 ChaosCycles = 0;
+        FDelegateHandle PreTickHandle;
+        FDelegateHandle PostTickHandle;
+        if (PhysScene)
+        {
+            PreTickHandle = PhysScene->OnPhysScenePreTick.AddLambda([&ChaosStartCycles](FPhysScene_Chaos*, float)
+            {
+                ChaosStartCycles = FPlatformTime::Cycles64();
+            });
+            PostTickHandle = PhysScene->OnPhysScenePostTick.AddLambda([&ChaosStartCycles, &ChaosCycles](FPhysScene_Chaos*)
+            {
+                ChaosCycles += FPlatformTime::Cycles64() - ChaosStartCycles;
+            });
+        }
+
+        const int32 NumSteps = FMath::Max(1, FMath::RoundToInt(Settings.Seconds / Settings.StepSeconds));
+
+        VehicleSim::FScopedFixedStep FixedStep(Settings.StepSeconds);
+
+        VehicleSim::FStageProfiler::Reset();
+        VehicleSim::FStageProfiler::bEnabled.store(true, std::memory_order_relaxed);
+
+        uint32 Checksum = 0;
+        const double StartSeconds = FPlatformTime::Seconds();
+
+        for (int32 Step = 0; Step < NumSteps; Step++)
+        {
+            const float Time = Step * Settings.StepSeconds;
+            for (int32 i = 0; i < Vehicles.Num(); i++)
+            {
+                Drivers[i].Apply(Vehicles[i], Time);
+            }
+
+            FixedStep.Advance();
+            World->Tick(LEVELTICK_All, Settings.StepSeconds);
+            GFrameCounter++;
+
+            for (const ARacingVehicle* Vehicle : Vehicles)
+            {
+                Checksum = FoldVehicleState(Vehicle->GetFrameState(), Checksum);
+            }
+        }
+
+        OutResult.WallSeconds = FPlatformTime::Seconds() - StartSeconds;
+        VehicleSim::FStageProfiler::bEnabled.store(false, std::memory_order_relaxed);
+
+        OutResult.NumVehicles = Vehicles.Num();
+        OutResult.Steps = NumSteps;
+        OutResult.Checksum = Checksum;
+        OutResult.ChaosSeconds = FPlatformTime::ToSeconds64(ChaosCycles);
+        for (int32 Stage = 0; Stage < NumStages; Stage++)
+        {
+            OutResult.StageSeconds[Stage] = VehicleSim::FStageProfiler::GetSeconds(static_cast<VehicleSim::EStage>(Stage));
+        }
+
+        if (PhysScene)
+        {
+            PhysScene->OnPhysScenePreTick.Remove(PreTickHandle);
+            PhysScene->OnPhysScenePostTick.Remove(PostTickHandle);
+        }
+
+        GEngine->DestroyWorldContext(World);
+        World->DestroyWorld(false);
+        return true;
+    }
+
+    void LogResult(const FBenchmarkSettings& Settings, const FBenchmarkResult& Result)
+    {
+        const double StepsPerSecond = Result.WallSeconds > 0.0 ? Result.Steps / Result.WallSeconds : 0.0;
+        const double MsPerStep = 1000.0 / FMath::Max(Result.Steps, 1);
+
+        UE_LOG(LogTemp, Display, TEXT("Vehicle sim benchmark: %d vehicles, %d steps of %.4f s, %s, %d cores"),
+            Result.NumVehicles, Result.Steps, Settings.StepSeconds, Settings.bCircuit ? TEXT("circuit") : TEXT("flat"),
+            FPlatformMisc::NumberOfCores());
+        UE_LOG(LogTemp, Display, TEXT("  Wall time:       %.2f s"), Result.WallSeconds);
+        UE_LOG(LogTemp, Display, TEXT("  Sim steps/s:     %.1f (%.0f vehicle-steps/s)"), StepsPerSecond, StepsPerSecond * Result.NumVehicles);
+        for (int32 Stage = 0; Stage < NumStages; Stage++)
+        {
+            UE_LOG(LogTemp, Display, TEXT("  %-16s %.3f ms/step"), *FString::Printf(TEXT("%s:"), VehicleSim::FStageProfiler::GetName(static_cast<VehicleSim::EStage>(Stage))),
+                Result.StageSeconds[Stage] * MsPerStep);
+        }
+        UE_LOG(LogTemp, Display, TEXT("  Chaos step:      %.3f ms/step (includes assists and tire forces)"), Result.ChaosSeconds * MsPerStep);
+        UE_LOG(LogTemp, Display, TEXT("  Checksum:        %08x"), Result.Checksum);
+    }
+
+    void AppendReport(const FString& Path, const FBenchmarkSettings& Settings, const FBenchmarkResult& Result)
+    {
+        const double StepsPerSecond = Result.WallSeconds > 0.0 ? Result.Steps / Result.WallSeconds : 0.0;
+        const double MsPerStep = 1000.0 / FMath::Max(Result.Steps, 1);
+
+        FString Text;
+        if (!FPaths::FileExists(Path))
+        {
+            Text = TEXT("Date,Vehicles,Steps,StepSeconds,Track,StepsPerSecond");
+            for (int32 Stage = 0; Stage < NumStages; Stage++)
+            {
+                Text += FString::Printf(TEXT(",%sMs"), VehicleSim::FStageProfiler::GetName(static_cast<VehicleSim::EStage>(Stage)));
+            }
+            Text += TEXT(",ChaosMs,Checksum") LINE_TERMINATOR;
+        }
+
+        Text += FString::Printf(TEXT("%s,%d,%d,%f,%s,%.2f"), *FDateTime::UtcNow().ToIso8601(), Result.NumVehicles, Result.Steps,
+            Settings.StepSeconds, Settings.bCircuit ? TEXT("Circuit") : TEXT("Flat"), StepsPerSecond);
+        for (int32 Stage = 0; Stage < NumStages; Stage++)
+        {
+            Text += FString::Printf(TEXT(",%.4f"), Result.StageSeconds[Stage] * MsPerStep);
+        }
+        Text += FString::Printf(TEXT(",%.4f,%08x"), Result.ChaosSeconds * MsPerStep, Result.Checksum) + LINE_TERMINATOR;
+
+        FFileHelper::SaveStringToFile(Text, *Path, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &IFileManager::Get(), FILEWRITE_Append);
+    }
+}
+
+UVehicleSimBenchmarkCommandlet::UVehicleSimBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 UVehicleSimBenchmarkCommandlet::Main(const FString& Params)
+{
+    FBenchmarkSettings Settings;
+    int32 Hz = 60;
+    int32 Repeat = 1;
+    FString Track;
+    FString VehicleClassPath;
+    FString ReportPath;
+
+    FParse::Value(*Params, TEXT("Vehicles="), Settings.NumVehicles);
+    FParse::Value(*Params, TEXT("Seconds="), Settings.Seconds);
+    FParse::Value(*Params, TEXT("Hz="), Hz);
+    FParse::Value(*Params, TEXT("Seed="), Settings.Seed);
+    FParse::Value(*Params, TEXT("Repeat="), Repeat);
+    FParse::Value(*Params, TEXT("Track="), Track);
+    FParse::Value(*Params, TEXT("VehicleClass="), VehicleClassPath);
+    FParse::Value(*Params, TEXT("Report="), ReportPath);
+
+    Settings.NumVehicles = FMath::Max(Settings.NumVehicles, 1);
+    Settings.Seconds = FMath::Max(Settings.Seconds, 0.1f);
+    Settings.StepSeconds = 1.0f / FMath::Clamp(Hz, 10, 1000);
+    Settings.bCircuit = Track.Equals(TEXT("Circuit"), ESearchCase::IgnoreCase);
+    Repeat = FMath::Max(Repeat, 1);
+
+    // Native ARacingVehicle has no mesh or wheels, so Chaos would have nothing to step and the timings would be meaningless
+    if (VehicleClassPath.IsEmpty())
+    {
+        UE_LOG(LogTemp, Error, TEXT("VehicleSimBenchmark: -VehicleClass= is required (a vehicle Blueprint with a mesh and wheels)"));
+        return 1;
+    }
+    Settings.VehicleClass = LoadClass<ARacingVehicle>(nullptr, *VehicleClassPath);
+    if (!Settings.VehicleClass)
+    {
+        UE_LOG(LogTemp, Error, TEXT("VehicleSimBenchmark: %s is not an ARacingVehicle class"), *VehicleClassPath);
+        return 1;
+    }
+    if (!Settings.VehicleClass->GetDefaultObject<ARacingVehicle>()->HasSimulatedBody())
+    {
+        UE_LOG(LogTemp, Error, TEXT("VehicleSimBenchmark: %s has no skeletal mesh or no wheels to simulate"), *VehicleClassPath);
+        return 1;
+    }
+
+    // Restored before returning, like the FApp timing each run changes
+    IConsoleVariable* Parallel = IConsoleManager::Get().FindConsoleVariable(TEXT("CarGame.VehicleSim.Parallel"));
+    const int32 PreviousParallel = Parallel ? Parallel->GetInt() : 1;
+    if (Parallel && FParse::Param(*Params, TEXT("SingleThread")))
+    {
+        Parallel->Set(0);
+    }
+    ON_SCOPE_EXIT
+    {
+        if (Parallel)
+        {
+            Parallel->Set(PreviousParallel);
+        }
+    };
+
+    uint32 FirstChecksum = 0;
+    bool bDeterministic = true;
+
+    for (int32 Run = 0; Run < Repeat; Run++)
+    {
+        FBenchmarkResult Result;
+        if (!RunScenario(Settings, Result))
+        {
+            return 1;
+        }
+
+        LogResult(Settings, Result);
+        if (!ReportPath.IsEmpty())
+        {
+            AppendReport(ReportPath, Settings, Result);
+        }
+
+        if (Run == 0)
+        {
+            FirstChecksum = Result.Checksum;
+        }
+        else if (Result.Checksum != FirstChecksum)
+        {
+            bDeterministic = false;
+            UE_LOG(LogTemp, Error, TEXT("VehicleSimBenchmark: run %d checksum %08x differs from run 0 (%08x)"), Run, Result.Checksum, FirstChecksum);
+        }
+    }
+
+    if (Repeat > 1 && bDeterministic)
+    {
+        UE_LOG(LogTemp, Display, TEXT("VehicleSimBenchmark: %d runs produced identical state"), Repeat);
+    }
+    return bDeterministic ? 0 : 1;
+}
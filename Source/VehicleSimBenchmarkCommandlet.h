@@ -0,0 +1,38 @@
+// VehicleSimBenchmarkCommandlet.h
+// Headless fixed-step vehicle simulation throughput and determinism harness
+// Copyright 2025. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "VehicleSimBenchmarkCommandlet.generated.h"
+
+/**
+ * Spawns N racing vehicles in a private game world, drives them with scripted
+ * inputs at a fixed timestep and reports simulation steps per second, time per
+ * stage (gather, aerodynamics, telemetry, scatter, frame state, assists, tire
+ * forces, Chaos step) and a checksum of every vehicle's state after every step.
+ * Needs no GPU; run it with -nullrhi on build machines to track regressions.
+ *
+ * Usage:
+ *   UnrealEditor-Cmd CarGame.uproject -run=VehicleSimBenchmark -nullrhi -unattended
+ *     -VehicleClass=/Game/Vehicles/BP_Car.BP_Car_C
+ *     [-Vehicles=32] [-Seconds=60] [-Hz=60] [-Seed=1] [-Track=Flat|Circuit]
+ *     [-Repeat=2] [-SingleThread] [-Report=Saved/VehicleSimBenchmark.csv]
+ *
+ * -VehicleClass must have a skeletal mesh and wheel setups; native ARacingVehicle has neither.
+ *
+ * With -Repeat greater than 1 the scenario is run again in a fresh world and the
+ * checksums are compared; the commandlet fails if they differ.
+ */
+UCLASS()
+class CARGAME_API UVehicleSimBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UVehicleSimBenchmarkCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
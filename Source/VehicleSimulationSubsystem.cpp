@@ -0,0 +1,954 @@
+// VehicleSimulationSubsystem.cpp
+// Batched vehicle simulation implementation
+// Copyright 2025. All Rights Reserved.
+
+#include "VehicleSimulationSubsystem.h"
+#include "VehicleAsyncPhysicsCallback.h"
+#include "RacingVehicle.h"
+#include "RacingVehicleMovementComponent.h"
+#include "TelemetryRecorder.h"
+#include "AIRacingController.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "PhysicsEngine/BodyInstance.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Physics/Experimental/PhysScene_Chaos.h"
+#include "PhysicsEngine/PhysicsSettings.h"
+#include "Chaos/PBDRigidsSolver.h"
+
+DECLARE_CYCLE_STAT(TEXT("Vehicle Sim Total"), STAT_VehicleSim_Total, STATGROUP_VehicleSim);
+DECLARE_CYCLE_STAT(TEXT("Vehicle Sim Gather"), STAT_VehicleSim_Gather, STATGROUP_VehicleSim);
+DECLARE_CYCLE_STAT(TEXT("Vehicle Sim Compute"), STAT_VehicleSim_Compute, STATGROUP_VehicleSim);
+DECLARE_CYCLE_STAT(TEXT("Vehicle Sim Scatter"), STAT_VehicleSim_Scatter, STATGROUP_VehicleSim);
+DECLARE_CYCLE_STAT(TEXT("Vehicle Sim Publish Frame State"), STAT_VehicleSim_PublishFrameState, STATGROUP_VehicleSim);
+DECLARE_CYCLE_STAT(TEXT("Vehicle Sim Physics LOD"), STAT_VehicleSim_PhysicsLOD, STATGROUP_VehicleSim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Simulated Vehicles"), STAT_VehicleSim_NumVehicles, STATGROUP_VehicleSim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Body Queries Replaced"), STAT_VehicleSim_BodyQueriesReplaced, STATGROUP_VehicleSim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Body Queries Removed"), STAT_VehicleSim_BodyQueriesRemoved, STATGROUP_VehicleSim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Kinematic Vehicles"), STAT_VehicleSim_KinematicVehicles, STATGROUP_VehicleSim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Physics LOD Swaps"), STAT_VehicleSim_PhysicsLODSwaps, STATGROUP_VehicleSim);
+
+static TAutoConsoleVariable<int32> CVarVehicleSimBatched(
+    TEXT("CarGame.VehicleSim.Batched"),
+    1,
+    TEXT("1 = racing vehicles are updated in one batched pass by UVehicleSimulationSubsystem.\n")
+    TEXT("0 = every vehicle runs its own Tick (legacy path)."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarVehicleSimParallel(
+    TEXT("CarGame.VehicleSim.Parallel"),
+    1,
+    TEXT("1 = run the batched vehicle compute stage as a ParallelFor.\n")
+    TEXT("0 = run it inline on the game thread."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarVehicleSimAsyncPhysics(
+    TEXT("CarGame.VehicleSim.AsyncPhysics"),
+    1,
+    TEXT("1 = apply aerodynamic forces per physics substep on the physics thread\n")
+    TEXT("(requires async physics in Project Settings). 0 = apply them once per frame on the game thread."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarVehicleSimAsyncPhysicsTick(
+    TEXT("CarGame.VehicleSim.AsyncPhysicsTick"),
+    0,
+    TEXT("1 = switch each game world's solver to a fixed AsyncFixedTimeStepSize step when the project\n")
+    TEXT("does not tick physics async. Affects every actor in the world; read when the world begins play."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarVehicleSimParallelMinBatch(
+    TEXT("CarGame.VehicleSim.ParallelMinBatch"),
+    8,
+    TEXT("Minimum number of vehicles before the compute stage goes wide."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarVehicleSimPhysicsLOD(
+    TEXT("CarGame.VehicleSim.PhysicsLOD"),
+    1,
+    TEXT("1 = distant, non-interacting AI cars follow their racing line kinematically instead of running Chaos.\n")
+    TEXT("0 = every car always runs full physics."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarVehicleSimLODSleepDistance(
+    TEXT("CarGame.VehicleSim.PhysicsLOD.SleepDistance"),
+    300.0f,
+    TEXT("Distance (m) from every player car and camera beyond which an AI car may go kinematic."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarVehicleSimLODWakeDistance(
+    TEXT("CarGame.VehicleSim.PhysicsLOD.WakeDistance"),
+    200.0f,
+    TEXT("Distance (m) from a player car or camera at which a kinematic car returns to full physics.\n")
+    TEXT("Keep below SleepDistance so cars do not flip between modes."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarVehicleSimLODInteractionDistance(
+    TEXT("CarGame.VehicleSim.PhysicsLOD.InteractionDistance"),
+    40.0f,
+    TEXT("Distance (m) to any other car at which a kinematic car returns to full physics.\n")
+    TEXT("Going kinematic needs twice this much clearance."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarVehicleSimLODMinDwellTime(
+    TEXT("CarGame.VehicleSim.PhysicsLOD.MinDwellTime"),
+    2.0f,
+    TEXT("Seconds a car must spend at full physics before it may go kinematic again."),
+    ECVF_Default);
+
+namespace
+{
+    // Line follower limits (cm/s^2)
+    constexpr float KinematicAcceleration = 600.0f;
+    constexpr float KinematicDeceleration = 1200.0f;
+
+    // Time constant (s) over which the offset from the line captured on entry fades out
+    constexpr float KinematicOffsetBlendTime = 2.0f;
+}
+
+// ============================================================
+// STAGE PROFILER
+// ============================================================
+
+namespace VehicleSim
+{
+    std::atomic<bool> FStageProfiler::bEnabled{false};
+    std::atomic<uint64> FStageProfiler::Cycles[static_cast<int32>(EStage::Count)];
+
+    void FStageProfiler::Reset()
+    {
+        for (std::atomic<uint64>& Counter : Cycles)
+        {
+            Counter.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    double FStageProfiler::GetSeconds(EStage Stage)
+    {
+        return FPlatformTime::ToSeconds64(Cycles[static_cast<int32>(Stage)].load(std::memory_order_relaxed));
+    }
+
+    const TCHAR* FStageProfiler::GetName(EStage Stage)
+    {
+        switch (Stage)
+        {
+        case EStage::Gather:        return TEXT("Gather");
+        case EStage::Aerodynamics:  return TEXT("Aerodynamics");
+        case EStage::Telemetry:     return TEXT("Telemetry");
+        case EStage::Scatter:       return TEXT("Scatter");
+        case EStage::FrameState:    return TEXT("FrameState");
+        case EStage::PhysicsLOD:    return TEXT("PhysicsLOD");
+        case EStage::Assists:       return TEXT("Assists");
+        case EStage::TireForces:    return TEXT("TireForces");
+        default:                    return TEXT("");
+        }
+    }
+}
+
+// ============================================================
+// SOA STATE
+// ============================================================
+
+void FVehicleSimulationState::AddSlot()
+{
+    Velocity.Add(FVector::ZeroVector);
+    PreviousVelocity.Add(FVector::ZeroVector);
+    AngularVelocity.Add(FVector::ZeroVector);
+    Rotation.Add(FQuat::Identity);
+
+    Throttle.Add(0.0f);
+    Brake.Add(0.0f);
+    Steering.Add(0.0f);
+
+    EngineRPM.Add(0.0f);
+    Gear.Add(0);
+    SuspensionCompression.Add(FVector4f::Zero());
+
+    DragFactor.Add(0.0f);
+    DownforceFactor.Add(0.0f);
+
+    ActiveAssists.Add(EVehicleAssistFlags::None);
+    ABSInterventions.Add(FIntVector4(0));
+    TractionInterventions.Add(FIntVector4(0));
+    StabilityInterventions.Add(FIntVector4(0));
+
+    AeroForce.Add(FVector::ZeroVector);
+    Telemetry.AddDefaulted();
+    TelemetryStream.Add(nullptr);
+
+    RacelineDistance.Add(0.0f);
+    KinematicSpeed.Add(0.0f);
+    KinematicOffset.Add(FVector::ZeroVector);
+    PhysicsLODTime.Add(0.0f);
+}
+
+void FVehicleSimulationState::RemoveSlotSwap(int32 Index)
+{
+    Velocity.RemoveAtSwap(Index, 1, false);
+    PreviousVelocity.RemoveAtSwap(Index, 1, false);
+    AngularVelocity.RemoveAtSwap(Index, 1, false);
+    Rotation.RemoveAtSwap(Index, 1, false);
+
+    Throttle.RemoveAtSwap(Index, 1, false);
+    Brake.RemoveAtSwap(Index, 1, false);
+    Steering.RemoveAtSwap(Index, 1, false);
+
+    EngineRPM.RemoveAtSwap(Index, 1, false);
+    Gear.RemoveAtSwap(Index, 1, false);
+    SuspensionCompression.RemoveAtSwap(Index, 1, false);
+
+    DragFactor.RemoveAtSwap(Index, 1, false);
+    DownforceFactor.RemoveAtSwap(Index, 1, false);
+
+    ActiveAssists.RemoveAtSwap(Index, 1, false);
+    ABSInterventions.RemoveAtSwap(Index, 1, false);
+    TractionInterventions.RemoveAtSwap(Index, 1, false);
+    StabilityInterventions.RemoveAtSwap(Index, 1, false);
+
+    AeroForce.RemoveAtSwap(Index, 1, false);
+    Telemetry.RemoveAtSwap(Index, 1, false);
+    TelemetryStream.RemoveAtSwap(Index, 1, false);
+
+    RacelineDistance.RemoveAtSwap(Index, 1, false);
+    KinematicSpeed.RemoveAtSwap(Index, 1, false);
+    KinematicOffset.RemoveAtSwap(Index, 1, false);
+    PhysicsLODTime.RemoveAtSwap(Index, 1, false);
+}
+
+void FVehicleSimulationState::Reset()
+{
+    Velocity.Reset();
+    PreviousVelocity.Reset();
+    AngularVelocity.Reset();
+    Rotation.Reset();
+
+    Throttle.Reset();
+    Brake.Reset();
+    Steering.Reset();
+
+    EngineRPM.Reset();
+    Gear.Reset();
+    SuspensionCompression.Reset();
+
+    DragFactor.Reset();
+    DownforceFactor.Reset();
+
+    ActiveAssists.Reset();
+    ABSInterventions.Reset();
+    TractionInterventions.Reset();
+    StabilityInterventions.Reset();
+
+    AeroForce.Reset();
+    Telemetry.Reset();
+    TelemetryStream.Reset();
+
+    RacelineDistance.Reset();
+    KinematicSpeed.Reset();
+    KinematicOffset.Reset();
+    PhysicsLODTime.Reset();
+}
+
+// ============================================================
+// TICK FUNCTION
+// ============================================================
+
+void FVehicleSimulationTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+    if (Subsystem && TickType != LEVELTICK_ViewportsOnly)
+    {
+        Subsystem->SimulateVehicles(DeltaTime);
+    }
+}
+
+FString FVehicleSimulationTickFunction::DiagnosticMessage()
+{
+    return TEXT("FVehicleSimulationTickFunction");
+}
+
+FName FVehicleSimulationTickFunction::DiagnosticContext(bool bDetailed)
+{
+    return FName(TEXT("VehicleSimulation"));
+}
+
+void FVehicleFrameStateTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+    if (Subsystem && TickType != LEVELTICK_ViewportsOnly)
+    {
+        Subsystem->PublishFrameStates();
+    }
+}
+
+FString FVehicleFrameStateTickFunction::DiagnosticMessage()
+{
+    return TEXT("FVehicleFrameStateTickFunction");
+}
+
+FName FVehicleFrameStateTickFunction::DiagnosticContext(bool bDetailed)
+{
+    return FName(TEXT("VehicleFrameState"));
+}
+
+// ============================================================
+// SUBSYSTEM LIFECYCLE
+// ============================================================
+
+void UVehicleSimulationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    SimulationTickFunction.Subsystem = this;
+    SimulationTickFunction.bCanEverTick = true;
+    SimulationTickFunction.bStartWithTickEnabled = true;
+    SimulationTickFunction.bRunOnAnyThread = false;
+    SimulationTickFunction.TickGroup = TG_PrePhysics;
+
+    FrameStateTickFunction.Subsystem = this;
+    FrameStateTickFunction.bCanEverTick = true;
+    FrameStateTickFunction.bStartWithTickEnabled = true;
+    FrameStateTickFunction.bRunOnAnyThread = false;
+    FrameStateTickFunction.TickGroup = TG_PostPhysics;
+}
+
+void UVehicleSimulationSubsystem::Deinitialize()
+{
+    DestroyAsyncCallback();
+
+    if (SimulationTickFunction.IsTickFunctionRegistered())
+    {
+        SimulationTickFunction.UnRegisterTickFunction();
+    }
+    SimulationTickFunction.Subsystem = nullptr;
+
+    if (FrameStateTickFunction.IsTickFunctionRegistered())
+    {
+        FrameStateTickFunction.UnRegisterTickFunction();
+    }
+    FrameStateTickFunction.Subsystem = nullptr;
+
+    Vehicles.Reset();
+    Bodies.Reset();
+    State.Reset();
+
+    Super::Deinitialize();
+}
+
+void UVehicleSimulationSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    SimulationTickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+    FrameStateTickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+    CreateAsyncCallback(InWorld);
+
+    UE_LOG(LogTemp, Log, TEXT("Vehicle Simulation Subsystem started (batched: %d, parallel: %d)"),
+        CVarVehicleSimBatched.GetValueOnGameThread(), CVarVehicleSimParallel.GetValueOnGameThread());
+}
+
+bool UVehicleSimulationSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UVehicleSimulationSubsystem::IsBatchedSimulationEnabled()
+{
+    return CVarVehicleSimBatched.GetValueOnGameThread() != 0;
+}
+
+bool UVehicleSimulationSubsystem::IsUsingAsyncPhysics() const
+{
+    return AsyncCallback != nullptr && CVarVehicleSimAsyncPhysics.GetValueOnGameThread() != 0;
+}
+
+// ============================================================
+// ASYNC PHYSICS
+// ============================================================
+
+void UVehicleSimulationSubsystem::CreateAsyncCallback(UWorld& InWorld)
+{
+    // Without async physics the solver steps with the frame delta, so the game thread path is used.
+    // The project default stays synchronous; worlds opt in through CarGame.VehicleSim.AsyncPhysicsTick.
+    const bool bProjectAsync = UPhysicsSettings::Get()->bTickPhysicsAsync;
+    if (!bProjectAsync && CVarVehicleSimAsyncPhysicsTick.GetValueOnGameThread() == 0)
+    {
+        UE_LOG(LogTemp, Log, TEXT("Vehicle Simulation: async physics disabled, using game thread aerodynamics"));
+        return;
+    }
+
+    FPhysScene* PhysScene = InWorld.GetPhysicsScene();
+    if (!PhysScene || !PhysScene->GetSolver())
+    {
+        return;
+    }
+
+    Chaos::FPhysicsSolver* Solver = PhysScene->GetSolver();
+    if (!bProjectAsync)
+    {
+        Solver->EnableAsyncMode(UPhysicsSettings::Get()->AsyncFixedTimeStepSize);
+        bEnabledAsyncMode = true;
+    }
+
+    AsyncCallback = Solver->CreateAndRegisterSimCallbackObject_External<FVehicleAsyncPhysicsCallback>();
+
+    UE_LOG(LogTemp, Log, TEXT("Vehicle Simulation: async physics callback registered (fixed step %.4fs)"),
+        UPhysicsSettings::Get()->AsyncFixedTimeStepSize);
+}
+
+void UVehicleSimulationSubsystem::DestroyAsyncCallback()
+{
+    if (!AsyncCallback)
+    {
+        return;
+    }
+
+    if (UWorld* World = GetWorld())
+    {
+        if (FPhysScene* PhysScene = World->GetPhysicsScene())
+        {
+            if (Chaos::FPhysicsSolver* Solver = PhysScene->GetSolver())
+            {
+                Solver->UnregisterAndFreeSimCallbackObject_External(AsyncCallback);
+
+                // Hand the solver back in the mode the project configured
+                if (bEnabledAsyncMode)
+                {
+                    Solver->DisableAsyncMode();
+                }
+            }
+        }
+    }
+
+    AsyncCallback = nullptr;
+    bEnabledAsyncMode = false;
+}
+
+void UVehicleSimulationSubsystem::ConsumeAsyncOutputs()
+{
+    // Several substeps may have completed since last frame. Nothing reads them yet, but the
+    // queue is drained every frame so the handles go back to the callback's pool
+    while (Chaos::TSimCallbackOutputHandle<FVehicleAsyncPhysicsOutput> Output = AsyncCallback->PopOutputData_External())
+    {
+    }
+}
+
+void UVehicleSimulationSubsystem::ProduceAsyncInputs()
+{
+    FVehicleAsyncPhysicsInput* Input = AsyncCallback->GetProducerInputData_External();
+    if (!Input)
+    {
+        return;
+    }
+
+    Input->Vehicles.Reset(Vehicles.Num());
+
+    for (int32 i = 0; i < Vehicles.Num(); i++)
+    {
+        const FBodyInstance* Body = Bodies[i];
+        if (!Body || !Body->IsValidBodyInstance() || (Vehicles[i] && Vehicles[i]->IsKinematicLOD()))
+        {
+            continue;
+        }
+
+        FVehicleAsyncBodyInput& Entry = Input->Vehicles.AddDefaulted_GetRef();
+        Entry.Proxy = Body->GetPhysicsActorHandle();
+        Entry.Slot = i;
+        Entry.DragFactor = State.DragFactor[i];
+        Entry.DownforceFactor = State.DownforceFactor[i];
+    }
+}
+
+// ============================================================
+// REGISTRY
+// ============================================================
+
+int32 UVehicleSimulationSubsystem::RegisterVehicle(ARacingVehicle* Vehicle)
+{
+    if (!Vehicle)
+    {
+        return INDEX_NONE;
+    }
+
+    if (Vehicle->SimulationSlot != INDEX_NONE && Vehicles.IsValidIndex(Vehicle->SimulationSlot)
+        && Vehicles[Vehicle->SimulationSlot] == Vehicle)
+    {
+        return Vehicle->SimulationSlot;
+    }
+
+    const int32 Slot = Vehicles.Add(Vehicle);
+    Bodies.Add(Vehicle->GetMesh() ? Vehicle->GetMesh()->GetBodyInstance() : nullptr);
+    State.AddSlot();
+
+    Vehicle->SimulationSlot = Slot;
+    RefreshVehicleConstants(Vehicle);
+
+    if (Bodies[Slot])
+    {
+        State.PreviousVelocity[Slot] = Bodies[Slot]->GetUnrealWorldVelocity();
+    }
+
+    return Slot;
+}
+
+void UVehicleSimulationSubsystem::UnregisterVehicle(ARacingVehicle* Vehicle)
+{
+    if (!Vehicle || !Vehicles.IsValidIndex(Vehicle->SimulationSlot) || Vehicles[Vehicle->SimulationSlot] != Vehicle)
+    {
+        return;
+    }
+
+    const int32 Slot = Vehicle->SimulationSlot;
+    const int32 LastSlot = Vehicles.Num() - 1;
+
+    if (Vehicle->IsKinematicLOD())
+    {
+        ExitKinematic(Slot, nullptr);
+    }
+
+    Vehicles.RemoveAtSwap(Slot, 1, false);
+    Bodies.RemoveAtSwap(Slot, 1, false);
+    State.RemoveSlotSwap(Slot);
+
+    // The vehicle that used to live in the last slot now lives in the freed one
+    if (Slot != LastSlot && Vehicles[Slot])
+    {
+        Vehicles[Slot]->SimulationSlot = Slot;
+    }
+
+    Vehicle->SimulationSlot = INDEX_NONE;
+}
+
+void UVehicleSimulationSubsystem::RefreshVehicleConstants(ARacingVehicle* Vehicle)
+{
+    if (!Vehicle || !Vehicles.IsValidIndex(Vehicle->SimulationSlot))
+    {
+        return;
+    }
+
+    const int32 Slot = Vehicle->SimulationSlot;
+
+    State.DragFactor[Slot] = 0.5f * VehicleSim::AirDensity * Vehicle->DragCoefficient * Vehicle->FrontalArea;
+    State.DownforceFactor[Slot] = 0.5f * VehicleSim::AirDensity * Vehicle->DownforceCoefficient * Vehicle->FrontalArea;
+
+    // Assist settings live in the movement component's physics-thread simulation
+    Vehicle->ApplyDrivingAssists(0.0f);
+}
+
+// ============================================================
+// SIMULATION
+// ============================================================
+
+void UVehicleSimulationSubsystem::SimulateVehicles(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_VehicleSim_Total);
+    SET_DWORD_STAT(STAT_VehicleSim_NumVehicles, Vehicles.Num());
+
+    if (Vehicles.Num() == 0 || DeltaTime <= 0.0f)
+    {
+        return;
+    }
+
+    const bool bAsync = IsUsingAsyncPhysics();
+    SimulationTime = GetWorld()->GetTimeSeconds();
+
+    if (bAsync)
+    {
+        ConsumeAsyncOutputs();
+    }
+
+    UpdatePhysicsLOD(DeltaTime);
+    GatherState(DeltaTime);
+    ComputeState(DeltaTime);
+    ScatterState(DeltaTime);
+
+    if (bAsync)
+    {
+        ProduceAsyncInputs();
+    }
+}
+
+void UVehicleSimulationSubsystem::AddSimulationPrerequisite(UObject* PrerequisiteObject, FTickFunction& PrerequisiteTickFunction)
+{
+    SimulationTickFunction.AddPrerequisite(PrerequisiteObject, PrerequisiteTickFunction);
+}
+
+void UVehicleSimulationSubsystem::GatherState(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_VehicleSim_Gather);
+    VehicleSim::FScopedStage Stage(VehicleSim::EStage::Gather);
+
+    for (int32 i = 0; i < Vehicles.Num(); i++)
+    {
+        const ARacingVehicle* Vehicle = Vehicles[i];
+        const FBodyInstance* Body = Bodies[i];
+
+        if (Vehicle && Vehicle->IsKinematicLOD())
+        {
+            // The body is kinematic and reports no velocity
+            State.Velocity[i] = Vehicle->KinematicVelocity;
+            State.AngularVelocity[i] = FVector::ZeroVector;
+            State.Rotation[i] = Vehicle->GetActorQuat();
+        }
+        else if (Body && Body->IsValidBodyInstance())
+        {
+            State.Velocity[i] = Body->GetUnrealWorldVelocity();
+            State.AngularVelocity[i] = FMath::RadiansToDegrees(Body->GetUnrealWorldAngularVelocityInRadians());
+            State.Rotation[i] = Body->GetUnrealWorldTransform().GetRotation();
+        }
+        else
+        {
+            State.Velocity[i] = FVector::ZeroVector;
+            State.AngularVelocity[i] = FVector::ZeroVector;
+        }
+
+        if (Vehicle)
+        {
+            State.Throttle[i] = Vehicle->CurrentThrottle;
+            State.Brake[i] = Vehicle->CurrentBrake;
+            State.Steering[i] = Vehicle->CurrentSteering;
+            State.TelemetryStream[i] = Vehicle->TelemetryStream.Get();
+        }
+        else
+        {
+            State.TelemetryStream[i] = nullptr;
+        }
+
+        // Assist results written by the physics-thread controller
+        if (Vehicle && Vehicle->VehicleMovement)
+        {
+            const FDrivingAssistCounters& Counters = Vehicle->VehicleMovement->GetAssistCounters();
+            for (int32 Wheel = 0; Wheel < EVehicleWheel::Count; Wheel++)
+            {
+                State.ABSInterventions[i][Wheel] = Counters.ABS[Wheel].load(std::memory_order_relaxed);
+                State.TractionInterventions[i][Wheel] = Counters.Traction[Wheel].load(std::memory_order_relaxed);
+                State.StabilityInterventions[i][Wheel] = Counters.Stability[Wheel].load(std::memory_order_relaxed);
+            }
+            State.ActiveAssists[i] = Counters.LastActiveAssists.load(std::memory_order_relaxed);
+
+            FVehicleMechanicalState Mechanical;
+            Vehicle->VehicleMovement->ReadMechanicalState(Mechanical);
+            State.EngineRPM[i] = Mechanical.EngineRPM;
+            State.Gear[i] = Mechanical.Gear;
+            State.SuspensionCompression[i] = FVector4f(
+                Mechanical.SuspensionCompression[EVehicleWheel::FrontLeft],
+                Mechanical.SuspensionCompression[EVehicleWheel::FrontRight],
+                Mechanical.SuspensionCompression[EVehicleWheel::RearLeft],
+                Mechanical.SuspensionCompression[EVehicleWheel::RearRight]);
+        }
+    }
+}
+
+void UVehicleSimulationSubsystem::ComputeState(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_VehicleSim_Compute);
+
+    const int32 NumVehicles = State.Num();
+    const bool bParallel = CVarVehicleSimParallel.GetValueOnGameThread() != 0
+        && NumVehicles >= CVarVehicleSimParallelMinBatch.GetValueOnGameThread();
+    const bool bPhysicsOnGameThread = !IsUsingAsyncPhysics();
+
+    ParallelFor(NumVehicles, [this, DeltaTime, bPhysicsOnGameThread](int32 Index)
+    {
+        ComputeSlot(Index, DeltaTime, bPhysicsOnGameThread);
+    }, !bParallel);
+}
+
+void UVehicleSimulationSubsystem::ComputeSlot(int32 i, float DeltaTime, bool bPhysicsOnGameThread)
+{
+    const FVector& Velocity = State.Velocity[i];
+
+    // Aerodynamics (the async callback applies them per substep instead)
+    {
+        VehicleSim::FScopedStage Stage(VehicleSim::EStage::Aerodynamics);
+        State.AeroForce[i] = bPhysicsOnGameThread
+            ? VehicleSim::ComputeAerodynamicForce(Velocity, State.DragFactor[i], State.DownforceFactor[i])
+            : FVector::ZeroVector;
+    }
+
+    // Telemetry
+    VehicleSim::FScopedStage Stage(VehicleSim::EStage::Telemetry);
+    FVehicleTelemetry& Telemetry = State.Telemetry[i];
+    Telemetry.Velocity = Velocity;
+    Telemetry.Speed = Velocity.Size() * VehicleSim::CmPerSecToKmh;
+    Telemetry.AngularVelocity = State.AngularVelocity[i];
+    Telemetry.Throttle = State.Throttle[i];
+    Telemetry.Brake = State.Brake[i];
+    Telemetry.Steering = State.Steering[i];
+
+    Telemetry.EngineRPM = State.EngineRPM[i];
+    Telemetry.CurrentGear = State.Gear[i];
+
+    const FVector4f& Suspension = State.SuspensionCompression[i];
+    Telemetry.SuspensionCompressionFL = Suspension.X;
+    Telemetry.SuspensionCompressionFR = Suspension.Y;
+    Telemetry.SuspensionCompressionRL = Suspension.Z;
+    Telemetry.SuspensionCompressionRR = Suspension.W;
+
+    Telemetry.ABSInterventions = State.ABSInterventions[i];
+    Telemetry.TractionControlInterventions = State.TractionInterventions[i];
+    Telemetry.StabilityControlInterventions = State.StabilityInterventions[i];
+
+    const FVector Acceleration = (Velocity - State.PreviousVelocity[i]) / DeltaTime;
+    const FVector LocalAcceleration = State.Rotation[i].UnrotateVector(Acceleration);
+    Telemetry.LongitudinalG = LocalAcceleration.X / VehicleSim::GravityConstant;
+    Telemetry.LateralG = LocalAcceleration.Y / VehicleSim::GravityConstant;
+
+    State.PreviousVelocity[i] = Velocity;
+
+    // Lock-free hand-off to the telemetry writer thread
+    if (FTelemetryStream* Stream = State.TelemetryStream[i])
+    {
+        Stream->Push(SimulationTime, Telemetry);
+    }
+}
+
+void UVehicleSimulationSubsystem::ScatterState(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_VehicleSim_Scatter);
+    VehicleSim::FScopedStage Stage(VehicleSim::EStage::Scatter);
+
+    for (int32 i = 0; i < Vehicles.Num(); i++)
+    {
+        ARacingVehicle* Vehicle = Vehicles[i];
+        if (!Vehicle)
+        {
+            continue;
+        }
+
+        FBodyInstance* Body = Bodies[i];
+        if (Body && !State.AeroForce[i].IsZero() && !Vehicle->IsKinematicLOD())
+        {
+            Body->AddForce(State.AeroForce[i], false);
+        }
+
+        Vehicle->ApplySimulationResults(State.Telemetry[i], DeltaTime);
+    }
+}
+
+// ============================================================
+// FRAME STATE
+// ============================================================
+
+void UVehicleSimulationSubsystem::PublishFrameStates()
+{
+    SCOPE_CYCLE_COUNTER(STAT_VehicleSim_PublishFrameState);
+    VehicleSim::FScopedStage Stage(VehicleSim::EStage::FrameState);
+
+    const uint64 FrameNumber = GFrameCounter;
+    const double Time = GetWorld()->GetTimeSeconds();
+
+    for (int32 i = 0; i < Vehicles.Num(); i++)
+    {
+        if (ARacingVehicle* Vehicle = Vehicles[i])
+        {
+            ReplacedBodyQueries += Vehicle->PublishFrameState(Bodies[i], FrameNumber, Time);
+            FrameStateBodyQueries++;
+        }
+    }
+
+    // Only GetFrameVelocity reads stand in for a body query; the publish costs one body read per vehicle
+    const int32 Removed = FMath::Max(ReplacedBodyQueries - FrameStateBodyQueries, 0);
+    TotalBodyQueriesRemoved += Removed;
+
+    SET_DWORD_STAT(STAT_VehicleSim_BodyQueriesReplaced, ReplacedBodyQueries);
+    SET_DWORD_STAT(STAT_VehicleSim_BodyQueriesRemoved, Removed);
+
+    ReplacedBodyQueries = 0;
+    FrameStateBodyQueries = 0;
+}
+
+void UVehicleSimulationSubsystem::AddFrameStateConsumer(FTickFunction& ConsumerTickFunction)
+{
+    // The tick manager moves the consumer into TG_PostPhysics to satisfy the prerequisite
+    ConsumerTickFunction.AddPrerequisite(this, FrameStateTickFunction);
+}
+
+void UVehicleSimulationSubsystem::ReportFrameStatePublish(int32 ReplacedQueries)
+{
+    ReplacedBodyQueries += ReplacedQueries;
+    FrameStateBodyQueries++;
+}
+
+// ============================================================
+// PHYSICS LOD
+// ============================================================
+
+void UVehicleSimulationSubsystem::UpdatePhysicsLOD(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_VehicleSim_PhysicsLOD);
+    VehicleSim::FScopedStage Stage(VehicleSim::EStage::PhysicsLOD);
+
+    const bool bEnabled = CVarVehicleSimPhysicsLOD.GetValueOnGameThread() != 0;
+    if (!bEnabled && NumKinematicVehicles == 0)
+    {
+        return;
+    }
+
+    const float SleepDistanceSquared = FMath::Square(CVarVehicleSimLODSleepDistance.GetValueOnGameThread() * 100.0f);
+    const float WakeDistanceSquared = FMath::Square(CVarVehicleSimLODWakeDistance.GetValueOnGameThread() * 100.0f);
+    const float InteractionDistanceSquared = FMath::Square(CVarVehicleSimLODInteractionDistance.GetValueOnGameThread() * 100.0f);
+    const float MinDwellTime = CVarVehicleSimLODMinDwellTime.GetValueOnGameThread();
+
+    // Everything a player can see or touch: their pawns and their cameras
+    TArray<FVector, TInlineAllocator<8>> Viewers;
+    for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+    {
+        const APlayerController* PlayerController = It->Get();
+        if (!PlayerController)
+        {
+            continue;
+        }
+        if (const APawn* Pawn = PlayerController->GetPawn())
+        {
+            Viewers.Add(Pawn->GetActorLocation());
+        }
+        if (PlayerController->PlayerCameraManager)
+        {
+            Viewers.Add(PlayerController->PlayerCameraManager->GetCameraLocation());
+        }
+    }
+
+    const int32 NumVehicles = Vehicles.Num();
+    LODLocations.SetNumUninitialized(NumVehicles);
+    for (int32 i = 0; i < NumVehicles; i++)
+    {
+        LODLocations[i] = Vehicles[i] ? Vehicles[i]->GetActorLocation() : FVector(MAX_FLT);
+    }
+
+    int32 Swaps = 0;
+    NumKinematicVehicles = 0;
+
+    for (int32 i = 0; i < NumVehicles; i++)
+    {
+        ARacingVehicle* Vehicle = Vehicles[i];
+        if (!Vehicle)
+        {
+            continue;
+        }
+
+        State.PhysicsLODTime[i] += DeltaTime;
+
+        AAIRacingController* Driver = Cast<AAIRacingController>(Vehicle->GetController());
+        const bool bEligible = bEnabled && Vehicle->bAllowPhysicsLOD && Driver && Driver->HasRaceline();
+        const bool bKinematic = Vehicle->IsKinematicLOD();
+
+        if (!bEligible)
+        {
+            if (bKinematic)
+            {
+                ExitKinematic(i, Driver);
+                Swaps++;
+            }
+            continue;
+        }
+
+        float ViewerDistanceSquared = MAX_FLT;
+        for (const FVector& Viewer : Viewers)
+        {
+            ViewerDistanceSquared = FMath::Min(ViewerDistanceSquared, FVector::DistSquared(LODLocations[i], Viewer));
+        }
+
+        // Pairwise is fine at grid sizes; kinematic cars wake each other too
+        float CarDistanceSquared = MAX_FLT;
+        for (int32 j = 0; j < NumVehicles; j++)
+        {
+            if (j != i)
+            {
+                CarDistanceSquared = FMath::Min(CarDistanceSquared, FVector::DistSquared(LODLocations[i], LODLocations[j]));
+            }
+        }
+
+        if (bKinematic)
+        {
+            if (ViewerDistanceSquared < WakeDistanceSquared || CarDistanceSquared < InteractionDistanceSquared)
+            {
+                ExitKinematic(i, Driver);
+                Swaps++;
+                continue;
+            }
+
+            AdvanceKinematic(i, *Driver, DeltaTime);
+            LODLocations[i] = Vehicle->GetActorLocation();
+            NumKinematicVehicles++;
+        }
+        else if (State.PhysicsLODTime[i] >= MinDwellTime
+            && ViewerDistanceSquared > SleepDistanceSquared
+            && CarDistanceSquared > InteractionDistanceSquared * 4.0f)
+        {
+            EnterKinematic(i, *Driver);
+            AdvanceKinematic(i, *Driver, DeltaTime);
+            LODLocations[i] = Vehicle->GetActorLocation();
+            NumKinematicVehicles++;
+            Swaps++;
+        }
+    }
+
+    SET_DWORD_STAT(STAT_VehicleSim_KinematicVehicles, NumKinematicVehicles);
+    SET_DWORD_STAT(STAT_VehicleSim_PhysicsLODSwaps, Swaps);
+}
+
+void UVehicleSimulationSubsystem::EnterKinematic(int32 Index, const AAIRacingController& Driver)
+{
+    ARacingVehicle* Vehicle = Vehicles[Index];
+    const FVector Location = Vehicle->GetActorLocation();
+
+    const float Distance = Driver.GetRacelineDistance(Location);
+    FVector LinePoint;
+    FVector Tangent;
+    float TargetSpeed;
+    Driver.SampleRaceline(Distance, LinePoint, Tangent, TargetSpeed);
+
+    // Keep the car where it is; the lateral part of the offset fades out while it drives
+    const FVector Velocity = Bodies[Index] ? Bodies[Index]->GetUnrealWorldVelocity() : FVector::ZeroVector;
+    State.RacelineDistance[Index] = Distance;
+    State.KinematicSpeed[Index] = FMath::Max(FVector::DotProduct(Velocity, Tangent), 0.0f);
+    State.KinematicOffset[Index] = Location - LinePoint;
+    State.PhysicsLODTime[Index] = 0.0f;
+
+    Vehicle->EnterKinematicLOD();
+    TotalKinematicSwaps++;
+}
+
+void UVehicleSimulationSubsystem::ExitKinematic(int32 Index, AAIRacingController* Driver)
+{
+    ARacingVehicle* Vehicle = Vehicles[Index];
+
+    // Hand Chaos the velocity the car was already moving at so it does not lurch
+    const FVector Velocity = Vehicle->KinematicVelocity;
+    Vehicle->ExitKinematicLOD(Velocity);
+
+    State.PreviousVelocity[Index] = Velocity;
+    State.PhysicsLODTime[Index] = 0.0f;
+
+    if (Driver)
+    {
+        Driver->SyncToRacelineDistance(State.RacelineDistance[Index]);
+    }
+    TotalPhysicsSwaps++;
+}
+
+void UVehicleSimulationSubsystem::AdvanceKinematic(int32 Index, const AAIRacingController& Driver, float DeltaTime)
+{
+    float& Distance = State.RacelineDistance[Index];
+    float& Speed = State.KinematicSpeed[Index];
+    FVector& Offset = State.KinematicOffset[Index];
+
+    FVector Location;
+    FVector Tangent;
+    float TargetSpeed;
+    Driver.SampleRaceline(Distance, Location, Tangent, TargetSpeed);
+
+    // The speed profile already brakes ahead of corners; the limits only smooth LOD transitions
+    Speed = (TargetSpeed > Speed)
+        ? FMath::Min(TargetSpeed, Speed + KinematicAcceleration * DeltaTime)
+        : FMath::Max(TargetSpeed, Speed - KinematicDeceleration * DeltaTime);
+
+    Distance = FMath::Fmod(Distance + Speed * DeltaTime, Driver.GetRacelineLength());
+
+    const float Blend = FMath::Exp(-DeltaTime / KinematicOffsetBlendTime);
+    Offset.X *= Blend;
+    Offset.Y *= Blend;
+
+    Driver.SampleRaceline(Distance, Location, Tangent, TargetSpeed);
+    Vehicles[Index]->MoveKinematic(Location + Offset, Tangent.Rotation(), Tangent * Speed);
+}
@@ -0,0 +1,387 @@
+// VehicleSimulationSubsystem.h
+// Batched simulation of all racing vehicles in a world
+// Copyright 2025. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Misc/App.h"
+#include "RacingVehicle.h"
+#include "DrivingAssistKernel.h"
+#include <atomic>
+#include "VehicleSimulationSubsystem.generated.h"
+
+struct FBodyInstance;
+class UVehicleSimulationSubsystem;
+class FVehicleAsyncPhysicsCallback;
+class FTelemetryStream;
+class AAIRacingController;
+
+DECLARE_STATS_GROUP(TEXT("VehicleSim"), STATGROUP_VehicleSim, STATCAT_Advanced);
+
+namespace VehicleSim
+{
+    /** Air density used by all aerodynamic calculations (kg/m^3) */
+    constexpr float AirDensity = 1.225f;
+
+    /** 1G in engine units (cm/s^2) */
+    constexpr float GravityConstant = 980.0f;
+
+    /** Converts cm/s to km/h */
+    constexpr float CmPerSecToKmh = 0.036f;
+
+    /** Drag plus downforce for a body moving at Velocity. Factors are 0.5 * rho * C * A. */
+    FORCEINLINE FVector ComputeAerodynamicForce(const FVector& Velocity, float DragFactor, float DownforceFactor)
+    {
+        const float SpeedSquared = Velocity.SizeSquared();
+        if (SpeedSquared <= 1.0f)
+        {
+            return FVector::ZeroVector;
+        }
+
+        const FVector DragForce = -Velocity.GetUnsafeNormal() * (DragFactor * SpeedSquared);
+        const FVector DownforceForce(0.0f, 0.0f, -DownforceFactor * SpeedSquared);
+        return DragForce + DownforceForce;
+    }
+
+    /** Stages timed by FStageProfiler */
+    enum class EStage : uint8
+    {
+        Gather,
+        Aerodynamics,
+        Telemetry,
+        Scatter,
+        FrameState,
+        PhysicsLOD,
+        Assists,        // physics thread, inside the Chaos step
+        TireForces,     // physics thread, inside the Chaos step
+        Count
+    };
+
+    /**
+     * Wall-clock accounting per stage for the benchmark harness.
+     * Disabled by default; when off a scope costs one relaxed load.
+     */
+    struct CARGAME_API FStageProfiler
+    {
+        static std::atomic<bool> bEnabled;
+        static std::atomic<uint64> Cycles[static_cast<int32>(EStage::Count)];
+
+        static void Reset();
+        static double GetSeconds(EStage Stage);
+        static const TCHAR* GetName(EStage Stage);
+    };
+
+    struct FScopedStage
+    {
+        explicit FScopedStage(EStage InStage)
+            : Stage(InStage)
+            , StartCycles(FStageProfiler::bEnabled.load(std::memory_order_relaxed) ? FPlatformTime::Cycles64() : 0)
+        {
+        }
+
+        ~FScopedStage()
+        {
+            if (StartCycles)
+            {
+                FStageProfiler::Cycles[static_cast<int32>(Stage)].fetch_add(FPlatformTime::Cycles64() - StartCycles, std::memory_order_relaxed);
+            }
+        }
+
+        EStage Stage;
+        uint64 StartCycles;
+    };
+
+    /**
+     * Fixed-step FApp timing for harnesses that tick worlds by hand.
+     * The previous step mode, fixed delta and delta time come back when it goes out
+     * of scope; the clock keeps the time it was advanced to, so it never runs backwards.
+     */
+    struct FScopedFixedStep
+    {
+        UE_NONCOPYABLE(FScopedFixedStep);
+
+        explicit FScopedFixedStep(double InStepSeconds)
+            : StepSeconds(InStepSeconds)
+            , bPreviousUseFixedTimeStep(FApp::UseFixedTimeStep())
+            , PreviousFixedDeltaTime(FApp::GetFixedDeltaTime())
+            , PreviousDeltaTime(FApp::GetDeltaTime())
+        {
+            FApp::SetUseFixedTimeStep(true);
+            FApp::SetFixedDeltaTime(StepSeconds);
+        }
+
+        ~FScopedFixedStep()
+        {
+            FApp::SetUseFixedTimeStep(bPreviousUseFixedTimeStep);
+            FApp::SetFixedDeltaTime(PreviousFixedDeltaTime);
+            FApp::SetDeltaTime(PreviousDeltaTime);
+        }
+
+        /** Move the app clock one step on; call before each World->Tick */
+        void Advance() const
+        {
+            FApp::SetDeltaTime(StepSeconds);
+            FApp::SetCurrentTime(FApp::GetCurrentTime() + StepSeconds);
+        }
+
+        double StepSeconds;
+        bool bPreviousUseFixedTimeStep;
+        double PreviousFixedDeltaTime;
+        double PreviousDeltaTime;
+    };
+}
+
+/**
+ * Structure-of-arrays state for every registered vehicle.
+ * Index N in every array belongs to the same vehicle slot.
+ */
+struct FVehicleSimulationState
+{
+    // Inputs gathered from the physics bodies
+    TArray<FVector> Velocity;
+    TArray<FVector> PreviousVelocity;
+    TArray<FVector> AngularVelocity;
+    TArray<FQuat> Rotation;
+
+    // Driver inputs
+    TArray<float> Throttle;
+    TArray<float> Brake;
+    TArray<float> Steering;
+
+    // Transmission and suspension, read once per frame from the Chaos simulation output
+    TArray<float> EngineRPM;
+    TArray<int32> Gear;
+    TArray<FVector4f> SuspensionCompression;
+
+    // Per-vehicle constants (refreshed on registration)
+    TArray<float> DragFactor;
+    TArray<float> DownforceFactor;
+
+    // Assist controller results (the controller itself runs inside the Chaos vehicle simulation)
+    TArray<uint8> ActiveAssists;
+    TArray<FIntVector4> ABSInterventions;
+    TArray<FIntVector4> TractionInterventions;
+    TArray<FIntVector4> StabilityInterventions;
+
+    // Outputs of the batched pass
+    TArray<FVector> AeroForce;
+    TArray<FVehicleTelemetry> Telemetry;
+
+    // Open telemetry recordings (null when not recording); each slot is the single producer
+    TArray<FTelemetryStream*> TelemetryStream;
+
+    // Physics LOD: arc length and speed along the racing line while kinematic, offset from the line
+    // captured on entry, and time spent in the current mode
+    TArray<float> RacelineDistance;
+    TArray<float> KinematicSpeed;
+    TArray<FVector> KinematicOffset;
+    TArray<float> PhysicsLODTime;
+
+    int32 Num() const { return Velocity.Num(); }
+    void AddSlot();
+    void RemoveSlotSwap(int32 Index);
+    void Reset();
+};
+
+/**
+ * Pre-physics tick function that drives the batched vehicle update
+ */
+USTRUCT()
+struct FVehicleSimulationTickFunction : public FTickFunction
+{
+    GENERATED_BODY()
+
+    UVehicleSimulationSubsystem* Subsystem = nullptr;
+
+    virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+    virtual FString DiagnosticMessage() override;
+    virtual FName DiagnosticContext(bool bDetailed) override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FVehicleSimulationTickFunction> : public TStructOpsTypeTraitsBase2<FVehicleSimulationTickFunction>
+{
+    enum { WithCopy = false };
+};
+
+/**
+ * Post-physics tick function that publishes every vehicle's FVehicleFrameState
+ */
+USTRUCT()
+struct FVehicleFrameStateTickFunction : public FTickFunction
+{
+    GENERATED_BODY()
+
+    UVehicleSimulationSubsystem* Subsystem = nullptr;
+
+    virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+    virtual FString DiagnosticMessage() override;
+    virtual FName DiagnosticContext(bool bDetailed) override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FVehicleFrameStateTickFunction> : public TStructOpsTypeTraitsBase2<FVehicleFrameStateTickFunction>
+{
+    enum { WithCopy = false };
+};
+
+/**
+ * Owns a dense registry of every ARacingVehicle in the world and updates
+ * aerodynamics, driving assists and telemetry for all of them in one pass.
+ *
+ * The pass runs in three stages:
+ * - Gather: read physics body state into the SoA arrays (game thread)
+ * - Compute: aero, assists and telemetry over the arrays (inline or ParallelFor)
+ * - Scatter: push forces to bodies and publish telemetry (game thread)
+ *
+ * After physics, every vehicle's FVehicleFrameState is rebuilt from one body
+ * read; HUD, audio, VFX, camera and replay consume that instead of the body.
+ *
+ * Physics LOD: AI cars far from every player and every other car are switched
+ * to kinematic motion along their controller's racing line at its speed
+ * profile, and handed back to Chaos with a matching velocity when anything
+ * comes close.
+ *
+ * Console variables:
+ * - CarGame.VehicleSim.Batched  (1 = vehicles skip their own Tick and are simulated here)
+ * - CarGame.VehicleSim.Parallel (1 = compute stage runs as a ParallelFor)
+ * - CarGame.VehicleSim.AsyncPhysics (1 = aero runs per physics substep
+ *   through FVehicleAsyncPhysicsCallback when the project ticks physics async)
+ * - CarGame.VehicleSim.PhysicsLOD and CarGame.VehicleSim.PhysicsLOD.* (thresholds)
+ */
+UCLASS()
+class CARGAME_API UVehicleSimulationSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // USubsystem
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    // UWorldSubsystem
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+    /** True when vehicles should hand their per-frame update to this subsystem */
+    static bool IsBatchedSimulationEnabled();
+
+    /** True when aerodynamic forces are applied on the physics thread this frame */
+    bool IsUsingAsyncPhysics() const;
+
+    // ============================================================
+    // REGISTRY
+    // ============================================================
+
+    /** Add a vehicle to the dense registry. Returns its slot index. */
+    int32 RegisterVehicle(ARacingVehicle* Vehicle);
+
+    /** Remove a vehicle. The last slot is swapped into the freed one. */
+    void UnregisterVehicle(ARacingVehicle* Vehicle);
+
+    /** Re-read per-vehicle constants (aero coefficients, assist settings) */
+    void RefreshVehicleConstants(ARacingVehicle* Vehicle);
+
+    int32 GetNumVehicles() const { return Vehicles.Num(); }
+
+    const TArray<ARacingVehicle*>& GetVehicles() const { return Vehicles; }
+
+    const FVehicleSimulationState& GetState() const { return State; }
+
+    // ============================================================
+    // SIMULATION
+    // ============================================================
+
+    /** Run one batched update of every registered vehicle */
+    void SimulateVehicles(float DeltaTime);
+
+    /** Make the batched pass wait for PrerequisiteTickFunction, e.g. the AI pass that produces this frame's inputs */
+    void AddSimulationPrerequisite(UObject* PrerequisiteObject, FTickFunction& PrerequisiteTickFunction);
+
+    // ============================================================
+    // FRAME STATE
+    // ============================================================
+
+    /** Publish FVehicleFrameState for every registered vehicle (post-physics) */
+    void PublishFrameStates();
+
+    /** Make ConsumerTickFunction run after this frame's states are published */
+    void AddFrameStateConsumer(FTickFunction& ConsumerTickFunction);
+
+    /** Called by vehicles that publish their own state from Tick */
+    void ReportFrameStatePublish(int32 ReplacedQueries);
+
+    /**
+     * Body velocity queries replaced by ARacingVehicle::GetFrameVelocity, less the body
+     * reads the publish itself costs, since the world started
+     */
+    UFUNCTION(BlueprintCallable, Category = "Vehicle|Simulation")
+    int64 GetBodyQueriesRemoved() const { return TotalBodyQueriesRemoved; }
+
+    // ============================================================
+    // PHYSICS LOD
+    // ============================================================
+
+    /** Vehicles currently following their racing line kinematically */
+    UFUNCTION(BlueprintCallable, Category = "Vehicle|Simulation")
+    int32 GetNumKinematicVehicles() const { return NumKinematicVehicles; }
+
+    /** Full physics to kinematic switches since the world started */
+    UFUNCTION(BlueprintCallable, Category = "Vehicle|Simulation")
+    int64 GetKinematicSwapCount() const { return TotalKinematicSwaps; }
+
+    /** Kinematic to full physics switches since the world started */
+    UFUNCTION(BlueprintCallable, Category = "Vehicle|Simulation")
+    int64 GetPhysicsSwapCount() const { return TotalPhysicsSwaps; }
+
+private:
+    UPROPERTY(Transient)
+    TArray<ARacingVehicle*> Vehicles;
+
+    /** Cached body instances, same indexing as Vehicles */
+    TArray<FBodyInstance*> Bodies;
+
+    FVehicleSimulationState State;
+
+    FVehicleSimulationTickFunction SimulationTickFunction;
+    FVehicleFrameStateTickFunction FrameStateTickFunction;
+
+    // Body queries replaced by frame state reads and the body reads that produced them, for the current frame
+    int32 ReplacedBodyQueries = 0;
+    int32 FrameStateBodyQueries = 0;
+    int64 TotalBodyQueriesRemoved = 0;
+
+    /** Physics-thread callback, owned by the solver */
+    FVehicleAsyncPhysicsCallback* AsyncCallback = nullptr;
+
+    /** True when this subsystem switched the solver to async mode (CarGame.VehicleSim.AsyncPhysicsTick) */
+    bool bEnabledAsyncMode = false;
+
+    /** World time of the current pass, stamped on recorded telemetry */
+    double SimulationTime = 0.0;
+
+    // Physics LOD bookkeeping
+    int32 NumKinematicVehicles = 0;
+    int64 TotalKinematicSwaps = 0;
+    int64 TotalPhysicsSwaps = 0;
+    TArray<FVector> LODLocations;
+
+    void CreateAsyncCallback(UWorld& InWorld);
+    void DestroyAsyncCallback();
+    void ConsumeAsyncOutputs();
+    void ProduceAsyncInputs();
+
+    void UpdatePhysicsLOD(float DeltaTime);
+    void EnterKinematic(int32 Index, const AAIRacingController& Driver);
+    void ExitKinematic(int32 Index, AAIRacingController* Driver);
+    void AdvanceKinematic(int32 Index, const AAIRacingController& Driver, float DeltaTime);
+
+    void GatherState(float DeltaTime);
+    void ComputeState(float DeltaTime);
+    void ScatterState(float DeltaTime);
+
+    void ComputeSlot(int32 Index, float DeltaTime, bool bPhysicsOnGameThread);
+};
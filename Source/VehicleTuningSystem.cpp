@@ -0,0 +1,59 @@
+// VehicleTuningSystem.cpp - Vehicle tuning and setup implementation
+// Applies setup changes to the owning ARacingVehicle
+
+#include "VehicleTuningSystem.h"
+#include "RacingVehicle.h"
+
+UVehicleTuningSystem::UVehicleTuningSystem()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	OwnerVehicle = nullptr;
+}
+
+void UVehicleTuningSystem::BeginPlay()
+{
+	Super::BeginPlay();
+
+	OwnerVehicle = Cast<ARacingVehicle>(GetOwner());
+	CurrentSetup = DefaultSetup;
+}
+
+void UVehicleTuningSystem::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+}
+
+void UVehicleTuningSystem::ApplySetup(const FVehicleSetup& Setup)
+{
+	CurrentSetup = Setup;
+
+	// Setup changes are the only point where baked vehicle data is rebuilt
+	ApplyEngineTuning(Setup.Engine);
+}
+
+FVehicleSetup UVehicleTuningSystem::GetCurrentSetup() const
+{
+	return CurrentSetup;
+}
+
+void UVehicleTuningSystem::ResetToDefault()
+{
+	ApplySetup(DefaultSetup);
+}
+
+void UVehicleTuningSystem::TuneEngine(const FEngineTuning& EngineTuning)
+{
+	CurrentSetup.Engine = EngineTuning;
+	ApplyEngineTuning(EngineTuning);
+}
+
+void UVehicleTuningSystem::ApplyEngineTuning(const FEngineTuning& Tuning)
+{
+	if (!OwnerVehicle)
+	{
+		return;
+	}
+
+	// Rebakes the RPM -> torque table the physics thread samples
+	OwnerVehicle->ApplyEngineTuning(Tuning);
+}
@@ -7,6 +7,8 @@
 #include "Components/ActorComponent.h"
 #include "VehicleTuningSystem.generated.h"
 
+enum class ETrackDifficulty : uint8;
+
 // Tuning categories
 UENUM(BlueprintType)
 enum class ETuningCategory : uint8
@@ -4,6 +4,7 @@
 
 #include "VehicleVFXComponent.h"
 #include "RacingVehicle.h"
+#include "VehicleSimulationSubsystem.h"
 #include "NiagaraComponent.h"
 #include "NiagaraFunctionLibrary.h"
 #include "Kismet/GameplayStatics.h"
@@ -56,6 +57,12 @@ void UVehicleVFXComponent::BeginPlay()
         return;
     }
 
+    // Read the vehicle's frame state after it is published
+    if (UVehicleSimulationSubsystem* Simulation = GetWorld()->GetSubsystem<UVehicleSimulationSubsystem>())
+    {
+        Simulation->AddFrameStateConsumer(PrimaryComponentTick);
+    }
+
     // Create tire smoke components (one for each wheel)
     if (bEnableTireSmoke && TireSmokeEffect)
     {
@@ -227,8 +234,7 @@ void UVehicleVFXComponent::UpdateExhaust(float DeltaTime)
     if (!OwnerVehicle)
         return;
 
-    FVehicleTelemetry Telemetry = OwnerVehicle->GetTelemetry();
-    float RPMNormalized = Telemetry.EngineRPM / OwnerVehicle->MaxEngineRPM;
+    float RPMNormalized = OwnerVehicle->GetFrameState().EngineRPMNormalized;
 
     for (UNiagaraComponent* ExhaustComp : ExhaustComponents)
     {
@@ -250,12 +256,7 @@ float UVehicleVFXComponent::GetTireSlipAmount()
     if (!OwnerVehicle)
         return 0.0f;
 
-    FVehicleTelemetry Telemetry = OwnerVehicle->GetTelemetry();
-    
-    float LateralSlip = FMath::Abs(Telemetry.LateralG) / 2.0f;
-    float LongitudinalSlip = FMath::Abs(Telemetry.LongitudinalG) / 2.0f;
-    
-    return FMath::Max(LateralSlip, LongitudinalSlip);
+    return OwnerVehicle->GetFrameState().TireSlip;
 }
 
 float UVehicleVFXComponent::GetVehicleSpeed()
@@ -263,7 +264,7 @@ float UVehicleVFXComponent::GetVehicleSpeed()
     if (!OwnerVehicle)
         return 0.0f;
 
-    return OwnerVehicle->GetTelemetry().Speed;
+    return OwnerVehicle->GetFrameState().Speed;
 }
 
 TArray<FVector> UVehicleVFXComponent::GetWheelLocations()